@@ -0,0 +1,143 @@
+// benchmarks/io/CsvReaderBenchmark.cpp
+//
+// Compares rows/sec of the previous per-row parsing path in NavProcessor
+// (getline + stringstream split + unordered_map lookups + std::stod) with CsvReader.
+//
+// Usage: io_csv_reader_benchmark [vehicle_local_position.csv | --synthetic SIZE_MB]
+// Without a file a synthetic PX4 vehicle_local_position export (256 MB by default) is generated.
+#include "io/CsvReader.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+const char* LOCAL_POSITION_HEADER =
+    "timestamp,timestamp_sample,xy_valid,z_valid,v_xy_valid,v_z_valid,x,y,z,delta_xy[0],delta_xy[1],"
+    "xy_reset_counter,delta_z,z_reset_counter,vx,vy,vz,z_deriv,delta_vxy[0],delta_vxy[1],vxy_reset_counter,"
+    "delta_vz,vz_reset_counter,ax,ay,az,heading,delta_heading,heading_reset_counter,heading_good_for_control,"
+    "xy_global,z_global,ref_timestamp,ref_lat,ref_lon,ref_alt,dist_bottom,dist_bottom_valid,eph,epv,evh,evv";
+
+void generateFile(const std::filesystem::path& path, size_t targetBytes) {
+    std::ofstream file(path, std::ios::binary);
+    file << LOCAL_POSITION_HEADER << "\n";
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> value(-50.0, 50.0);
+
+    char row[1024];
+    size_t written = 0;
+    for (long long ts = 1700000000000000LL; written < targetBytes; ts += 10000) {
+        int length = std::snprintf(row, sizeof(row),
+            "%lld,%lld,1,1,1,1,%.6f,%.6f,%.6f,0.0,0.0,0,0.0,0,%.6f,%.6f,%.6f,%.6f,0.0,0.0,0,"
+            "0.0,0,%.6f,%.6f,%.6f,%.6f,0.0,0,1,1,1,%lld,52.2297,21.0122,110.5,%.6f,1,%.6f,%.6f,%.6f,%.6f\n",
+            ts, ts, value(rng), value(rng), value(rng), value(rng), value(rng), value(rng), value(rng),
+            value(rng), value(rng), value(rng), value(rng), ts, value(rng), value(rng), value(rng),
+            value(rng), value(rng));
+        file.write(row, length);
+        written += static_cast<size_t>(length);
+    }
+}
+
+// Per-row path used by NavProcessor before CsvReader
+size_t runLegacy(const std::filesystem::path& path, double& checksum) {
+    std::ifstream file(path);
+    std::string headerLine;
+    std::getline(file, headerLine);
+
+    std::unordered_map<std::string, size_t> columnIndex;
+    std::stringstream ss(headerLine);
+    std::string column;
+    size_t idx = 0;
+    while (std::getline(ss, column, ',')) {
+        columnIndex[column] = idx++;
+    }
+
+    size_t rows = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::stringstream lineStream(line);
+        std::string cell;
+        std::vector<std::string> values;
+        while (std::getline(lineStream, cell, ',')) {
+            values.push_back(cell);
+        }
+        checksum += std::stod(values[columnIndex["vx"]]);
+        checksum += std::stod(values[columnIndex["vy"]]);
+        checksum += std::stod(values[columnIndex["z"]]);
+        rows++;
+    }
+    return rows;
+}
+
+size_t runCsvReader(const std::filesystem::path& path, double& checksum) {
+    CsvReader reader;
+    if (!reader.open(path)) return 0;
+
+    const int colVx = reader.columnIndex("vx");
+    const int colVy = reader.columnIndex("vy");
+    const int colZ = reader.columnIndex("z");
+
+    size_t rows = 0;
+    while (reader.next()) {
+        double vx = 0.0, vy = 0.0, z = 0.0;
+        reader.getDouble(colVx, vx);
+        reader.getDouble(colVy, vy);
+        reader.getDouble(colZ, z);
+        checksum += vx + vy + z;
+        rows++;
+    }
+    return rows;
+}
+
+template <typename Fn>
+void report(const char* name, Fn fn, const std::filesystem::path& path) {
+    double checksum = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    size_t rows = fn(path, checksum);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double megabytes = std::filesystem::file_size(path) / (1024.0 * 1024.0);
+    std::cout << "  " << name << ": " << rows << " rows in " << seconds << " s | "
+              << static_cast<long long>(rows / seconds) << " rows/s | "
+              << megabytes / seconds << " MB/s | checksum " << checksum << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::filesystem::path path;
+    bool generated = false;
+
+    if (argc > 1 && std::string(argv[1]) != "--synthetic") {
+        path = argv[1];
+        if (!std::filesystem::exists(path)) {
+            std::cerr << "Error: Input file does not exist: " << path << std::endl;
+            return 1;
+        }
+    } else {
+        size_t sizeMb = 256;
+        if (argc > 2) sizeMb = std::stoul(argv[2]);
+        path = std::filesystem::temp_directory_path() / "flora_csv_benchmark.csv";
+        std::cout << "Generating " << sizeMb << " MB synthetic log: " << path << std::endl;
+        generateFile(path, sizeMb * 1024 * 1024);
+        generated = true;
+    }
+
+    std::cout << "CSV parsing benchmark (" << path << ")" << std::endl;
+    report("stringstream + stod", runLegacy, path);
+    report("CsvReader          ", runCsvReader, path);
+
+    if (generated) {
+        std::filesystem::remove(path);
+    }
+    return 0;
+}
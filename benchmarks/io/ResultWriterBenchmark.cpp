@@ -0,0 +1,105 @@
+// benchmarks/io/ResultWriterBenchmark.cpp
+//
+// Compares records/sec of the previous per-frame output path in NavProcessor
+// (std::ofstream << std::fixed << std::setprecision(10)) with ResultWriter CSV and binary output.
+//
+// Usage: io_result_writer_benchmark [RECORDS]   (default: 5 000 000)
+#include "io/ResultWriter.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const size_t COLUMNS = 9;
+
+const std::vector<ResultColumn> RESULT_COLUMNS = {
+    {"frame_number", ResultColumn::Type::INT64},
+    {"speed_mps", ResultColumn::Type::FLOAT64},
+    {"altitude", ResultColumn::Type::FLOAT64},
+    {"heading", ResultColumn::Type::FLOAT64},
+    {"dr_lat", ResultColumn::Type::FLOAT64},
+    {"dr_lon", ResultColumn::Type::FLOAT64},
+    {"gps_lat", ResultColumn::Type::FLOAT64},
+    {"gps_lon", ResultColumn::Type::FLOAT64},
+    {"gps_vel", ResultColumn::Type::FLOAT64}
+};
+
+// Navigation-like values: small speeds and altitudes, latitudes/longitudes with many significant digits
+std::vector<double> generateRecords(size_t records) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> speed(0.0, 25.0);
+    std::uniform_real_distribution<double> jitter(-1e-4, 1e-4);
+
+    std::vector<double> values(records * COLUMNS);
+    for (size_t i = 0; i < records; ++i) {
+        double* row = &values[i * COLUMNS];
+        row[0] = static_cast<double>(i + 1);
+        row[1] = speed(rng);
+        row[2] = 100.0 + jitter(rng) * 1e4;
+        row[3] = speed(rng) * 14.4;
+        row[4] = 52.2297 + jitter(rng);
+        row[5] = 21.0122 + jitter(rng);
+        row[6] = 52.2297 + jitter(rng);
+        row[7] = 21.0122 + jitter(rng);
+        row[8] = speed(rng);
+    }
+    return values;
+}
+
+void runLegacy(const std::filesystem::path& path, const std::vector<double>& values, size_t records) {
+    std::ofstream outFile(path);
+    outFile << std::fixed << std::setprecision(10);
+    outFile << "frame_number,speed_mps,altitude,heading,dr_lat,dr_lon,gps_lat,gps_lon,gps_vel\n";
+    for (size_t i = 0; i < records; ++i) {
+        const double* row = &values[i * COLUMNS];
+        outFile << static_cast<int>(row[0]) << ","
+                << row[1] << "," << row[2] << "," << row[3] << ","
+                << row[4] << "," << row[5] << "," << row[6] << ","
+                << row[7] << "," << row[8] << "\n";
+    }
+}
+
+void runWriter(const std::filesystem::path& path, const std::vector<double>& values, size_t records, ResultFormat format) {
+    ResultWriter writer;
+    writer.open(path, format, RESULT_COLUMNS);
+    for (size_t i = 0; i < records; ++i) {
+        writer.write(&values[i * COLUMNS]);
+    }
+    writer.close();
+}
+
+template <typename Fn>
+void report(const char* name, Fn fn, const std::filesystem::path& path, size_t records) {
+    auto start = std::chrono::steady_clock::now();
+    fn(path);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double megabytes = std::filesystem::file_size(path) / (1024.0 * 1024.0);
+    std::cout << "  " << name << ": " << records << " records in " << seconds << " s | "
+              << static_cast<long long>(records / seconds) << " records/s | "
+              << megabytes << " MB (" << megabytes / seconds << " MB/s)" << std::endl;
+    std::filesystem::remove(path);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t records = 5000000;
+    if (argc > 1) records = std::stoul(argv[1]);
+
+    std::vector<double> values = generateRecords(records);
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "flora_result_benchmark";
+
+    std::cout << "Result writing benchmark (" << records << " records)" << std::endl;
+    report("ofstream << fixed      ", [&](const std::filesystem::path& p) { runLegacy(p, values, records); }, path, records);
+    report("ResultWriter (csv)     ", [&](const std::filesystem::path& p) { runWriter(p, values, records, ResultFormat::CSV); }, path, records);
+    report("ResultWriter (bin)     ", [&](const std::filesystem::path& p) { runWriter(p, values, records, ResultFormat::BINARY); }, path, records);
+    return 0;
+}
@@ -0,0 +1,153 @@
+// benchmarks/nav-dr/GeodeticBatchBenchmark.cpp
+//
+// Compares points/sec of the scalar GPSData::toENU / GPSData::fromENU member functions,
+// LocalFrame (reference set up once) and the batched geodeticToENUBatch / enuToGeodeticBatch kernels.
+//
+// Usage: nav_dr_geodetic_batch_benchmark [POINTS]   (default: 2 000 000)
+#include "nav-dr/sensors/GPSData.hpp"
+#include "nav-dr/sensors/GeodeticBatch.hpp"
+#include "nav-dr/sensors/LocalFrame.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const double REFERENCE_LATITUDE = 52.2297;
+const double REFERENCE_LONGITUDE = 21.0122;
+const double REFERENCE_ALTITUDE = 110.5;
+
+struct Points {
+    std::vector<double> latitude;
+    std::vector<double> longitude;
+    std::vector<double> altitude;
+    std::vector<double> east;
+    std::vector<double> north;
+    std::vector<double> up;
+
+    explicit Points(size_t count)
+        : latitude(count), longitude(count), altitude(count), east(count), north(count), up(count) {}
+};
+
+// Flight-like cloud: +-0.2 deg around the reference, 0-500 m above it
+Points generatePoints(size_t count) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> offset(-0.2, 0.2);
+    std::uniform_real_distribution<double> height(0.0, 500.0);
+
+    Points points(count);
+    for (size_t i = 0; i < count; ++i) {
+        points.latitude[i] = REFERENCE_LATITUDE + offset(rng);
+        points.longitude[i] = REFERENCE_LONGITUDE + offset(rng);
+        points.altitude[i] = REFERENCE_ALTITUDE + height(rng);
+    }
+    geodeticToENUBatch(points.latitude.data(), points.longitude.data(), points.altitude.data(), count,
+                       REFERENCE_LATITUDE, REFERENCE_LONGITUDE, REFERENCE_ALTITUDE,
+                       points.east.data(), points.north.data(), points.up.data());
+    return points;
+}
+
+double runScalarToENU(Points& points) {
+    double checksum = 0.0;
+    for (size_t i = 0; i < points.latitude.size(); ++i) {
+        GPSData gps(points.latitude[i], points.longitude[i], points.altitude[i]);
+        Vector3D enu = gps.toENU(REFERENCE_LATITUDE, REFERENCE_LONGITUDE, REFERENCE_ALTITUDE);
+        checksum += enu.getX() + enu.getY() + enu.getZ();
+    }
+    return checksum;
+}
+
+double runFrameToENU(Points& points) {
+    const LocalFrame frame(REFERENCE_LATITUDE, REFERENCE_LONGITUDE, REFERENCE_ALTITUDE);
+    double checksum = 0.0;
+    for (size_t i = 0; i < points.latitude.size(); ++i) {
+        Vector3D enu = frame.toENU(points.latitude[i], points.longitude[i], points.altitude[i]);
+        checksum += enu.getX() + enu.getY() + enu.getZ();
+    }
+    return checksum;
+}
+
+double runBatchToENU(Points& points) {
+    std::vector<double> east(points.latitude.size()), north(east.size()), up(east.size());
+    geodeticToENUBatch(points.latitude.data(), points.longitude.data(), points.altitude.data(), east.size(),
+                       REFERENCE_LATITUDE, REFERENCE_LONGITUDE, REFERENCE_ALTITUDE,
+                       east.data(), north.data(), up.data());
+    double checksum = 0.0;
+    for (size_t i = 0; i < east.size(); ++i) checksum += east[i] + north[i] + up[i];
+    return checksum;
+}
+
+double runScalarFromENU(Points& points) {
+    double checksum = 0.0;
+    GPSData gps;
+    for (size_t i = 0; i < points.east.size(); ++i) {
+        gps.fromENU(Vector3D(points.east[i], points.north[i], points.up[i]),
+                    REFERENCE_LATITUDE, REFERENCE_LONGITUDE, REFERENCE_ALTITUDE);
+        checksum += gps.getLatitude() + gps.getLongitude() + gps.getAltitude();
+    }
+    return checksum;
+}
+
+double runFrameFromENU(Points& points) {
+    const LocalFrame frame(REFERENCE_LATITUDE, REFERENCE_LONGITUDE, REFERENCE_ALTITUDE);
+    double checksum = 0.0;
+    GPSData gps;
+    for (size_t i = 0; i < points.east.size(); ++i) {
+        frame.fromENU(Vector3D(points.east[i], points.north[i], points.up[i]), gps);
+        checksum += gps.getLatitude() + gps.getLongitude() + gps.getAltitude();
+    }
+    return checksum;
+}
+
+double runBatchFromENU(Points& points) {
+    std::vector<double> latitude(points.east.size()), longitude(latitude.size()), altitude(latitude.size());
+    enuToGeodeticBatch(points.east.data(), points.north.data(), points.up.data(), latitude.size(),
+                       REFERENCE_LATITUDE, REFERENCE_LONGITUDE, REFERENCE_ALTITUDE,
+                       latitude.data(), longitude.data(), altitude.data());
+    double checksum = 0.0;
+    for (size_t i = 0; i < latitude.size(); ++i) checksum += latitude[i] + longitude[i] + altitude[i];
+    return checksum;
+}
+
+// Best of three runs
+template <typename Fn>
+double report(const char* name, Fn fn, Points& points) {
+    double best = 1e300;
+    double checksum = 0.0;
+    for (int run = 0; run < 3; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        checksum = fn(points);
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    const size_t count = points.latitude.size();
+    std::cout << "  " << name << ": " << count << " points in " << best << " s | "
+              << static_cast<long long>(count / best) << " points/s | checksum " << checksum << std::endl;
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t count = 2000000;
+    if (argc > 1) count = std::stoul(argv[1]);
+
+    Points points = generatePoints(count);
+
+    std::cout << "Geodetic conversion benchmark (" << count << " points)" << std::endl;
+    double scalarToENU = report("GPSData::toENU         ", runScalarToENU, points);
+    report("LocalFrame::toENU      ", runFrameToENU, points);
+    double batchToENU = report("geodeticToENUBatch     ", runBatchToENU, points);
+    double scalarFromENU = report("GPSData::fromENU       ", runScalarFromENU, points);
+    report("LocalFrame::fromENU    ", runFrameFromENU, points);
+    double batchFromENU = report("enuToGeodeticBatch     ", runBatchFromENU, points);
+
+    std::cout << "  speedup toENU: " << scalarToENU / batchToENU << "x, fromENU: "
+              << scalarFromENU / batchFromENU << "x" << std::endl;
+    return 0;
+}
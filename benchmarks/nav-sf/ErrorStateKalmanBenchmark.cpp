@@ -0,0 +1,99 @@
+// benchmarks/nav-sf/ErrorStateKalmanBenchmark.cpp
+//
+// Time per ErrorStateKalmanProcessor::update (predict + flow speed, heading and altitude updates)
+// and per update followed by a GPS correct(), next to the open-loop DeadReckoningProcessor::update.
+//
+// Usage: nav_sf_error_state_kalman_benchmark [FRAMES]   (default: 1 000 000)
+#include "nav-dr/core/DeadReckoningProcessor.hpp"
+#include "nav-sf/core/ErrorStateKalmanProcessor.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const double START_LATITUDE = 52.2297;
+const double START_LONGITUDE = 21.0122;
+const double DT = 1.0 / 30.0;
+
+struct Measurements {
+    std::vector<double> altitude;
+    std::vector<double> heading;
+    std::vector<double> speed;
+};
+
+// Noisy 12 m/s flight at 100 m, slowly turning
+Measurements generateMeasurements(size_t count) {
+    std::mt19937 rng(42);
+    std::normal_distribution<double> noise(0.0, 1.0);
+
+    Measurements measurements;
+    for (size_t i = 0; i < count; ++i) {
+        measurements.altitude.push_back(100.0 + 0.5 * noise(rng));
+        measurements.heading.push_back(std::remainder(0.001 * i + 0.05 * noise(rng), 2.0 * M_PI));
+        measurements.speed.push_back(12.0 + 0.3 * noise(rng));
+    }
+    return measurements;
+}
+
+// Best of three runs, in ns per call
+template <typename Fn>
+double report(const char* name, Fn fn, size_t count) {
+    double best = 1e300;
+    double checksum = 0.0;
+    for (int run = 0; run < 3; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        checksum = fn();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    const double ns = best * 1e9 / count;
+    std::cout << "  " << name << ": " << count << " calls in " << best << " s | "
+              << ns << " ns/call | checksum " << checksum << std::endl;
+    return ns;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t count = 1000000;
+    if (argc > 1) count = std::stoul(argv[1]);
+
+    const Measurements measurements = generateMeasurements(count);
+    const GPSData start(START_LATITUDE, START_LONGITUDE, 100.0);
+
+    std::cout << "Position estimator benchmark (" << count << " frames)" << std::endl;
+    report("DeadReckoningProcessor::update              ", [&]() {
+        DeadReckoningProcessor processor;
+        for (size_t i = 0; i < count; ++i) {
+            processor.update(start, measurements.altitude[i], measurements.heading[i], measurements.speed[i], DT);
+        }
+        return processor.getGPSData().getLatitude();
+    }, count);
+
+    report("ErrorStateKalmanProcessor::update           ", [&]() {
+        ErrorStateKalmanProcessor processor;
+        for (size_t i = 0; i < count; ++i) {
+            processor.update(start, measurements.altitude[i], measurements.heading[i], measurements.speed[i], DT);
+        }
+        return processor.getGPSData().getLatitude();
+    }, count);
+
+    // Fixes at the current estimate, so none is gated out
+    ErrorStateKalmanProcessor aided;
+    aided.update(start, 100.0, 0.0, 12.0, DT);
+    report("ErrorStateKalmanProcessor::update + correct ", [&]() {
+        double used = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            aided.update(start, measurements.altitude[i], measurements.heading[i], measurements.speed[i], DT);
+            used += aided.correct(aided.getGPSData()) ? 1.0 : 0.0;
+        }
+        return used;
+    }, count);
+    return 0;
+}
@@ -0,0 +1,141 @@
+// BatchRunner.cpp
+#include "BatchRunner.hpp"
+#include "../nav-of/core/FlowBackendFactory.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// Decode, preprocessing, flow and fusion threads of one NavProcessor
+const int THREADS_PER_FLIGHT = 4;
+
+} // namespace
+
+BatchRunner::BatchRunner(Setup setup, int jobs)
+    : setup_(std::move(setup))
+    , jobs_(jobs)
+{
+}
+
+std::vector<std::filesystem::path> BatchRunner::discoverFlights(const std::filesystem::path& rootDir) {
+    std::vector<std::filesystem::path> flights;
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(rootDir, ec)) {
+        if (entry.is_directory(ec) && NavProcessor::isFlightDirectory(entry.path())) {
+            flights.push_back(entry.path());
+        }
+    }
+
+    std::sort(flights.begin(), flights.end());
+    return flights;
+}
+
+int BatchRunner::computeJobs(int requestedJobs, size_t flights, const std::string& flowBackend) {
+    int jobs = requestedJobs;
+    if (jobs <= 0) {
+        int cores = static_cast<int>(std::thread::hardware_concurrency());
+        jobs = std::max(1, cores / THREADS_PER_FLIGHT);
+    }
+
+    FlowBackendType type;
+    if (parseFlowBackendType(flowBackend, type)) {
+        int limit = getFlowBackendConcurrency(type);
+        if (limit > 0) {
+            jobs = std::min(jobs, limit);
+        }
+    }
+
+    return std::max(1, std::min(jobs, static_cast<int>(std::max<size_t>(flights, 1))));
+}
+
+int BatchRunner::run(const std::filesystem::path& rootDir, const std::filesystem::path& outputDir) {
+    std::vector<std::filesystem::path> flights = discoverFlights(rootDir);
+    if (flights.empty()) {
+        std::cerr << "Error: No flight directories found in: " << rootDir << std::endl;
+        return -1;
+    }
+
+    results_.assign(flights.size(), FlightResult());
+    for (size_t i = 0; i < flights.size(); ++i) {
+        results_[i].inputDir = flights[i];
+    }
+
+    std::cout << "    - flights: " << flights.size() << " | jobs: " << jobs_ << std::endl;
+
+    std::atomic<size_t> nextFlight(0);
+    std::atomic<size_t> finished(0);
+    std::mutex outputMutex;
+
+    // Workers pull the next flight until the list is exhausted, so long and short flights balance out
+    auto worker = [&]() {
+        for (size_t i = nextFlight++; i < flights.size(); i = nextFlight++) {
+            FlightResult& result = results_[i];
+
+            NavProcessor navProcessor;
+            navProcessor.setQuiet(true);
+            result.status = setup_(navProcessor, flights[i]);
+            if (result.status == 0) {
+                result.status = navProcessor.process() == 0 ? 0 : 3;
+                result.summary = navProcessor.getSummary();
+            }
+
+            std::lock_guard<std::mutex> lock(outputMutex);
+            std::cout << "      [" << ++finished << "/" << flights.size() << "] "
+                      << flights[i].filename().string() << ": "
+                      << (result.status == 0 ? "OK" : "FAILED (" + std::to_string(result.status) + ")")
+                      << " | frames: " << result.summary.frames
+                      << " | time: " << std::fixed << std::setprecision(1) << result.summary.durationSec << " s"
+                      << std::endl;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < jobs_; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    std::filesystem::path summaryFile = outputDir / "batch_summary.csv";
+    if (!writeSummary(summaryFile)) {
+        std::cerr << "Error: Could not write batch summary: " << summaryFile << std::endl;
+        return -1;
+    }
+    std::cout << "    - summary written to: " << summaryFile << std::endl;
+
+    bool allOk = std::all_of(results_.begin(), results_.end(), [](const FlightResult& result) {
+        return result.status == 0;
+    });
+    return allOk ? 0 : 5;
+}
+
+bool BatchRunner::writeSummary(const std::filesystem::path& summaryFile) const {
+    std::ofstream out(summaryFile);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    out << "flight,status,frames,duration_s,frames_per_s,final_error_m,gps_fixes_used,gps_fixes_rejected\n";
+    out << std::fixed << std::setprecision(3);
+    for (const FlightResult& result : results_) {
+        const ProcessSummary& summary = result.summary;
+        double rate = summary.durationSec > 0.0 ? summary.frames / summary.durationSec : 0.0;
+        out << result.inputDir.filename().string() << ","
+            << result.status << ","
+            << summary.frames << ","
+            << summary.durationSec << ","
+            << rate << ","
+            << summary.finalErrorM << ","
+            << summary.gpsFixesUsed << ","
+            << summary.gpsFixesRejected << "\n";
+    }
+    return static_cast<bool>(out);
+}
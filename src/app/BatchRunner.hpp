@@ -0,0 +1,80 @@
+// BatchRunner.hpp
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../core/NavProcessor.hpp"
+
+/**
+ * @brief Processes every flight below a root directory on a pool of worker threads
+ *
+ * A flight is any subdirectory with the log_<id>_converted_trimmed / video_<id>.mp4
+ * layout expected by NavProcessor. Each worker owns its NavProcessor, so flights
+ * share no state; per-flight CSVs are written to the output directory as in
+ * single-flight mode and an aggregate batch_summary.csv is written at the end.
+ */
+class BatchRunner {
+public:
+    /**
+     * @brief Configures a NavProcessor for one flight directory
+     *
+     * @return 0 on success, error code otherwise
+     */
+    using Setup = std::function<int(NavProcessor&, const std::filesystem::path&)>;
+
+    /**
+     * @brief Result of one flight of the batch
+     */
+    struct FlightResult {
+        std::filesystem::path inputDir;
+        int status = -1;        // 0 = success, otherwise setup/process error code
+        ProcessSummary summary;
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param setup Per-flight NavProcessor setup (camera, backend, input and output paths)
+     * @param jobs Number of flights processed concurrently (0 = derived from cores and flow backend)
+     */
+    BatchRunner(Setup setup, int jobs);
+
+    /**
+     * @brief Finds flight directories directly below the root directory, sorted by name
+     */
+    static std::vector<std::filesystem::path> discoverFlights(const std::filesystem::path& rootDir);
+
+    /**
+     * @brief Number of concurrent flights for a given host and flow backend
+     *
+     * Every flight runs four pipeline threads, so by default one flight is
+     * scheduled per four cores. GPU backends run one flight at a time, as
+     * every backend uses the default CUDA device.
+     *
+     * @param requestedJobs Requested number of jobs (0 = automatic)
+     * @param flights Number of flights in the batch
+     * @param flowBackend Flow backend name
+     */
+    static int computeJobs(int requestedJobs, size_t flights, const std::string& flowBackend);
+
+    /**
+     * @brief Processes all flights
+     *
+     * @param rootDir Directory containing the flight directories
+     * @param outputDir Directory for per-flight results and the batch summary
+     * @return 0 if every flight succeeded, 5 if any flight failed, -1 if nothing could be processed
+     */
+    int run(const std::filesystem::path& rootDir, const std::filesystem::path& outputDir);
+
+    const std::vector<FlightResult>& getResults() const { return results_; }
+
+private:
+    bool writeSummary(const std::filesystem::path& summaryFile) const;
+
+    Setup setup_;
+    int jobs_;
+    std::vector<FlightResult> results_;
+};
@@ -9,18 +9,45 @@ void Config::printHelp(const char* programName) {
               << " REQUIRED:\n"
               << "  -i, --input DIR       input directory (with video and logs)\n"
               << "  -o, --output DIR      outputs directory\n\n"
+
+              << " BATCH:\n"
+              << "  -b, --batch           treat the input directory as a directory of flights and process all of them\n"
+              << "  -j, --jobs N          flights processed in parallel (default: 0 = from cores and flow backend)\n\n"
               
               << " OPTIONAL:\n"
               << "  Optical Flow parameters:\n"
               << "   -F, --fps FPS         video frames per second (default: 30)\n"
               << "   -V, --fov FOV         camera field of view in degrees (default: 91)\n"
               << "   -W, --width WIDTH     video width in pixels (default: 1920)\n"
-              << "   -H, --height HEIGHT   video height in pixels (default: 1080)\n\n"
+              << "   -H, --height HEIGHT   video height in pixels (default: 1080)\n"
+              << "   -D, --decoder NAME    video decoder: auto, gstreamer (gray, reduced size), ffmpeg (default: auto)\n"
+              << "   -B, --backend NAME    flow backend: auto, farneback-gpu, farneback-cpu, dis-cpu, hs-cpu, lk-sparse (default: auto)\n"
+              << "   -T, --threads N       worker threads for CPU flow backends (default: 0 = all cores)\n"
+              << "   -r, --roi X,Y,W,H     compute flow only in this region, fractions of the frame (repeatable; default: whole frame)\n"
+              << "   -m, --mask FILE       mask image, flow is ignored where it is black (sky, gimbal, propellers)\n"
+              << "   -k, --stride N        sample every N-th flow vector in x and y in the reduction (the flow is still computed densely) (default: 1)\n"
+              << "   -a, --adaptive-scale  lower the flow resolution when altitude and speed allow it\n"
+              << "   -n, --frame-step N    measure flow up to N frames apart on calm segments (default: 1 = every frame)\n\n"
 
               << "  Dead Reckoning parameters:\n"
-              << "   ... (not implemented yet)\n\n"
+              << "   -S, --heading-source SRC  heading source: log (logged velocity), flow (camera yaw and course) (default: log)\n"
+              << "   -M, --dr-integration NAME position integration: enu (local tangent plane), great-circle, dr only (default: enu)\n"
+              << "   -d, --estimator NAME  position estimator: dr (open-loop dead reckoning), eskf (error-state Kalman filter) (default: dr)\n"
+              << "   -g, --gps-interval SEC fuse a GPS fix every SEC seconds, eskf only (default: 0 = initial fix only);\n"
+              << "                          the fixes come from the same GPS log the final error is measured against\n\n"
+
+              << "  Output parameters:\n"
+              << "   -f, --format FORMAT   result file format: csv, bin (default: csv)\n"
+              << "   -p, --progress MODE   progress output: tty, jsonl, none (default: tty, none in batch mode)\n"
+              << "   -R, --progress-rate HZ  progress reports per second (default: 5)\n"
+              << "   -O, --progress-out FILE write progress to FILE instead of stdout\n"
+              << "   -X, --profile-out FILE  write per-stage timing to FILE (batch: <flight>_FILE; needs ENABLE_PROFILING build)\n\n"
+
+              << "  Input parameters:\n"
+              << "   -I, --index           keep a sidecar index of the logs next to the log directory\n\n"
 
               << " OTHER:\n"
+              << "  -C, --convert FILE    convert a binary result file to CSV (written next to it) and exit\n"
               << "  -v, --version         show version\n"
               << "  -h, --help            show this information\n";
 }
@@ -42,6 +69,44 @@ void Config::printSummary(const Config config) {
     std::cout << "  Width[px]:            " << config.videoWidthPx << std::endl;
     std::cout << "  Height[px]:           " << config.videoHeightPx << std::endl;
     std::cout << "  Altitude[m]:          " << config.altitudeM << std::endl;
+    std::cout << "  Decoder:              " << config.videoDecoder << std::endl;
+
+    std::cout << " Optical flow parameters:" << std::endl;
+    std::cout << "  Backend:              " << config.flowBackend << std::endl;
+    std::cout << "  Threads:              " << (config.flowThreads > 0 ? std::to_string(config.flowThreads) : "all cores") << std::endl;
+    std::cout << "  Regions:              ";
+    if (config.flowRegions.empty()) {
+        std::cout << "whole frame";
+    }
+    for (size_t i = 0; i < config.flowRegions.size(); ++i) {
+        std::cout << (i > 0 ? " " : "") << config.flowRegions[i];
+    }
+    std::cout << std::endl;
+    std::cout << "  Mask:                 " << (config.flowMask.empty() ? "None" : config.flowMask) << std::endl;
+    std::cout << "  Stride:               " << config.flowStride << std::endl;
+    std::cout << "  Adaptive scale:       " << (config.adaptiveScale ? "yes" : "no") << std::endl;
+    std::cout << "  Max frame step:       " << config.maxFrameStep << std::endl;
+
+    std::cout << " Dead reckoning parameters:" << std::endl;
+    std::cout << "  Heading source:       " << config.headingSource << std::endl;
+    std::cout << "  Integration:          " << config.drIntegration << std::endl;
+    std::cout << "  Estimator:            " << config.positionEstimator << std::endl;
+    std::cout << "  GPS aiding interval:  " << (config.gpsAidIntervalSec > 0.0 ? std::to_string(config.gpsAidIntervalSec) + " s (from the evaluation GPS log)" : "none") << std::endl;
+
+    std::cout << " Output parameters:" << std::endl;
+    std::cout << "  Format:               " << config.outputFormat << std::endl;
+    std::cout << "  Progress:             " << config.progressMode << " @ " << config.progressRateHz << " Hz"
+              << (config.progressOut.empty() ? "" : " -> " + config.progressOut) << std::endl;
+    std::cout << "  Profile output:       " << (config.profileOut.empty() ? "None" : config.profileOut) << std::endl;
+
+    std::cout << " Batch parameters:" << std::endl;
+    std::cout << "  Batch mode:           " << (config.batchMode ? "yes" : "no") << std::endl;
+    if (config.batchMode) {
+        std::cout << "  Jobs:                 " << (config.batchJobs > 0 ? std::to_string(config.batchJobs) : "auto") << std::endl;
+    }
+
+    std::cout << " Input parameters:" << std::endl;
+    std::cout << "  Sidecar index:        " << (config.indexSidecar ? "yes" : "no") << std::endl;
 
 }
 
@@ -105,6 +170,14 @@ Config Config::parseCommandLine(int argc, char* argv[]) {
                 config.showHelp = true;
                 return config;
             }
+        } else if (arg == "-D" || arg == "--decoder") {
+            if (i + 1 < argc) {
+                config.videoDecoder = argv[++i];
+            } else {
+                std::cerr << "Error: Option " << arg << " requires an argument.\n";
+                config.showHelp = true;
+                return config;
+            }
         } else if (arg == "-A" || arg == "--alt") {
             if (i + 1 < argc) {
                 config.altitudeM = std::stoi(argv[++i]);
@@ -113,6 +186,148 @@ Config Config::parseCommandLine(int argc, char* argv[]) {
                 config.showHelp = true;
                 return config;
             }
+        } else if (arg == "-B" || arg == "--backend") {
+            if (i + 1 < argc) {
+                config.flowBackend = argv[++i];
+            } else {
+                std::cerr << "Error: Option " << arg << " requires an argument.\n";
+                config.showHelp = true;
+                return config;
+            }
+        } else if (arg == "-T" || arg == "--threads") {
+            if (i + 1 < argc) {
+                config.flowThreads = std::stoi(argv[++i]);
+            } else {
+                std::cerr << "Error: Option " << arg << " requires an argument.\n";
+                config.showHelp = true;
+                return config;
+            }
+        } else if (arg == "-r" || arg == "--roi") {
+            if (i + 1 < argc) {
+                config.flowRegions.push_back(argv[++i]);
+            } else {
+                std::cerr << "Error: Option " << arg << " requires an argument.\n";
+                config.showHelp = true;
+                return config;
+            }
+        } else if (arg == "-m" || arg == "--mask") {
+            if (i + 1 < argc) {
+                config.flowMask = argv[++i];
+            } else {
+                std::cerr << "Error: Option " << arg << " requires an argument.\n";
+                config.showHelp = true;
+                return config;
+            }
+        } else if (arg == "-k" || arg == "--stride") {
+            if (i + 1 < argc) {
+                config.flowStride = std::stoi(argv[++i]);
+            } else {
+                std::cerr << "Error: Option " << arg << " requires an argument.\n";
+                config.showHelp = true;
+                return config;
+            }
+        } else if (arg == "-a" || arg == "--adaptive-scale") {
+            config.adaptiveScale = true;
+        } else if (arg == "-n" || arg == "--frame-step") {
+            if (i + 1 < argc) {
+                config.maxFrameStep = std::stoi(argv[++i]);
+            } else {
+                std::cerr << "Error: Option " << arg << " requires an argument.\n";
+                config.showHelp = true;
+                return config;
+            }
+        } else if (arg == "-S" || arg == "--heading-source") {
+            if (i + 1 < argc) {
+                config.headingSource = argv[++i];
+            } else {
+                std::cerr << "Error: Option " << arg << " requires an argument.\n";
+                config.showHelp = true;
+                return config;
+            }
+        } else if (arg == "-M" || arg == "--dr-integration") {
+            if (i + 1 < argc) {
+                config.drIntegration = argv[++i];
+            } else {
+                std::cerr << "Error: Option " << arg << " requires an argument.\n";
+                config.showHelp = true;
+                return config;
+            }
+        } else if (arg == "-d" || arg == "--estimator") {
+            if (i + 1 < argc) {
+                config.positionEstimator = argv[++i];
+            } else {
+                std::cerr << "Error: Option " << arg << " requires an argument.\n";
+                config.showHelp = true;
+                return config;
+            }
+        } else if (arg == "-g" || arg == "--gps-interval") {
+            if (i + 1 < argc) {
+                config.gpsAidIntervalSec = std::stod(argv[++i]);
+            } else {
+                std::cerr << "Error: Option " << arg << " requires an argument.\n";
+                config.showHelp = true;
+                return config;
+            }
+        } else if (arg == "-b" || arg == "--batch") {
+            config.batchMode = true;
+        } else if (arg == "-j" || arg == "--jobs") {
+            if (i + 1 < argc) {
+                config.batchJobs = std::stoi(argv[++i]);
+            } else {
+                std::cerr << "Error: Option " << arg << " requires an argument.\n";
+                config.showHelp = true;
+                return config;
+            }
+        } else if (arg == "-f" || arg == "--format") {
+            if (i + 1 < argc) {
+                config.outputFormat = argv[++i];
+            } else {
+                std::cerr << "Error: Option " << arg << " requires an argument.\n";
+                config.showHelp = true;
+                return config;
+            }
+        } else if (arg == "-p" || arg == "--progress") {
+            if (i + 1 < argc) {
+                config.progressMode = argv[++i];
+            } else {
+                std::cerr << "Error: Option " << arg << " requires an argument.\n";
+                config.showHelp = true;
+                return config;
+            }
+        } else if (arg == "-R" || arg == "--progress-rate") {
+            if (i + 1 < argc) {
+                config.progressRateHz = std::stod(argv[++i]);
+            } else {
+                std::cerr << "Error: Option " << arg << " requires an argument.\n";
+                config.showHelp = true;
+                return config;
+            }
+        } else if (arg == "-O" || arg == "--progress-out") {
+            if (i + 1 < argc) {
+                config.progressOut = argv[++i];
+            } else {
+                std::cerr << "Error: Option " << arg << " requires an argument.\n";
+                config.showHelp = true;
+                return config;
+            }
+        } else if (arg == "-X" || arg == "--profile-out") {
+            if (i + 1 < argc) {
+                config.profileOut = argv[++i];
+            } else {
+                std::cerr << "Error: Option " << arg << " requires an argument.\n";
+                config.showHelp = true;
+                return config;
+            }
+        } else if (arg == "-C" || arg == "--convert") {
+            if (i + 1 < argc) {
+                config.convertFile = argv[++i];
+            } else {
+                std::cerr << "Error: Option " << arg << " requires an argument.\n";
+                config.showHelp = true;
+                return config;
+            }
+        } else if (arg == "-I" || arg == "--index") {
+            config.indexSidecar = true;
         } else {
             std::cerr << "Unknown option: " << arg << "\n";
             config.showHelp = true;
@@ -120,7 +335,7 @@ Config Config::parseCommandLine(int argc, char* argv[]) {
         }
     }
 
-    if ((!config.showHelp && !config.showVersion) && (config.inputDir.empty())) {
+    if ((!config.showHelp && !config.showVersion) && config.convertFile.empty() && (config.inputDir.empty())) {
         std::cerr << "Error: Not all required input files provided.\n" << std::endl;
         config.showHelp = true;
     }
@@ -1,6 +1,7 @@
 // Config.hpp
 #pragma once
 #include <string>
+#include <vector>
 
 class Config {
 
@@ -38,6 +39,48 @@ public:
 
     int getAltitudeM() const { return altitudeM; }
 
+    const std::string& getFlowBackend() const { return flowBackend; }
+
+    int getFlowThreads() const { return flowThreads; }
+
+    const std::vector<std::string>& getFlowRegions() const { return flowRegions; }
+
+    const std::string& getFlowMask() const { return flowMask; }
+
+    int getFlowStride() const { return flowStride; }
+
+    bool isAdaptiveScale() const { return adaptiveScale; }
+
+    int getMaxFrameStep() const { return maxFrameStep; }
+
+    const std::string& getVideoDecoder() const { return videoDecoder; }
+
+    const std::string& getHeadingSource() const { return headingSource; }
+
+    const std::string& getDrIntegration() const { return drIntegration; }
+
+    const std::string& getPositionEstimator() const { return positionEstimator; }
+
+    double getGpsAidIntervalSec() const { return gpsAidIntervalSec; }
+
+    bool isIndexSidecar() const { return indexSidecar; }
+
+    bool isBatchMode() const { return batchMode; }
+
+    int getBatchJobs() const { return batchJobs; }
+
+    const std::string& getOutputFormat() const { return outputFormat; }
+
+    const std::string& getConvertFile() const { return convertFile; }
+
+    const std::string& getProgressMode() const { return progressMode; }
+
+    double getProgressRateHz() const { return progressRateHz; }
+
+    const std::string& getProgressOut() const { return progressOut; }
+
+    const std::string& getProfileOut() const { return profileOut; }
+
     void setVideoFps(int fps) { videoFps = fps; }
 
     void setVideoFovCameraDeg(int fov) { videoFovCameraDeg = fov; }
@@ -47,6 +90,48 @@ public:
     void setVideoHeightPx(int height) { videoHeightPx = height; }
 
     void setAltitudeM(int altitude) { altitudeM = altitude; }
+
+    void setFlowBackend(const std::string& backend) { flowBackend = backend; }
+
+    void setFlowThreads(int threads) { flowThreads = threads; }
+
+    void addFlowRegion(const std::string& region) { flowRegions.push_back(region); }
+
+    void setFlowMask(const std::string& file) { flowMask = file; }
+
+    void setFlowStride(int stride) { flowStride = stride; }
+
+    void setAdaptiveScale(bool enabled) { adaptiveScale = enabled; }
+
+    void setMaxFrameStep(int step) { maxFrameStep = step; }
+
+    void setVideoDecoder(const std::string& decoder) { videoDecoder = decoder; }
+
+    void setHeadingSource(const std::string& source) { headingSource = source; }
+
+    void setDrIntegration(const std::string& integration) { drIntegration = integration; }
+
+    void setPositionEstimator(const std::string& estimator) { positionEstimator = estimator; }
+
+    void setGpsAidIntervalSec(double interval) { gpsAidIntervalSec = interval; }
+
+    void setIndexSidecar(bool enabled) { indexSidecar = enabled; }
+
+    void setBatchMode(bool enabled) { batchMode = enabled; }
+
+    void setBatchJobs(int jobs) { batchJobs = jobs; }
+
+    void setOutputFormat(const std::string& format) { outputFormat = format; }
+
+    void setConvertFile(const std::string& file) { convertFile = file; }
+
+    void setProgressMode(const std::string& mode) { progressMode = mode; }
+
+    void setProgressRateHz(double rate) { progressRateHz = rate; }
+
+    void setProgressOut(const std::string& file) { progressOut = file; }
+
+    void setProfileOut(const std::string& file) { profileOut = file; }
     
     void setInputDir(const std::string& dir) { inputDir = dir; }
 
@@ -66,6 +151,37 @@ private:
     int videoWidthPx = 1920; // default value
     int videoHeightPx = 1080; // default value
     int altitudeM = 100; // default value
+    std::string videoDecoder = "auto"; // default value
+
+    // Optical flow parameters
+    std::string flowBackend = "auto"; // default value
+    int flowThreads = 0; // default value (all cores)
+    std::vector<std::string> flowRegions; // "x,y,w,h" fractions of the frame, default: whole frame
+    std::string flowMask; // mask image, zero pixels are excluded
+    int flowStride = 1; // default value
+    bool adaptiveScale = false; // default value
+    int maxFrameStep = 1; // default value (every frame)
+
+    // Dead reckoning parameters
+    std::string headingSource = "log"; // default value
+    std::string drIntegration = "enu"; // default value
+    std::string positionEstimator = "dr"; // default value
+    double gpsAidIntervalSec = 0.0; // default value (initial fix only)
+
+    // Input parameters
+    bool indexSidecar = false; // default value
+
+    // Output parameters
+    std::string outputFormat = "csv"; // default value
+    std::string convertFile; // binary result file to convert to CSV
+    std::string progressMode = "tty"; // default value
+    double progressRateHz = 5.0; // default value
+    std::string progressOut; // default: stdout
+    std::string profileOut; // stage timing CSV (builds with ENABLE_PROFILING only)
+
+    // Batch parameters
+    bool batchMode = false; // default value
+    int batchJobs = 0; // default value (derived from cores and flow backend)
 
     bool showVersion;
     bool showHelp;
@@ -1,16 +1,108 @@
 #include <iostream>
 #include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <thread>
+#include "BatchRunner.hpp"
 #include "Config.hpp"
 #include "../core/NavProcessor.hpp"
 
 
-int initNavProcessor(NavProcessor& navProcessor, const Config& config) {
+int initNavProcessor(NavProcessor& navProcessor, const Config& config, const std::filesystem::path& inputDir, int decoderThreads,
+                     std::ostream& progressOut) {
     // Set camera parameters
     navProcessor.setCameraParams(config.getVideoFovCameraDeg(), {config.getVideoWidthPx(), config.getVideoHeightPx()});
     navProcessor.setFrameRate(config.getVideoFps());
 
+    // Select optical flow backend
+    if (navProcessor.setFlowBackend(config.getFlowBackend()) != 0) {
+        std::cerr << "Error: Could not initialize optical flow backend." << std::endl;
+        return 4;
+    }
+
+    // Restrict the flow to the useful part of the frame
+    if (navProcessor.setFlowSampling(config.getFlowRegions(), config.getFlowMask(), config.getFlowStride()) != 0) {
+        return 2;
+    }
+    navProcessor.setAdaptiveFlowScale(config.isAdaptiveScale());
+    navProcessor.setMaxFrameStep(config.getMaxFrameStep());
+
+    // Select video decoder
+    VideoDecoder videoDecoder;
+    if (!parseVideoDecoder(config.getVideoDecoder(), videoDecoder)) {
+        std::cerr << "Error: Unknown video decoder: " << config.getVideoDecoder() << std::endl;
+        return 2;
+    }
+    navProcessor.setVideoDecoder(videoDecoder, decoderThreads);
+
+    // Select heading source for dead reckoning
+    HeadingSource headingSource;
+    if (!parseHeadingSource(config.getHeadingSource(), headingSource)) {
+        std::cerr << "Error: Unknown heading source: " << config.getHeadingSource() << std::endl;
+        return 2;
+    }
+    navProcessor.setHeadingSource(headingSource);
+
+    // Select dead reckoning position integration
+    DeadReckoningIntegration drIntegration;
+    if (!parseDeadReckoningIntegration(config.getDrIntegration(), drIntegration)) {
+        std::cerr << "Error: Unknown dead reckoning integration: " << config.getDrIntegration() << std::endl;
+        return 2;
+    }
+    navProcessor.setDeadReckoningIntegration(drIntegration);
+
+    // Select position estimator and GPS aiding
+    PositionEstimator positionEstimator;
+    if (!parsePositionEstimator(config.getPositionEstimator(), positionEstimator)) {
+        std::cerr << "Error: Unknown position estimator: " << config.getPositionEstimator() << std::endl;
+        return 2;
+    }
+    if (config.getGpsAidIntervalSec() < 0.0) {
+        std::cerr << "Error: GPS aiding interval must not be negative." << std::endl;
+        return 2;
+    }
+    // The filter integrates in the ENU frame of its initial fix and has no great-circle mode
+    if (positionEstimator == PositionEstimator::ESKF && drIntegration == DeadReckoningIntegration::GREAT_CIRCLE) {
+        std::cerr << "Error: The eskf estimator only supports enu integration." << std::endl;
+        return 2;
+    }
+    navProcessor.setPositionEstimator(positionEstimator);
+    navProcessor.setGpsAidInterval(config.getGpsAidIntervalSec());
+
+    // Select result file format
+    ResultFormat outputFormat;
+    if (!parseResultFormat(config.getOutputFormat(), outputFormat)) {
+        std::cerr << "Error: Unknown output format: " << config.getOutputFormat() << std::endl;
+        return 2;
+    }
+    navProcessor.setOutputFormat(outputFormat);
+
+    // Select progress output (the in-place terminal block is unreadable with concurrent flights)
+    ProgressMode progressMode;
+    if (!parseProgressMode(config.getProgressMode(), progressMode)) {
+        std::cerr << "Error: Unknown progress mode: " << config.getProgressMode() << std::endl;
+        return 2;
+    }
+    if (config.isBatchMode() && progressMode == ProgressMode::TTY) {
+        progressMode = ProgressMode::NONE;
+    }
+    navProcessor.setProgress(progressMode, config.getProgressRateHz(), progressOut);
+
+    // Per-stage timing dump (one file per flight in batch mode)
+    if (!config.getProfileOut().empty()) {
+        std::filesystem::path profileOut(config.getProfileOut());
+        if (config.isBatchMode()) {
+            std::string flight = std::filesystem::path(inputDir).filename().string();
+            profileOut = profileOut.parent_path() / (flight + "_" + profileOut.filename().string());
+        }
+        navProcessor.setProfileOutput(profileOut);
+    }
+
+    // Reuse input log indexes between runs
+    navProcessor.setIndexSidecar(config.isIndexSidecar());
+
     // Initialize input files
-    if (navProcessor.initInput(std::filesystem::path(config.getInputDir())) != 0) {
+    if (navProcessor.initInput(inputDir) != 0) {
         std::cerr << "Error: Could not initialize input files." << std::endl;
         return 1;
     }
@@ -32,14 +124,75 @@ int doProcessing(NavProcessor& navProcessor, const Config& config) {
     return 0; // Placeholder for processing logic
 }
 
+int doConversion(const Config& config) {
+    std::filesystem::path binaryFile(config.getConvertFile());
+    std::filesystem::path csvFile = binaryFile;
+    csvFile.replace_extension(".csv");
+
+    if (!convertResultsToCsv(binaryFile, csvFile)) {
+        std::cerr << "Error: Could not convert " << binaryFile << " to CSV." << std::endl;
+        return 1;
+    }
+    std::cout << "Converted " << binaryFile << " -> " << csvFile << std::endl;
+    return 0;
+}
+
+int doBatchProcessing(const Config& config, std::ostream& progressOut) {
+    std::vector<std::filesystem::path> flights = BatchRunner::discoverFlights(config.getInputDir());
+    int jobs = BatchRunner::computeJobs(config.getBatchJobs(), flights.size(), config.getFlowBackend());
+
+    // OpenCV's thread pool is process-wide: it is sized once, before any flight runs, and all concurrent
+    // flows draw on the same pool. Only the decoders are per flight, so they split the cores.
+    NavProcessor::setFlowThreads(config.getFlowThreads());
+    int decoderThreads = config.getFlowThreads();
+    if (decoderThreads <= 0) {
+        decoderThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) / jobs);
+    }
+
+    BatchRunner batchRunner([&config, &progressOut, decoderThreads](NavProcessor& navProcessor, const std::filesystem::path& inputDir) {
+        return initNavProcessor(navProcessor, config, inputDir, decoderThreads, progressOut);
+    }, jobs);
+
+    int ret = batchRunner.run(config.getInputDir(), config.getOutputDir());
+    if (ret < 0) {
+        return 1;
+    }
+    return ret;
+}
+
 int main(int argc, char* argv[]) {
     int ret = 0;
     Config config = Config::parseCommandLine(argc, argv);
 
+    // Progress goes to stdout unless redirected to a file
+    std::ofstream progressFile;
+    if (!config.getProgressOut().empty()) {
+        progressFile.open(config.getProgressOut());
+        if (!progressFile.is_open()) {
+            std::cerr << "Error: Could not open progress output file: " << config.getProgressOut() << std::endl;
+            return 2;
+        }
+    }
+    std::ostream& progressOut = progressFile.is_open() ? progressFile : std::cout;
+
     if (config.isShowHelp()) {
         config.printHelp(argv[0]);
     } else if (config.isShowVersion()) {
         config.printVersion();
+    } else if (!config.getConvertFile().empty()) {
+        ret = doConversion(config);
+    } else if (config.isBatchMode()) {
+        config.printSummary(config);
+
+        // ---------------------------------------------------------------------------------------------------
+        // Process all flights of the input directory
+        std::cout << "\n  [*] Batch processing: " << config.getInputDir() << std::endl;
+        ret = doBatchProcessing(config, progressOut);
+        if (ret != 0) {
+            std::cerr << "Error: Batch processing failed with code " << ret << "." << std::endl;
+            return ret;
+        }
+        std::cout << "  [*] Batch processing completed successfully." << std::endl;
     } else {
         // Print configuration summary
         config.printSummary(config);
@@ -53,7 +206,8 @@ int main(int argc, char* argv[]) {
         NavProcessor navProcessor;
 
         // -- Initialize NavProcessor with configuration
-        ret = initNavProcessor(navProcessor, config);
+        NavProcessor::setFlowThreads(config.getFlowThreads());
+        ret = initNavProcessor(navProcessor, config, config.getInputDir(), config.getFlowThreads(), progressOut);
         if (ret != 0) {
             std::cerr << "Error: Could not initialize NavProcessor." << std::endl;
             return ret;
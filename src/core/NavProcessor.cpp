@@ -1,27 +1,230 @@
 #include "NavProcessor.hpp"
+#include "../nav-dr/sensors/LocalFrame.hpp"
+#include "../nav-of/core/FlowBackendFactory.hpp"
+#include <opencv2/imgcodecs.hpp>
+
+namespace {
+
+// Number of in-flight items between two pipeline stages
+const size_t PIPELINE_DEPTH = 8;
+
+// Frame travelling through the decode and grayscale/downscale stages (index < 0 marks end of stream)
+struct FramePacket {
+    int index = -1;
+    double time = 0.0;  // Presentation time in seconds since the start of the video
+    bool skipped = false;  // Not analysed (frame step), carries no image
+    cv::Mat image;
+
+    bool isEnd() const { return index < 0; }
+};
+
+// Flow measurement handed from the flow stage to the fusion/writer stage
+struct FlowPacket {
+    int index = -1;
+    double time = 0.0;
+    bool valid = false;
+    bool skipped = false;  // Frame between two flow measurements, the last estimate holds
+    FlowMeasurement measurement;
+
+    bool isEnd() const { return index < 0; }
+};
+
+// Local position log sample (NED velocity and down position)
+struct LocalPositionSample {
+    double timestamp = 0.0;
+    double vx = 0.0;
+    double vy = 0.0;
+    double z = 0.0;
+
+    double getTimestamp() const { return timestamp; }
+
+    static LocalPositionSample interpolate(const LocalPositionSample& first, const LocalPositionSample& second, double targetTime) {
+        if (targetTime <= first.timestamp) return first;
+        if (targetTime >= second.timestamp) return second;
+
+        double t = (targetTime - first.timestamp) / (second.timestamp - first.timestamp);
+        LocalPositionSample result;
+        result.timestamp = targetTime;
+        result.vx = first.vx * (1 - t) + second.vx * t;
+        result.vy = first.vy * (1 - t) + second.vy * t;
+        result.z = first.z * (1 - t) + second.z * t;
+        return result;
+    }
+};
 
-int NavProcessor::initInput(const std::filesystem::path& inputDir) {
+// GPS log sample; position is interpolated by SensorData
+struct GpsSample {
+    SensorData data;
+    double velocity = 0.0;
+
+    double getTimestamp() const { return data.getTimestamp(); }
+
+    static GpsSample interpolate(const GpsSample& first, const GpsSample& second, double targetTime) {
+        GpsSample result;
+        result.data = SensorData::interpolate(first.data, second.data, targetTime);
+
+        double span = second.getTimestamp() - first.getTimestamp();
+        double t = span > 0.0 ? (targetTime - first.getTimestamp()) / span : 0.0;
+        t = std::clamp(t, 0.0, 1.0);
+        result.velocity = first.velocity * (1 - t) + second.velocity * t;
+        return result;
+    }
+};
+
+// Schema of the per-frame output file
+const std::vector<ResultColumn> RESULT_COLUMNS = {
+    {"frame_number", ResultColumn::Type::INT64},
+    {"speed_mps", ResultColumn::Type::FLOAT64},
+    {"altitude", ResultColumn::Type::FLOAT64},
+    {"heading", ResultColumn::Type::FLOAT64},
+    {"dr_lat", ResultColumn::Type::FLOAT64},
+    {"dr_lon", ResultColumn::Type::FLOAT64},
+    {"gps_lat", ResultColumn::Type::FLOAT64},
+    {"gps_lon", ResultColumn::Type::FLOAT64},
+    {"gps_vel", ResultColumn::Type::FLOAT64}
+};
+
+// Timed stages of process(); each stage is recorded by exactly one thread
+enum ProfileStage {
+    STAGE_DECODE = 0,       // decoder thread: VideoSource::read
+    STAGE_PREPARE,          // preprocessing thread: grayscale + downscale
+    STAGE_FLOW,             // flow thread: flow backend
+    STAGE_FUSION,           // main thread: whole per-frame fusion step
+    STAGE_SYNC,             // main thread: log/GPS resampling
+    STAGE_DEAD_RECKONING,   // main thread: DeadReckoningProcessor::update
+    STAGE_OUTPUT            // main thread: result formatting and writing
+};
+
+} // namespace
+
+bool parseHeadingSource(const std::string& name, HeadingSource& source) {
+    if (name == "log") {
+        source = HeadingSource::LOG;
+    } else if (name == "flow") {
+        source = HeadingSource::FLOW;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parsePositionEstimator(const std::string& name, PositionEstimator& estimator) {
+    if (name == "dr") {
+        estimator = PositionEstimator::DEAD_RECKONING;
+    } else if (name == "eskf") {
+        estimator = PositionEstimator::ESKF;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+IDRProcessor& NavProcessor::positionProcessor() {
+    if (positionEstimator_ == PositionEstimator::ESKF) {
+        return errorStateKalmanProcessor_;
+    }
+    return deadReckoningProcessor_;
+}
+
+void NavProcessor::setQuiet(bool quiet) {
+    log_ = quiet ? &nullStream_ : &std::cout;
+}
+
+int NavProcessor::setFlowBackend(const std::string& backendName) {
+    FlowBackendType type;
+    if (!parseFlowBackendType(backendName, type)) {
+        std::cerr << "Error: Unknown optical flow backend: " << backendName << std::endl;
+        return -1;
+    }
+
+    std::unique_ptr<IFlowBackend> backend = createFlowBackend(type);
+    if (!backend) {
+        std::cerr << "Error: Optical flow backend is not available on this host: " << backendName << std::endl;
+        return -1;
+    }
+
+    opticalFlowProcessor_.setFlowBackend(std::move(backend));
+    return 0;
+}
+
+int NavProcessor::setFlowSampling(const std::vector<std::string>& regions, const std::string& maskFile, int stride) {
+    std::vector<cv::Rect2f> flowRegions;
+    for (const std::string& text : regions) {
+        cv::Rect2f region;
+        if (!parseFlowRegion(text, region)) {
+            std::cerr << "Error: Invalid flow region (expected x,y,w,h fractions of the frame): " << text << std::endl;
+            return -1;
+        }
+        flowRegions.push_back(region);
+    }
+
+    if (stride < 1) {
+        std::cerr << "Error: Flow sampling stride must be at least 1: " << stride << std::endl;
+        return -1;
+    }
+
+    cv::Mat mask;
+    if (!maskFile.empty()) {
+        mask = cv::imread(maskFile, cv::IMREAD_GRAYSCALE);
+        if (mask.empty()) {
+            std::cerr << "Error: Could not read flow mask: " << maskFile << std::endl;
+            return -1;
+        }
+    }
+
+    opticalFlowProcessor_.setFlowRegions(flowRegions);
+    opticalFlowProcessor_.setFlowMask(mask);
+    opticalFlowProcessor_.setSampleStride(stride);
+    return 0;
+}
+
+bool NavProcessor::resolveInputFiles(const std::filesystem::path& inputDir, InputFiles& files) {
     std::string dirStr = inputDir.string();
     if (!dirStr.empty() && dirStr.back() == '/') {
         dirStr.pop_back();
     }
 
     std::filesystem::path cleaned(dirStr);
-    fileBasename_ = cleaned.filename().string();
+    files.basename = cleaned.filename().string();
 
-    if (fileBasename_.empty()) {
-        std::cerr << "Error: Input directory name is empty." << std::endl;
-        return -1;
+    // Flight directories are named log_<id>, the matching video is video_<id>.mp4
+    if (files.basename.size() <= 4) {
+        return false;
     }
 
-    std::filesystem::path logSubdir = inputDir / (fileBasename_ + "_converted_trimmed");
-    std::filesystem::path logFilename = fileBasename_ + "_vehicle_local_position_0.csv";
-    inputLogFile_ = logSubdir / logFilename;
+    std::filesystem::path logSubdir = cleaned / (files.basename + "_converted_trimmed");
+    files.logFile = logSubdir / (files.basename + "_vehicle_local_position_0.csv");
+    files.gpsFile = logSubdir / (files.basename + "_vehicle_gps_position_0.csv");
+    files.videoFile = cleaned / ("video_" + files.basename.substr(4) + ".mp4");
+
+    // Sidecar indexes live next to the log directory, not inside it
+    files.logIndexFile = cleaned / (files.logFile.stem().string() + ".idx");
+    files.gpsIndexFile = cleaned / (files.gpsFile.stem().string() + ".idx");
+    return true;
+}
 
-    std::filesystem::path gpsLogFilename = fileBasename_ + "_vehicle_gps_position_0.csv";
-    inputGPSFile_ = logSubdir / gpsLogFilename;
+bool NavProcessor::isFlightDirectory(const std::filesystem::path& dir) {
+    InputFiles files;
+    std::error_code ec;
+    return resolveInputFiles(dir, files)
+        && std::filesystem::is_regular_file(files.logFile, ec)
+        && std::filesystem::is_regular_file(files.gpsFile, ec)
+        && std::filesystem::is_regular_file(files.videoFile, ec);
+}
+
+int NavProcessor::initInput(const std::filesystem::path& inputDir) {
+    InputFiles files;
+    if (!resolveInputFiles(inputDir, files)) {
+        std::cerr << "Error: Input directory name is empty or too short." << std::endl;
+        return -1;
+    }
 
-    inputVideoFile_ = inputDir / ("video_" + fileBasename_.substr(4) + ".mp4");
+    fileBasename_ = files.basename;
+    inputLogFile_ = files.logFile;
+    inputGPSFile_ = files.gpsFile;
+    inputVideoFile_ = files.videoFile;
+    inputLogIndexFile_ = files.logIndexFile;
+    inputGPSIndexFile_ = files.gpsIndexFile;
 
     if (!std::filesystem::exists(inputLogFile_)) {
         std::cerr << "Error: Input log file does not exist: " << inputLogFile_ << std::endl;
@@ -52,234 +255,354 @@ int NavProcessor::initOutput(const std::filesystem::path& outputDir) {
         return -1;
     }
 
-    outputLogFile_ = outputDir / (fileBasename_ + ".csv");
+    outputLogFile_ = outputDir / (fileBasename_ + resultFormatExtension(outputFormat_));
 
     return 0;
 }
 
 
 int NavProcessor::process(void) {
+    std::ostream& log = *log_;
+    const auto startTime = std::chrono::steady_clock::now();
+    summary_ = ProcessSummary();
+    profiler_.reset();
+
     // Check if input files are initialized
-    std::cout << "    - checking input files: ";
+    log << "    - checking input files: ";
     if (inputLogFile_.empty() || inputVideoFile_.empty()) {
         std::cerr << "Error: Input files are not initialized." << std::endl;
         return -1;
     }
-    std::cout << "OK" << std::endl;
+    log << "OK" << std::endl;
 
-    // Open input files
-    std::cout << "    - opening input files:\n";
-    int logLines = int(countLinesInFile(inputLogFile_.string()));
-    double freqLog = computeFrequencyFromTimestamps(inputLogFile_, "timestamp");
-    std::cout << "      * input log file: " << inputLogFile_ << " | lines: " << logLines << std::endl;
-    if (logLines < 0) {
-        std::cerr << "Error: Could not count lines in input log file." << std::endl;
+    // Index input files (one pass each, or none if an up-to-date sidecar exists)
+    log << "    - indexing input files:\n";
+    InputIndex logIndex;
+    if (!logIndex.loadOrBuild(inputLogFile_, useIndexSidecar_ ? inputLogIndexFile_ : std::filesystem::path())) {
+        std::cerr << "Error: Could not index input log file." << std::endl;
         return -1;
     }
+    printIndexSummary("input log file", inputLogFile_, logIndex);
 
-    int gpsLines = int(countLinesInFile(inputGPSFile_.string()));
-    double freqGPS = computeFrequencyFromTimestamps(inputGPSFile_, "timestamp");
-    std::cout << "      * input GPS file: " << inputGPSFile_ << " | lines: " << gpsLines << std::endl;
-    if (gpsLines < 0) {
-        std::cerr << "Error: Could not count lines in input GPS file." << std::endl;
+    InputIndex gpsIndex;
+    if (!gpsIndex.loadOrBuild(inputGPSFile_, useIndexSidecar_ ? inputGPSIndexFile_ : std::filesystem::path())) {
+        std::cerr << "Error: Could not index input GPS file." << std::endl;
         return -1;
     }
+    printIndexSummary("input GPS file", inputGPSFile_, gpsIndex);
 
-    std::ifstream inFile(inputLogFile_);
-    std::ifstream gpsFile(inputGPSFile_);
-
-    std::cout << "      * input files opened successfully." << std::endl;
+    CsvReader logReader;
+    CsvReader gpsReader;
 
-    // Read the header line from the log file
-    std::cout << "    - reading header from input log file: " << inputLogFile_ << std::endl;
-    std::string headerLine;
-    if (!std::getline(inFile, headerLine)) {
+    // Open the log file and resolve its columns once
+    log << "    - reading header from input log file: " << inputLogFile_ << std::endl;
+    if (!logReader.open(inputLogFile_)) {
         std::cerr << "Error: Could not read header from input log file." << std::endl;
-        inFile.close();
-        gpsFile.close();
         return -1;
     }
-    std::unordered_map<std::string, size_t> columnIndex;
-    std::vector<std::string> headers;
-    std::stringstream ss(headerLine);
-    size_t idx = 0;
-    std::string column;
-    
-    while (std::getline(ss, column, ',')) {
-        columnIndex[column] = idx++;
-    }
-    
-    if (columnIndex.count("vx") == 0 || columnIndex.count("vy") == 0 || columnIndex.count("z") == 0) {
+
+    const int colLogTime = logReader.columnIndex("timestamp");
+    const int colVx = logReader.columnIndex("vx");
+    const int colVy = logReader.columnIndex("vy");
+    const int colZ = logReader.columnIndex("z");
+    if (colLogTime < 0 || colVx < 0 || colVy < 0 || colZ < 0) {
         std::cerr << "Error: Required columns not found in CSV header." << std::endl;
-        inFile.close();
-        gpsFile.close();
         return -1;
     }
 
-    // Read the header line from the GPS log file
-    std::cout << "    - reading header from gps log file: " << inputGPSFile_ << std::endl;
-    std::string gpsHeaderLine;
-    if (!std::getline(gpsFile, gpsHeaderLine)) {
+    // Open the GPS log file and resolve its columns once
+    log << "    - reading header from gps log file: " << inputGPSFile_ << std::endl;
+    if (!gpsReader.open(inputGPSFile_)) {
         std::cerr << "Error: Could not read header from gps log file." << std::endl;
-        inFile.close();
-        gpsFile.close();
         return -1;
     }
-    std::unordered_map<std::string, size_t> gpsColumnIndex;
-    std::vector<std::string> gpsHeaders;
-    std::stringstream ssg(gpsHeaderLine);
-    size_t idxg = 0;
-    std::string gpsColumn;
-    
-    while (std::getline(ssg, gpsColumn, ',')) {
-        gpsColumnIndex[gpsColumn] = idxg++;
-    }
-    
-    if (gpsColumnIndex.count("lat") == 0 || gpsColumnIndex.count("lon") == 0 || gpsColumnIndex.count("vel_m_s") == 0) {
+
+    const int colGpsTime = gpsReader.columnIndex("timestamp");
+    const int colLat = gpsReader.columnIndex("lat");
+    const int colLon = gpsReader.columnIndex("lon");
+    const int colVel = gpsReader.columnIndex("vel_m_s");
+    if (colGpsTime < 0 || colLat < 0 || colLon < 0 || colVel < 0) {
         std::cerr << "Error: Required columns not found in GPS CSV header." << std::endl;
         return -1;
     }
     
-    std::cout << "      * headers read successfully." << std::endl;
+    log << "      * headers read successfully." << std::endl;
 
     // Open video file
-    std::cout << "    - opening video file: " << inputVideoFile_ << std::endl;
-    cv::VideoCapture cap(inputVideoFile_.string());
-    if (!cap.isOpened()) {
+    log << "    - opening video file: " << inputVideoFile_ << std::endl;
+    VideoSource cap;
+    if (!cap.open(inputVideoFile_, videoDecoder_, opticalFlowProcessor_.getAnalysisHeight(), videoDecoderThreads_)) {
         std::cerr << "Error: Could not open video file: " << inputVideoFile_ << std::endl;
-        inFile.close();
         return -1;
     }
 
-    int fps = static_cast<int>(cap.get(cv::CAP_PROP_FPS));
-    int totalFrames = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_COUNT));
-    opticalFlowProcessor_.setFrameRate(static_cast<int>(cap.get(cv::CAP_PROP_FPS)));
+    int fps = static_cast<int>(cap.getFrameRate());
+    int totalFrames = cap.getFrameCount();
+    opticalFlowProcessor_.setFrameRate(static_cast<int>(cap.getFrameRate()));
 
-    std::cout << "        - frame rate: " << opticalFlowProcessor_.getFrameRate() << " fps" << std::endl;
-    std::cout << "        - total frames: " << totalFrames << std::endl;
-    std::cout << "      * video file opened successfully." << std::endl;
+    log << "        - frame rate: " << opticalFlowProcessor_.getFrameRate() << " fps" << std::endl;
+    log << "        - decoder: " << cap.getDescription() << std::endl;
+    log << "        - flow backend: " << opticalFlowProcessor_.getFlowBackend()->getName() << std::endl;
+    log << "        - total frames: " << totalFrames << std::endl;
+    log << "      * video file opened successfully." << std::endl;
 
     // Open output file
-    std::cout << "    - opening output file: " << outputLogFile_ << std::endl;
-    std::ofstream outFile(outputLogFile_);
-    if (!outFile.is_open()) {
+    log << "    - opening output file: " << outputLogFile_ << std::endl;
+    ResultWriter outFile;
+    if (!outFile.open(outputLogFile_, outputFormat_, RESULT_COLUMNS)) {
         std::cerr << "Error: Could not open output file: " << outputLogFile_ << std::endl;
         return -1;
     }
-    std::cout << "      * output file opened successfully." << std::endl;
-
-    // Write header to output file
-    std::cout << "    - writing header to output file." << std::endl;
-    std::cout << std::fixed << std::setprecision(10);
-    outFile << std::fixed << std::setprecision(10);
-    outFile << "frame_number,speed_mps,altitude,heading,dr_lat,dr_lon,gps_lat,gps_lon,gps_vel\n";
-    std::cout << "      * header written successfully." << std::endl;
+    log << "      * output file opened successfully (header written)." << std::endl;
+    log << std::fixed << std::setprecision(10);
 
     // Process video frames and log data
-    std::cout << "    - preprocessing:" << std::endl;
-    cv::Mat frame;
+    log << "    - preprocessing:" << std::endl;
+
+    log << "      * log samples:   " << logIndex.getRowCount() << "\n"
+            << "      * gps samples:   " << gpsIndex.getRowCount() << "\n"
+            << "      * total frames:  " << totalFrames << std::endl;
+
+    // Log streams are resampled at the frame times. Both logs are trimmed to the start of the
+    // video, so the first log timestamp is taken as the time origin of all three streams.
+    const int64_t originUs = logIndex.getFirstTimestampUs() != InputIndex::INVALID_TIMESTAMP
+                                 ? logIndex.getFirstTimestampUs()
+                                 : gpsIndex.getFirstTimestampUs();
+    auto toStreamTime = [originUs](int64_t timestampUs) {
+        return (timestampUs - originUs) * 1e-6;
+    };
+
+    // Row timestamps were already parsed by the index pass
+    auto rowTimestamp = [](const CsvReader& reader, const InputIndex& index, int column, int64_t& timestampUs) {
+        const uint64_t row = reader.getRowNumber() - 1;
+        if (row < index.getRowCount()) {
+            timestampUs = index.getTimestampUs(row);
+            return timestampUs != InputIndex::INVALID_TIMESTAMP;
+        }
+        return parseTimestampUs(reader.field(column), timestampUs);
+    };
+
+    TimeAlignedStream<LocalPositionSample> localPositionStream([&](LocalPositionSample& sample) {
+        while (logReader.next()) {
+            int64_t timestampUs;
+            if (!rowTimestamp(logReader, logIndex, colLogTime, timestampUs)
+                    || !logReader.getDouble(colVx, sample.vx)
+                    || !logReader.getDouble(colVy, sample.vy)
+                    || !logReader.getDouble(colZ, sample.z)) {
+                std::cerr << "Error: Malformed log row " << logReader.getRowNumber() << "." << std::endl;
+                continue;
+            }
+            sample.timestamp = toStreamTime(timestampUs);
+            return true;
+        }
+        return false;
+    });
+
+    TimeAlignedStream<GpsSample> gpsStream([&](GpsSample& sample) {
+        while (gpsReader.next()) {
+            int64_t timestampUs, latE7, lonE7;
+            double velocity;
+            if (!rowTimestamp(gpsReader, gpsIndex, colGpsTime, timestampUs)
+                    || !gpsReader.getInt64(colLat, latE7)
+                    || !gpsReader.getInt64(colLon, lonE7)
+                    || !gpsReader.getDouble(colVel, velocity)) {
+                std::cerr << "Error: Malformed GPS row " << gpsReader.getRowNumber() << "." << std::endl;
+                continue;
+            }
+            sample.data = SensorData(toStreamTime(timestampUs));
+            sample.data.setGPSData(GPSData(latE7 / 1e7, lonE7 / 1e7, 0.0));
+            sample.velocity = velocity;
+            return true;
+        }
+        return false;
+    });
+
+    // Pipeline: decoder -> grayscale/downscale -> optical flow -> fusion/writer (this thread)
+    std::atomic<bool> stopPipeline(false);
+    SpscRingBuffer<FramePacket> decodedFrames(PIPELINE_DEPTH);
+    SpscRingBuffer<FramePacket> preparedFrames(PIPELINE_DEPTH);
+    SpscRingBuffer<FlowPacket> flowResults(PIPELINE_DEPTH);
+
+    // Consumed image buffers travel back upstream so decoding and downscaling reuse their allocations
+    // (a buffer is dropped if its free list is full)
+    SpscRingBuffer<cv::Mat> freeDecodedImages(PIPELINE_DEPTH * 2);
+    SpscRingBuffer<cv::Mat> freePreparedImages(PIPELINE_DEPTH * 2);
+
+    // Joins the stages on every way out of this function
+    PipelineThreads stages(stopPipeline);
+
+    stages.start([&]() {
+        double lastTime = -1.0;
+        for (int index = 1; ; ++index) {
+            FramePacket packet;
+            packet.index = index;
+            packet.skipped = !opticalFlowProcessor_.acceptFrame();
+
+            // Skipped frames are only demuxed and decoded, never converted to an image
+            bool decoded;
+            {
+                FLORA_PROFILE_SCOPE(profiler_, STAGE_DECODE);
+                if (packet.skipped) {
+                    decoded = cap.skip();
+                } else {
+                    freeDecodedImages.tryPop(packet.image);
+                    decoded = cap.read(packet.image);
+                }
+            }
+            if (!decoded) break;
 
-    int minSamples = std::min({logLines, gpsLines, totalFrames});
-    int maxSamples = std::max({logLines, gpsLines, totalFrames});
+            // Prefer the container timestamp; fall back to the nominal rate if it is missing or not increasing
+            packet.time = cap.getPosition();
+            if (!(packet.time > lastTime)) {
+                packet.time = fps > 0 ? (index - 1) / static_cast<double>(fps) : lastTime + 1.0;
+            }
+            lastTime = packet.time;
 
-    int frameCount = 0;
-    int logCount = 0;
-    int gpsCount = 0;
-
-    int logCounter = 0;
-    int gpsCounter = 0;
-    int videoCounter = 0;
-
-    int logEvery = std::round(fps / freqLog);
-    int gpsEvery = std::round(fps / freqGPS);
-    int videoEvery = 1;
-
-    std::cout << "      * total samples: " << minSamples << "\n"
-            << "      * log freq:     " << freqLog << " Hz\n"
-            << "      * gps freq:     " << freqGPS << " Hz\n"
-            << "      * total frames:  " << totalFrames << "\n"
-            << "      * min samples:   " << minSamples << "\n"
-            << "      * max samples:   " << maxSamples << "\n"
-            << "      * log   every:   " << logEvery << " iteration\n"
-            << "      * gps   every:   " << gpsEvery << " iteration\n"
-            << "      * frame every:   " << videoEvery << " iteration" << std::endl;
-
-    std::string line;
-    std::string gpsLine;
-
-    std::cout << "    - processing frames and log data:\n";
-    std::cout << "\n\n\n\n\n\n\n\n\n" << std::endl;
-    for (int i = 0; i < maxSamples; ++i) {
-        if (logCounter == 0) {
-            if (!std::getline(inFile, line)) break;
-            logCount++;
+            if (!decodedFrames.push(packet, stopPipeline)) return;
         }
-        logCounter = (logCounter + 1) % logEvery;
-
-        if (gpsCounter == 0) {
-            if (!std::getline(gpsFile, gpsLine)) break;
-            gpsCount++;
+        FramePacket endOfStream;
+        decodedFrames.push(endOfStream, stopPipeline);
+    });
+
+    stages.start([&]() {
+        FramePacket packet;
+        while (decodedFrames.pop(packet, stopPipeline)) {
+            FramePacket prepared;
+            prepared.index = packet.index;
+            prepared.time = packet.time;
+            prepared.skipped = packet.skipped;
+            if (!packet.isEnd() && !packet.skipped) {
+                FLORA_PROFILE_SCOPE(profiler_, STAGE_PREPARE);
+                freePreparedImages.tryPop(prepared.image);
+                opticalFlowProcessor_.prepareFrame(packet.image, prepared.image);
+                freeDecodedImages.tryPush(packet.image);
+            }
+            if (!preparedFrames.push(prepared, stopPipeline) || prepared.isEnd()) return;
         }
-        gpsCounter = (gpsCounter + 1) % gpsEvery;
-
-        if (videoCounter == 0) {
-            if (!cap.read(frame)) break;
-            frameCount++;
+    });
+
+    stages.start([&]() {
+        FramePacket packet;
+        while (preparedFrames.pop(packet, stopPipeline)) {
+            FlowPacket result;
+            result.index = packet.index;
+            result.time = packet.time;
+            result.skipped = packet.skipped;
+            if (!packet.isEnd() && !packet.skipped) {
+                FLORA_PROFILE_SCOPE(profiler_, STAGE_FLOW);
+                result.valid = opticalFlowProcessor_.measureFlow(packet.image, packet.time, result.measurement);
+                freePreparedImages.tryPush(packet.image);
+            }
+            if (!flowResults.push(result, stopPipeline) || result.isEnd()) return;
         }
-        videoCounter = (videoCounter + 1) % videoEvery;
+    });
 
-        // -----------------------------------------------------------------------------------------------------
-        // * Log file processing
-        std::stringstream lineStream(line);
-        std::string cell;
-        std::vector<std::string> values;
+    FlowPacket flowPacket;
+    LocalPositionSample localPosition;
+    GpsSample gps;
 
-        while (std::getline(lineStream, cell, ',')) {
-            values.push_back(cell);
+    int frameCount = 0;
+    double prevFrameTime = 0.0;
+    bool flowHeadingAligned = false;
+    double flowBearingOffset = 0.0;
+    IDRProcessor& positionProcessor = this->positionProcessor();
+    double lastGpsAidTime = -1.0;
+
+    // The final error is evaluated once, after the loop
+    GPSData lastPosition;
+    GPSData lastFix;
+
+    // Progress is written by the reporter thread, the loop only publishes snapshots
+    ProgressReporter progressReporter(progressMode_, progressRateHz_, *progressOut_, fileBasename_);
+    ProgressSnapshot progress;
+    progress.totalFrames = totalFrames;
+    progress.logTotal = static_cast<int64_t>(logIndex.getRowCount());
+    progress.gpsTotal = static_cast<int64_t>(gpsIndex.getRowCount());
+
+    log << "    - processing frames and log data:" << std::endl;
+    progressReporter.start();
+    while (flowResults.pop(flowPacket, stopPipeline) && !flowPacket.isEnd()) {
+        FLORA_PROFILE_SCOPE(profiler_, STAGE_FUSION);
+        frameCount++;
+        double frameTime = flowPacket.time;
+        double dt = frameTime - prevFrameTime;
+        prevFrameTime = frameTime;
+
+        // Stop once the frame time runs past the end of either log
+        bool synchronized;
+        {
+            FLORA_PROFILE_SCOPE(profiler_, STAGE_SYNC);
+            synchronized = localPositionStream.sampleAt(frameTime, localPosition) && gpsStream.sampleAt(frameTime, gps);
+        }
+        if (!synchronized) {
+            break;
         }
 
-        double timestamp = std::stod(values[columnIndex["timestamp"]]);
-        double vx = std::stod(values[columnIndex["vx"]]);
-        double vy = std::stod(values[columnIndex["vy"]]);
-        double alt = -std::stod(values[columnIndex["z"]]);
+        // -----------------------------------------------------------------------------------------------------
+        // * Log file processing
+        double vx = localPosition.vx;
+        double vy = localPosition.vy;
+        double alt = -localPosition.z;
 
         double heading_rad = std::atan2(vx, vy);
-        double heading_deg = heading_rad * 180.0 / M_PI;
-        if (heading_deg < 0) {
-            heading_deg += 360.0; // Normalize to [0, 360)
-        }
 
         // -----------------------------------------------------------------------------------------------------
         // * GPS file processing
-        std::stringstream gpsLineStream(gpsLine);
-        std::string gpsCell;
-        std::vector<std::string> gpsValues;
-
-        while (std::getline(gpsLineStream, gpsCell, ',')) {
-            gpsValues.push_back(gpsCell);
-        }
-
-        double ref_lat = std::stoi(gpsValues[gpsColumnIndex["lat"]]) / 1e7;
-        double ref_lon = std::stoi(gpsValues[gpsColumnIndex["lon"]]) / 1e7;
-        double ref_vel_m_s = std::stod(gpsValues[gpsColumnIndex["vel_m_s"]]);
+        GPSData gpsFix = gps.data.getGPSData();
+        double ref_lat = gpsFix.getLatitude();
+        double ref_lon = gpsFix.getLongitude();
+        double ref_vel_m_s = gps.velocity;
 
         // -----------------------------------------------------------------------------------------------------
-        // * Frame processing
-        if (!opticalFlowProcessor_.update(frame, alt)) {
+        // * Frame processing (flow was already measured by the pipeline stages; frames skipped by the
+        //   frame step keep the speed and heading of the last measurement)
+        if (!flowPacket.skipped && (!flowPacket.valid || !opticalFlowProcessor_.applyFlow(flowPacket.measurement, alt))) {
             std::cerr << "Error: Optical flow update failed for frame " << frameCount << "." << std::endl;
             continue;
         }
 
-        Vector3D velocity = opticalFlowProcessor_.getVelocity();
-        double speed_mps = velocity.getX();
+        double speed_mps = opticalFlowProcessor_.getSpeed();
+
+        // Camera heading: the flow gives the yaw change and the course relative to the camera
+        // (both clockwise); the camera orientation is aligned with the log heading once, on the first frame
+        if (headingSource_ == HeadingSource::FLOW) {
+            double cameraBearing = opticalFlowProcessor_.getYaw() + opticalFlowProcessor_.getHeading();
+            if (!flowHeadingAligned) {
+                flowBearingOffset = (M_PI / 2.0 - heading_rad) - cameraBearing;
+                flowHeadingAligned = true;
+            }
+            heading_rad = std::remainder(M_PI / 2.0 - (flowBearingOffset + cameraBearing), 2.0 * M_PI);
+        }
+
+        double heading_deg = heading_rad * 180.0 / M_PI;
+        if (heading_deg < 0) {
+            heading_deg += 360.0; // Normalize to [0, 360)
+        }
 
         // * Update dead reckoning processor
-        if (!deadReckoningProcessor_.update(
+        bool deadReckoningOk;
+        {
+            FLORA_PROFILE_SCOPE(profiler_, STAGE_DEAD_RECKONING);
+            deadReckoningOk = positionProcessor.update(
                 GPSData(ref_lat, ref_lon, alt),
                 alt,
                 heading_rad,
                 speed_mps,
-                1.0 / opticalFlowProcessor_.getFrameRate())) {
+                frameCount > 1 ? dt : 1.0 / opticalFlowProcessor_.getFrameRate());
+
+            // Intermittent GPS aiding, counted from the initial fix
+            if (deadReckoningOk && lastGpsAidTime < 0.0) {
+                lastGpsAidTime = frameTime;
+            } else if (deadReckoningOk && gpsAidIntervalSec_ > 0.0 && frameTime - lastGpsAidTime >= gpsAidIntervalSec_) {
+                if (positionProcessor.correct(gpsFix)) {
+                    summary_.gpsFixesUsed++;
+                } else {
+                    summary_.gpsFixesRejected++;
+                }
+                lastGpsAidTime = frameTime;
+            }
+        }
+        if (!deadReckoningOk) {
             std::cerr << "Error: Dead reckoning update failed for frame " << frameCount << "." << std::endl;
             continue;
         }
@@ -287,108 +610,107 @@ int NavProcessor::process(void) {
         // -----------------------------------------------------------------------------------------------------
         // * Get dead reckoning GPS data and write to output file
         // ? Hint: headers: frame_number | speed_mps | altitude | heading | dr_lat | dr_lon | gps_lat | gps_lon
-        GPSData gpsData = deadReckoningProcessor_.getGPSData();
-        outFile << frameCount << ","
-                << speed_mps << ","
-                << alt << ","
-                << heading_deg << ","
-                << gpsData.getLatitude() << ","
-                << gpsData.getLongitude() << ","
-                << ref_lat << ","
-                << ref_lon << ","
-                << ref_vel_m_s << "\n";
-
-        if (frameCount != 1) {
-            std::cout << "\033[11A";
-            for (int j = 0; j < 11; ++j) std::cout << "\033[2K\033[1B";
-            std::cout << "\033[11A";
+        GPSData gpsData = positionProcessor.getGPSData();
+        const double result[] = {
+            static_cast<double>(frameCount),
+            speed_mps,
+            alt,
+            heading_deg,
+            gpsData.getLatitude(),
+            gpsData.getLongitude(),
+            ref_lat,
+            ref_lon,
+            ref_vel_m_s
+        };
+        bool written;
+        {
+            FLORA_PROFILE_SCOPE(profiler_, STAGE_OUTPUT);
+            written = outFile.write(result);
+        }
+        if (!written) {
+            std::cerr << "Error: Could not write to output file: " << outputLogFile_ << std::endl;
+            break;
         }
-        
-        std::cout << "      frame:           " << frameCount << " / " << totalFrames << "\n"
-                << "      log_sample:      " << logCount << " / " << logLines << "\n"
-                << "      gps_sample:      " << gpsCount << " / " << gpsLines << "\n"
-                << "      speed:           " << speed_mps << " m/s\n"
-                << "      altitude:        " << alt << " m\n"
-                << "      heading:         " << heading_deg << " deg\n"
-                << "      dr_lat:          " << gpsData.getLatitude() << "\n"
-                << "      dr_lon:          " << gpsData.getLongitude() << "\n"
-                << "      gps_lat:         " << ref_lat << "\n"
-                << "      gps_lon:         " << ref_lon << "\n"
-                << "      gps_vel:         " << ref_vel_m_s << " m/s\n"
-                << std::flush;
-    }
-
-    outFile.close();
-    inFile.close();
-    cap.release();
-
-    return 0;
-}
-
 
-double NavProcessor::computeFrequencyFromTimestamps(const std::filesystem::path& csvFile, const std::string& columnName) {
-    std::ifstream file(csvFile);
-    if (!file.is_open()) {
-        throw std::runtime_error("Cannot open file: " + csvFile.string());
+        summary_.frames = frameCount;
+        lastPosition = gpsData;
+        lastFix = gpsFix;
+
+        progress.frame = frameCount;
+        progress.logSamples = localPositionStream.getSamplesRead();
+        progress.gpsSamples = gpsStream.getSamplesRead();
+        progress.speed = speed_mps;
+        progress.altitude = alt;
+        progress.heading = heading_deg;
+        progress.drLat = gpsData.getLatitude();
+        progress.drLon = gpsData.getLongitude();
+        progress.gpsLat = ref_lat;
+        progress.gpsLon = ref_lon;
+        progress.gpsVel = ref_vel_m_s;
+        progressReporter.publish(progress);
     }
 
-    std::string header;
-    std::getline(file, header);
-
-    std::stringstream ss(header);
-    std::string col;
-    int idx = -1, i = 0;
-    while (std::getline(ss, col, ',')) {
-        if (col == columnName) {
-            idx = i;
-            break;
-        }
-        i++;
+    progressReporter.finish(progress);
+    if (summary_.frames > 0) {
+        // Horizontal only: the position carries the flight altitude, the logged fixes none
+        const Vector3D offset = LocalFrame(lastFix).toENU(lastPosition.getLatitude(), lastPosition.getLongitude(),
+                                                          lastFix.getAltitude());
+        summary_.finalErrorM = std::hypot(offset.getX(), offset.getY());
+    }
+    if (gpsAidIntervalSec_ > 0.0) {
+        // The aiding fixes are the evaluation fixes, so an aided final error is not an independent measure
+        log << "    - GPS aiding: " << summary_.gpsFixesUsed << " fixes used, " << summary_.gpsFixesRejected
+            << " rejected (fixes taken from the evaluation GPS log)" << std::endl;
     }
 
-    if (idx == -1) throw std::runtime_error("Column not found: " + columnName);
+    stages.join();
 
-    std::vector<long long> microseconds;
-    std::string line;
-    int lineLimit = 100;
+    bool outputOk = outFile.close();
+    logReader.close();
+    gpsReader.close();
+    cap.release();
 
-    while (std::getline(file, line) && microseconds.size() < lineLimit) {
-        std::stringstream ls(line);
-        std::string cell;
-        int colIndex = 0;
-        std::string tsStr;
+    summary_.durationSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
 
-        while (std::getline(ls, cell, ',')) {
-            if (colIndex == idx) {
-                tsStr = cell;
-                break;
-            }
-            colIndex++;
-        }
+#if FLORA_PROFILE_ENABLED
+    log << "    - stage timing:" << std::endl;
+    profiler_.printReport(log, static_cast<uint64_t>(summary_.frames), summary_.durationSec);
+#endif
+    if (!profileOutputFile_.empty()) {
+        writeProfile(profileOutputFile_);
+    }
+    if (!outputOk) {
+        std::cerr << "Error: Could not write output file: " << outputLogFile_ << std::endl;
+        return -1;
+    }
+    return 0;
+}
 
-        std::tm tm = {};
-        int micro = 0;
-        std::istringstream tsStream(tsStr);
-        tsStream >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
-        if (tsStr.find('.') != std::string::npos) {
-            std::string micros = tsStr.substr(tsStr.find('.') + 1);
-            micro = std::stoi(micros.substr(0, 6)); // max 6 digits
-        }
 
-        auto tp = std::chrono::system_clock::from_time_t(std::mktime(&tm));
-        long long us = std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch()).count();
-        us += micro;
-        microseconds.push_back(us);
-    }
+void NavProcessor::printIndexSummary(const std::string& label, const std::filesystem::path& csvFile, const InputIndex& index) {
+    *log_ << "      * " << label << ": " << csvFile << " | rows: " << index.getRowCount()
+              << (index.isFromSidecar() ? " (sidecar index)" : "") << "\n"
+              << "        rate: " << index.getMeanRate() << " Hz"
+              << " | interval min/max: " << index.getMinInterval() * 1e3 << " / " << index.getMaxInterval() * 1e3 << " ms"
+              << " | jitter: " << index.getIntervalJitter() * 1e3 << " ms" << std::endl;
+}
 
-    if (microseconds.size() < 2) throw std::runtime_error("Not enough samples.");
 
-    std::vector<long long> diffs;
-    for (size_t i = 1; i < microseconds.size(); ++i) {
-        diffs.push_back(microseconds[i] - microseconds[i - 1]);
+std::vector<std::string> NavProcessor::profileStageNames() {
+    return {"decode", "prepare", "flow", "fusion", "sync", "dead_reckoning", "output"};
+}
+
+bool NavProcessor::writeProfile(const std::filesystem::path& file) const {
+    if (!FLORA_PROFILE_ENABLED) {
+        std::cerr << "Warning: Stage timing is not compiled in (configure with -DENABLE_PROFILING=ON)." << std::endl;
+        return false;
     }
 
-    double avgDiffMicro = std::accumulate(diffs.begin(), diffs.end(), 0.0) / diffs.size();
-    double freq = 1e6 / avgDiffMicro;
-    return freq;
-}
\ No newline at end of file
+    std::ofstream out(file);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not open profile output file: " << file << std::endl;
+        return false;
+    }
+    profiler_.writeCsv(out, static_cast<uint64_t>(summary_.frames), summary_.durationSec);
+    return static_cast<bool>(out);
+}
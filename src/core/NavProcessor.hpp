@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <iostream>
 #include <fstream>
@@ -9,9 +12,67 @@
 #include <vector>
 #include <cmath>
 #include <numeric>
+#include <thread>
 
+#include "pipeline/PipelineThreads.hpp"
+#include "pipeline/SpscRingBuffer.hpp"
+#include "profiling/StageProfiler.hpp"
+#include "sync/TimeAlignedStream.hpp"
+#include "video/VideoSource.hpp"
+#include "../io/CsvReader.hpp"
+#include "../io/InputIndex.hpp"
+#include "../io/ProgressReporter.hpp"
+#include "../io/ResultWriter.hpp"
+#include "../io/Timestamp.hpp"
 #include "../nav-dr/core/DeadReckoningProcessor.hpp"
+#include "../nav-dr/sensors/SensorData.hpp"
 #include "../nav-of/core/OpticalFlowProcessor.hpp"
+#include "../nav-sf/core/ErrorStateKalmanProcessor.hpp"
+
+/**
+ * @brief Source of the heading that drives dead reckoning
+ */
+enum class HeadingSource {
+    LOG = 0,    // direction of the logged local velocity (vx, vy)
+    FLOW        // camera yaw and course from the optical flow, aligned with the log on the first frame
+};
+
+/**
+ * @brief Parses a heading source name ("log", "flow")
+ *
+ * @param name Source name
+ * @param source Parsed source
+ * @return true if the name is known
+ */
+bool parseHeadingSource(const std::string& name, HeadingSource& source);
+
+/**
+ * @brief Processor that estimates the position
+ */
+enum class PositionEstimator {
+    DEAD_RECKONING = 0, // open-loop integration of flow speed and heading (DeadReckoningProcessor)
+    ESKF                // error-state Kalman filter, also fuses altitude and GPS fixes (ErrorStateKalmanProcessor)
+};
+
+/**
+ * @brief Parses a position estimator name ("dr", "eskf")
+ *
+ * @param name Estimator name
+ * @param estimator Parsed estimator
+ * @return true if the name is known
+ */
+bool parsePositionEstimator(const std::string& name, PositionEstimator& estimator);
+
+/**
+ * @brief Result of one processed flight
+ */
+struct ProcessSummary {
+    int frames = 0;            // Frames written to the output file
+    double durationSec = 0.0;  // Wall time of process()
+    double finalErrorM = 0.0;  // Horizontal distance between the estimated and GPS position at the last frame
+    int gpsFixesUsed = 0;      // GPS aiding fixes accepted by the estimator (taken from the same GPS log as finalErrorM)
+    int gpsFixesRejected = 0;  // GPS aiding fixes the estimator refused (gated or not initialized)
+};
 
 class NavProcessor {
 public:
@@ -25,33 +86,165 @@ public:
         opticalFlowProcessor_.setFrameRate(fps);
     }
 
+    int setFlowBackend(const std::string& backendName);
+
+    /**
+     * @brief Sizes the process-wide OpenCV thread pool shared by all processors (0 = all cores)
+     */
+    static void setFlowThreads(int threads) { OpticalFlowProcessor::setFlowThreads(threads); }
+
+    /**
+     * @brief Restricts the optical flow to part of the frame
+     *
+     * @param regions Regions "x,y,w,h" as fractions of the frame (empty = whole frame)
+     * @param maskFile Mask image, black pixels are excluded (empty = no mask)
+     * @param stride Dense flow is evaluated on every stride-th pixel in x and y
+     * @return 0 on success, -1 for an invalid region, stride or mask file
+     */
+    int setFlowSampling(const std::vector<std::string>& regions, const std::string& maskFile, int stride);
+
+    /**
+     * @brief Lets the optical flow resolution follow altitude and speed
+     */
+    void setAdaptiveFlowScale(bool enabled) { opticalFlowProcessor_.setAdaptiveScale(enabled); }
+
+    /**
+     * @brief Allows measuring the optical flow over up to maxStep frames on calm segments (1 = every frame)
+     */
+    void setMaxFrameStep(int maxStep) { opticalFlowProcessor_.setMaxFrameStep(maxStep); }
+
+    /**
+     * @brief Selects the video decoding front-end
+     *
+     * @param decoder Decoder (AUTO prefers the reduced-resolution luma path)
+     * @param threads Decoder threads (0 = decoder default)
+     */
+    void setVideoDecoder(VideoDecoder decoder, int threads) {
+        videoDecoder_ = decoder;
+        videoDecoderThreads_ = threads;
+    }
+
+    /**
+     * @brief Selects the heading used for dead reckoning (flow needs a backend that reports direction)
+     */
+    void setHeadingSource(HeadingSource source) { headingSource_ = source; }
+
+    /**
+     * @brief Selects how dead reckoning integrates the position
+     */
+    void setDeadReckoningIntegration(DeadReckoningIntegration integration) {
+        deadReckoningProcessor_.setIntegration(integration);
+    }
+
+    /**
+     * @brief Selects the processor that estimates the position
+     */
+    void setPositionEstimator(PositionEstimator estimator) { positionEstimator_ = estimator; }
+
+    /**
+     * @brief Fuses a GPS fix every intervalSec seconds of video (0 = only the initial fix; ignored by
+     *        the open-loop dead reckoning)
+     */
+    void setGpsAidInterval(double intervalSec) { gpsAidIntervalSec_ = intervalSec; }
+
+    /**
+     * @brief Persists the input log indexes as sidecar files and reuses them on later runs
+     */
+    void setIndexSidecar(bool enabled) { useIndexSidecar_ = enabled; }
+
+    /**
+     * @brief Selects the output file format (call before initOutput)
+     */
+    void setOutputFormat(ResultFormat format) { outputFormat_ = format; }
+
+    /**
+     * @brief Configures progress reporting of process()
+     *
+     * @param mode Output mode
+     * @param rateHz Reports per second
+     * @param out Output stream (must outlive process())
+     */
+    void setProgress(ProgressMode mode, double rateHz, std::ostream& out) {
+        progressMode_ = mode;
+        progressRateHz_ = rateHz;
+        progressOut_ = &out;
+    }
+
+    /**
+     * @brief Writes the per-stage timing of each process() run as CSV (requires FLORA_ENABLE_PROFILING)
+     */
+    void setProfileOutput(const std::filesystem::path& file) { profileOutputFile_ = file; }
+
+    /**
+     * @brief Suppresses the console output of process() except progress (errors are still written to stderr)
+     */
+    void setQuiet(bool quiet);
+
+    /**
+     * @brief Checks if a directory holds a complete flight (log_<id>_converted_trimmed logs and video_<id>.mp4)
+     */
+    static bool isFlightDirectory(const std::filesystem::path& dir);
+
     int initInput(const std::filesystem::path& inputDir);
 
     int initOutput(const std::filesystem::path& outputDir);
 
     int process(void);
 
+    const ProcessSummary& getSummary() const { return summary_; }
+
+    const StageProfiler& getProfiler() const { return profiler_; }
+
+    const std::string& getBasename() const { return fileBasename_; }
+
+    const std::filesystem::path& getOutputFile() const { return outputLogFile_; }
+
 private:
-    size_t countLinesInFile(const std::string& filePath) {
-        std::ifstream file(filePath);
-        size_t lines = 0;
-        std::string unused;
+    struct InputFiles {
+        std::string basename;
+        std::filesystem::path logFile;
+        std::filesystem::path gpsFile;
+        std::filesystem::path videoFile;
+        std::filesystem::path logIndexFile;
+        std::filesystem::path gpsIndexFile;
+    };
 
-        while (std::getline(file, unused)) {
-            ++lines;
-        }
+    static std::vector<std::string> profileStageNames();
 
-        return lines;
-    }
+    bool writeProfile(const std::filesystem::path& file) const;
+
+    static bool resolveInputFiles(const std::filesystem::path& inputDir, InputFiles& files);
 
-    double computeFrequencyFromTimestamps(const std::filesystem::path& csvFile, const std::string& columnName);
+    void printIndexSummary(const std::string& label, const std::filesystem::path& csvFile, const InputIndex& index);
+
+    IDRProcessor& positionProcessor();
 
     OpticalFlowProcessor opticalFlowProcessor_;
     DeadReckoningProcessor deadReckoningProcessor_;
+    ErrorStateKalmanProcessor errorStateKalmanProcessor_;
 
     std::string fileBasename_;
     std::filesystem::path inputLogFile_;
     std::filesystem::path inputGPSFile_;
     std::filesystem::path inputVideoFile_;
+    std::filesystem::path inputLogIndexFile_;
+    std::filesystem::path inputGPSIndexFile_;
     std::filesystem::path outputLogFile_;
+    bool useIndexSidecar_ = false;
+    VideoDecoder videoDecoder_ = VideoDecoder::AUTO;
+    int videoDecoderThreads_ = 0;
+    HeadingSource headingSource_ = HeadingSource::LOG;
+    PositionEstimator positionEstimator_ = PositionEstimator::DEAD_RECKONING;
+    double gpsAidIntervalSec_ = 0.0;
+    ResultFormat outputFormat_ = ResultFormat::CSV;
+
+    std::ostream* log_ = &std::cout;
+    std::ostream nullStream_{nullptr};  // Discards everything written to it (quiet mode); one per processor, as
+                                        // batch workers set stream flags on it concurrently
+    ProgressMode progressMode_ = ProgressMode::TTY;
+    double progressRateHz_ = 5.0;
+    std::ostream* progressOut_ = &std::cout;
+    ProcessSummary summary_;
+    StageProfiler profiler_{profileStageNames()};
+    std::filesystem::path profileOutputFile_;
 };
\ No newline at end of file
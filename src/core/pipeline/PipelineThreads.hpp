@@ -0,0 +1,58 @@
+// PipelineThreads.hpp
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Owns the threads of a pipeline and joins them on destruction
+ *
+ * The destructor raises the shared stop flag before joining, so stages blocked on
+ * a ring buffer return even when the consumer left early (an error or an exception
+ * in the fusion loop); a std::thread destroyed while joinable would call std::terminate.
+ * Declare it after everything the stages reference, so it is destroyed first.
+ */
+class PipelineThreads {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param stop Stop flag shared by the pipeline (must outlive this object)
+     */
+    explicit PipelineThreads(std::atomic<bool>& stop)
+        : stop_(stop)
+    {
+    }
+
+    PipelineThreads(const PipelineThreads&) = delete;
+    PipelineThreads& operator=(const PipelineThreads&) = delete;
+
+    ~PipelineThreads() { join(); }
+
+    /**
+     * @brief Starts a stage on a new thread
+     */
+    template <typename Fn>
+    void start(Fn&& stage) {
+        threads_.emplace_back(std::forward<Fn>(stage));
+    }
+
+    /**
+     * @brief Raises the stop flag and waits for all stages
+     */
+    void join() {
+        stop_ = true;
+        for (std::thread& thread : threads_) {
+            if (thread.joinable()) thread.join();
+        }
+        threads_.clear();
+    }
+
+    size_t size() const { return threads_.size(); }
+
+private:
+    std::atomic<bool>& stop_;
+    std::vector<std::thread> threads_;
+};
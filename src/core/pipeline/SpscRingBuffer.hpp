@@ -0,0 +1,170 @@
+// SpscRingBuffer.hpp
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Bounded lock-free single-producer / single-consumer ring buffer
+ *
+ * Connects two pipeline stages running on separate threads. The producer
+ * blocks while the buffer is full, which gives backpressure to faster
+ * upstream stages, and the consumer blocks while it is empty. A waiting side
+ * yields for SPIN_TRIES attempts, then parks on a condition variable until
+ * the other side moves an element; an idle stage does not occupy a core.
+ * Parked waits re-check the shared stop flag every PARK_TIMEOUT, so both
+ * sides stop waiting once it is raised. tryPush/tryPop stay lock-free; they
+ * only take the mutex to wake a parked waiter.
+ *
+ * @tparam T Element type (moved in and out of the buffer)
+ */
+template <typename T>
+class SpscRingBuffer {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param capacity Maximum number of queued elements (rounded up to a power of two)
+     */
+    explicit SpscRingBuffer(size_t capacity)
+        : mask_(roundUpPow2(capacity < 2 ? 2 : capacity) - 1)
+        , slots_(mask_ + 1)
+    {
+    }
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    size_t capacity() const { return mask_ + 1; }
+
+    static constexpr int SPIN_TRIES = 64;
+    static constexpr std::chrono::milliseconds PARK_TIMEOUT{5};
+
+    /**
+     * @brief Tries to enqueue an element without waiting
+     *
+     * @return true if the element was enqueued
+     */
+    bool tryPush(T& value) {
+        if (!enqueue(value)) return false;
+        wakeWaiter();
+        return true;
+    }
+
+    /**
+     * @brief Tries to dequeue an element without waiting
+     *
+     * @return true if an element was dequeued
+     */
+    bool tryPop(T& value) {
+        if (!dequeue(value)) return false;
+        wakeWaiter();
+        return true;
+    }
+
+    /**
+     * @brief Enqueues an element, waiting while the buffer is full
+     *
+     * @param value Element to enqueue
+     * @param stop Stop flag shared by the pipeline
+     * @return false if the pipeline was stopped before the element was enqueued
+     */
+    bool push(T& value, const std::atomic<bool>& stop) {
+        return wait([&]() { return enqueue(value); }, stop);
+    }
+
+    /**
+     * @brief Dequeues an element, waiting while the buffer is empty
+     *
+     * @param value Dequeued element
+     * @param stop Stop flag shared by the pipeline
+     * @return false if the pipeline was stopped before an element arrived
+     */
+    bool pop(T& value, const std::atomic<bool>& stop) {
+        return wait([&]() { return dequeue(value); }, stop);
+    }
+
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+
+private:
+    bool enqueue(T& value) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) > mask_) {
+            return false;
+        }
+        slots_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool dequeue(T& value) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Retries attempt until it succeeds or the stop flag is raised: spins first, then parks
+    template <typename Attempt>
+    bool wait(Attempt attempt, const std::atomic<bool>& stop) {
+        bool done = false;
+        for (int spin = 0; spin < SPIN_TRIES && !done; ++spin) {
+            done = attempt();
+            if (!done && stop.load(std::memory_order_relaxed)) return false;
+            if (!done) std::this_thread::yield();
+        }
+
+        if (!done) {
+            // The waiter is registered before the next attempt, so a concurrent wakeWaiter() either
+            // sees it or its element is seen by that attempt (the fences order both sides)
+            std::unique_lock<std::mutex> lock(mutex_);
+            waiters_.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            while (!(done = attempt()) && !stop.load(std::memory_order_relaxed)) {
+                wakeup_.wait_for(lock, PARK_TIMEOUT);
+            }
+            waiters_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        if (done) wakeWaiter();
+        return done;
+    }
+
+    void wakeWaiter() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            wakeup_.notify_all();
+        }
+    }
+
+    static size_t roundUpPow2(size_t value) {
+        size_t result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+
+    const size_t mask_;
+    std::vector<T> slots_;
+
+    // Producer and consumer indices live on separate cache lines
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+
+    // Parking for push/pop; both sides share them, at most one of them waits at a time in practice
+    alignas(64) std::atomic<int> waiters_{0};
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+};
@@ -0,0 +1,148 @@
+// StageProfiler.cpp
+#include "StageProfiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+namespace {
+
+int highestBit(uint64_t value) {
+    int bit = 0;
+    while (value >>= 1) ++bit;
+    return bit;
+}
+
+double toMicroseconds(double nanoseconds) {
+    return nanoseconds * 1e-3;
+}
+
+} // namespace
+
+int LatencyHistogram::bucketIndex(uint64_t value) {
+    if (value < static_cast<uint64_t>(SUB_BUCKETS)) {
+        return static_cast<int>(value);
+    }
+    const int exponent = highestBit(value);
+    const int shift = exponent - SUB_BUCKET_BITS;
+    const int subBucket = static_cast<int>((value >> shift) & (SUB_BUCKETS - 1));
+    return (shift + 1) * SUB_BUCKETS + subBucket;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int index) {
+    if (index < SUB_BUCKETS) {
+        return static_cast<uint64_t>(index);
+    }
+    const int shift = index / SUB_BUCKETS - 1;
+    const uint64_t subBucket = static_cast<uint64_t>(index % SUB_BUCKETS);
+    const uint64_t lower = (static_cast<uint64_t>(SUB_BUCKETS) | subBucket) << shift;
+    return lower + ((uint64_t(1) << shift) - 1);
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    ++counts_[bucketIndex(value)];
+    ++count_;
+    total_ += value;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (int i = 0; i < BUCKETS; ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    total_ += other.total_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+void LatencyHistogram::reset() {
+    counts_.fill(0);
+    count_ = 0;
+    total_ = 0;
+    min_ = UINT64_MAX;
+    max_ = 0;
+}
+
+uint64_t LatencyHistogram::getPercentile(double percentile) const {
+    if (count_ == 0) {
+        return 0;
+    }
+
+    if (percentile <= 0.0) {
+        return getMin();
+    }
+    percentile = std::min(percentile, 100.0);
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * count_)));
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; ++i) {
+        seen += counts_[i];
+        if (seen >= rank) {
+            return std::clamp(bucketUpperBound(i), getMin(), max_);
+        }
+    }
+    return max_;
+}
+
+StageProfiler::StageProfiler(std::vector<std::string> stageNames)
+    : stageNames_(std::move(stageNames))
+    , histograms_(stageNames_.size())
+{
+}
+
+void StageProfiler::reset() {
+    for (LatencyHistogram& histogram : histograms_) {
+        histogram.reset();
+    }
+}
+
+void StageProfiler::printReport(std::ostream& out, uint64_t frames, double wallSeconds) const {
+    const std::ios::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+
+    out << std::fixed << std::setprecision(1)
+        << "      " << std::left << std::setw(16) << "stage" << std::right
+        << std::setw(10) << "count"
+        << std::setw(12) << "mean[us]"
+        << std::setw(12) << "p50[us]"
+        << std::setw(12) << "p99[us]"
+        << std::setw(12) << "max[us]"
+        << std::setw(10) << "total[%]" << "\n";
+
+    for (int stage = 0; stage < getStageCount(); ++stage) {
+        const LatencyHistogram& histogram = histograms_[stage];
+        const double share = wallSeconds > 0.0 ? histogram.getTotal() * 1e-9 / wallSeconds * 100.0 : 0.0;
+        out << "      " << std::left << std::setw(16) << stageNames_[stage] << std::right
+            << std::setw(10) << histogram.getCount()
+            << std::setw(12) << toMicroseconds(histogram.getMean())
+            << std::setw(12) << toMicroseconds(static_cast<double>(histogram.getPercentile(50.0)))
+            << std::setw(12) << toMicroseconds(static_cast<double>(histogram.getPercentile(99.0)))
+            << std::setw(12) << toMicroseconds(static_cast<double>(histogram.getMax()))
+            << std::setw(10) << share << "\n";
+    }
+
+    out << "      frames: " << frames << " in " << std::setprecision(2) << wallSeconds << " s ("
+        << (wallSeconds > 0.0 ? frames / wallSeconds : 0.0) << " frames/s)" << std::endl;
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void StageProfiler::writeCsv(std::ostream& out, uint64_t frames, double wallSeconds) const {
+    out << "stage,count,mean_us,p50_us,p99_us,max_us,total_s,frames,wall_s,frames_per_s\n";
+    out << std::fixed << std::setprecision(3);
+    for (int stage = 0; stage < getStageCount(); ++stage) {
+        const LatencyHistogram& histogram = histograms_[stage];
+        out << stageNames_[stage] << ","
+            << histogram.getCount() << ","
+            << toMicroseconds(histogram.getMean()) << ","
+            << toMicroseconds(static_cast<double>(histogram.getPercentile(50.0))) << ","
+            << toMicroseconds(static_cast<double>(histogram.getPercentile(99.0))) << ","
+            << toMicroseconds(static_cast<double>(histogram.getMax())) << ","
+            << histogram.getTotal() * 1e-9 << ","
+            << frames << ","
+            << wallSeconds << ","
+            << (wallSeconds > 0.0 ? frames / wallSeconds : 0.0) << "\n";
+    }
+}
@@ -0,0 +1,161 @@
+// StageProfiler.hpp
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Latency histogram with log-linear buckets (HDR histogram style)
+ *
+ * Values below 2^SUB_BUCKET_BITS are counted exactly; above that every
+ * power of two is split into 2^SUB_BUCKET_BITS linear sub-buckets, so any
+ * recorded value is reproduced with a relative error below 2^-SUB_BUCKET_BITS
+ * (~3%) over the whole 64-bit range. Recording is a handful of integer
+ * instructions and never allocates.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    /**
+     * @brief Records one value (e.g. nanoseconds)
+     */
+    void record(uint64_t value);
+
+    /**
+     * @brief Adds all values of another histogram
+     */
+    void merge(const LatencyHistogram& other);
+
+    void reset();
+
+    uint64_t getCount() const { return count_; }
+    uint64_t getMin() const { return count_ > 0 ? min_ : 0; }
+    uint64_t getMax() const { return max_; }
+    uint64_t getTotal() const { return total_; }
+    double getMean() const { return count_ > 0 ? static_cast<double>(total_) / count_ : 0.0; }
+
+    /**
+     * @brief Value at the given percentile (0-100), within the bucket resolution
+     */
+    uint64_t getPercentile(double percentile) const;
+
+    /**
+     * @brief Bucket index of a value
+     */
+    static int bucketIndex(uint64_t value);
+
+    /**
+     * @brief Largest value that falls into the given bucket
+     */
+    static uint64_t bucketUpperBound(int index);
+
+private:
+    std::array<uint64_t, BUCKETS> counts_{};
+    uint64_t count_ = 0;
+    uint64_t total_ = 0;
+    uint64_t min_ = UINT64_MAX;
+    uint64_t max_ = 0;
+};
+
+/**
+ * @brief Per-stage latency histograms of a processing run
+ *
+ * Every stage must be recorded by a single thread (pipeline stages each own
+ * their stage), so recording needs no synchronization. Read the results only
+ * after the recording threads were joined.
+ */
+class StageProfiler {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param stageNames Stage names, stage ids are the indices into this list
+     */
+    explicit StageProfiler(std::vector<std::string> stageNames);
+
+    /**
+     * @brief Records the duration of one execution of a stage
+     */
+    void record(int stage, std::chrono::steady_clock::duration duration) {
+        histograms_[stage].record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+    }
+
+    /**
+     * @brief Clears all histograms
+     */
+    void reset();
+
+    const LatencyHistogram& getHistogram(int stage) const { return histograms_[stage]; }
+
+    const std::string& getStageName(int stage) const { return stageNames_[stage]; }
+
+    int getStageCount() const { return static_cast<int>(stageNames_.size()); }
+
+    /**
+     * @brief Writes a table with count, mean, p50, p99 and max per stage in microseconds
+     *
+     * @param out Output stream
+     * @param frames Frames processed during the run
+     * @param wallSeconds Wall time of the run
+     */
+    void printReport(std::ostream& out, uint64_t frames, double wallSeconds) const;
+
+    /**
+     * @brief Writes the per-stage statistics as CSV
+     *
+     * @param out Output stream
+     * @param frames Frames processed during the run
+     * @param wallSeconds Wall time of the run
+     */
+    void writeCsv(std::ostream& out, uint64_t frames, double wallSeconds) const;
+
+private:
+    std::vector<std::string> stageNames_;
+    std::vector<LatencyHistogram> histograms_;
+};
+
+/**
+ * @brief Records the lifetime of a scope into a profiler stage
+ */
+class ScopedStageTimer {
+public:
+    ScopedStageTimer(StageProfiler& profiler, int stage)
+        : profiler_(profiler)
+        , stage_(stage)
+        , start_(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~ScopedStageTimer() {
+        profiler_.record(stage_, std::chrono::steady_clock::now() - start_);
+    }
+
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+private:
+    StageProfiler& profiler_;
+    int stage_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Stage timing is compiled in only with FLORA_ENABLE_PROFILING (CMake option ENABLE_PROFILING)
+#define FLORA_PROFILE_CONCAT_INNER(a, b) a##b
+#define FLORA_PROFILE_CONCAT(a, b) FLORA_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef FLORA_ENABLE_PROFILING
+#define FLORA_PROFILE_ENABLED 1
+#define FLORA_PROFILE_SCOPE(profiler, stage) \
+    ScopedStageTimer FLORA_PROFILE_CONCAT(profileScope_, __LINE__)((profiler), static_cast<int>(stage))
+#else
+#define FLORA_PROFILE_ENABLED 0
+#define FLORA_PROFILE_SCOPE(profiler, stage) ((void)0)
+#endif
@@ -0,0 +1,82 @@
+// TimeAlignedStream.hpp
+#pragma once
+
+#include <functional>
+
+/**
+ * @brief Resamples a time-ordered sample stream at arbitrary query times
+ *
+ * Keeps only the two samples bracketing the last query time. Queries must be
+ * non-decreasing, so every sample is read exactly once and the stream is
+ * traversed in a single forward pass (O(1) amortized per query).
+ *
+ * Sample must provide:
+ *  - double getTimestamp() const (seconds, non-decreasing)
+ *  - static Sample interpolate(const Sample& first, const Sample& second, double targetTime)
+ *
+ * @tparam Sample Sample type (e.g. SensorData)
+ */
+template <typename Sample>
+class TimeAlignedStream {
+public:
+    /**
+     * @brief Reads the next sample of the stream
+     *
+     * @return false at the end of the stream
+     */
+    using Reader = std::function<bool(Sample&)>;
+
+    explicit TimeAlignedStream(Reader reader)
+        : reader_(std::move(reader))
+    {
+    }
+
+    /**
+     * @brief Returns the stream value at the given time
+     *
+     * Times before the first sample return the first sample.
+     *
+     * @param time Query time in seconds (non-decreasing between calls)
+     * @param sample Interpolated sample
+     * @return false if the time lies past the last sample of the stream
+     */
+    bool sampleAt(double time, Sample& sample) {
+        if (!started_) {
+            started_ = true;
+            hasPrev_ = reader_(prev_);
+            hasNext_ = hasPrev_ && reader_(next_);
+            samplesRead_ += hasPrev_ + hasNext_;
+        }
+        if (!hasPrev_) return false;
+
+        // Advance until the bracketing pair contains the query time
+        while (hasNext_ && next_.getTimestamp() < time) {
+            prev_ = next_;
+            hasNext_ = reader_(next_);
+            samplesRead_ += hasNext_;
+        }
+
+        if (!hasNext_) {
+            if (time > prev_.getTimestamp()) return false;
+            sample = prev_;
+            return true;
+        }
+
+        sample = Sample::interpolate(prev_, next_, time);
+        return true;
+    }
+
+    /**
+     * @brief Number of samples consumed from the reader so far
+     */
+    long long getSamplesRead() const { return samplesRead_; }
+
+private:
+    Reader reader_;
+    Sample prev_;
+    Sample next_;
+    bool started_ = false;
+    bool hasPrev_ = false;
+    bool hasNext_ = false;
+    long long samplesRead_ = 0;
+};
@@ -0,0 +1,122 @@
+// VideoSource.cpp
+#include "VideoSource.hpp"
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <opencv2/videoio/registry.hpp>
+
+bool parseVideoDecoder(const std::string& name, VideoDecoder& decoder) {
+    if (name == "auto") {
+        decoder = VideoDecoder::AUTO;
+    } else if (name == "gstreamer") {
+        decoder = VideoDecoder::GSTREAMER;
+    } else if (name == "ffmpeg") {
+        decoder = VideoDecoder::FFMPEG;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool VideoSource::open(const std::filesystem::path& file, VideoDecoder decoder, int analysisHeight, int threads) {
+    release();
+    threads_ = threads;
+
+    // The container metadata (and the fallback decoder) always come from FFmpeg
+    if (!openFFmpeg(file, threads)) {
+        return false;
+    }
+    frameRate_ = capture_.get(cv::CAP_PROP_FPS);
+    frameCount_ = static_cast<int>(capture_.get(cv::CAP_PROP_FRAME_COUNT));
+    frameSize_ = cv::Size(static_cast<int>(capture_.get(cv::CAP_PROP_FRAME_WIDTH)),
+                          static_cast<int>(capture_.get(cv::CAP_PROP_FRAME_HEIGHT)));
+    outputSize_ = frameSize_;
+
+    if (decoder == VideoDecoder::FFMPEG || frameSize_.height <= 0 || analysisHeight <= 0) {
+        if (decoder == VideoDecoder::GSTREAMER) {
+            std::cerr << "Error: Unknown frame size of video file: " << file << std::endl;
+            release();
+            return false;
+        }
+        return true;
+    }
+
+    if (!cv::videoio_registry::hasBackend(cv::CAP_GSTREAMER)) {
+        if (decoder == VideoDecoder::GSTREAMER) {
+            std::cerr << "Error: OpenCV was built without GStreamer support." << std::endl;
+            release();
+            return false;
+        }
+        return true;
+    }
+
+    // Same output size as OpticalFlowProcessor::prepareFrame() computes for a full-resolution frame
+    int scaledWidth = static_cast<int>(frameSize_.width * (analysisHeight / static_cast<float>(frameSize_.height)));
+    cv::Size scaledSize(scaledWidth, analysisHeight);
+
+    capture_.release();
+    if (openGStreamer(file, scaledSize)) {
+        grayOutput_ = true;
+        outputSize_ = scaledSize;
+        return true;
+    }
+
+    if (decoder == VideoDecoder::GSTREAMER) {
+        std::cerr << "Error: Could not open video file with GStreamer: " << file << std::endl;
+        release();
+        return false;
+    }
+    return openFFmpeg(file, threads);
+}
+
+bool VideoSource::openGStreamer(const std::filesystem::path& file, const cv::Size& outputSize) {
+    // Scale the native YUV frame before dropping the chroma planes; GRAY8 is the Y plane
+    std::ostringstream pipeline;
+    pipeline << "filesrc location=\"" << file.string() << "\" ! decodebin ! videoscale"
+             << " ! video/x-raw,width=" << outputSize.width << ",height=" << outputSize.height
+             << " ! videoconvert ! video/x-raw,format=GRAY8"
+             << " ! appsink sync=false max-buffers=4";
+    return capture_.open(pipeline.str(), cv::CAP_GSTREAMER);
+}
+
+bool VideoSource::openFFmpeg(const std::filesystem::path& file, int threads) {
+    if (threads > 0) {
+        const std::vector<int> params = {cv::CAP_PROP_N_THREADS, threads};
+        if (capture_.open(file.string(), cv::CAP_FFMPEG, params)) {
+            return true;
+        }
+    }
+    return capture_.open(file.string(), cv::CAP_FFMPEG) || capture_.open(file.string(), cv::CAP_ANY);
+}
+
+bool VideoSource::read(cv::Mat& frame) {
+    return capture_.read(frame);
+}
+
+bool VideoSource::skip() {
+    return capture_.grab();
+}
+
+double VideoSource::getPosition() const {
+    return capture_.get(cv::CAP_PROP_POS_MSEC) * 1e-3;
+}
+
+void VideoSource::release() {
+    capture_.release();
+    grayOutput_ = false;
+    frameRate_ = 0.0;
+    frameCount_ = 0;
+    frameSize_ = cv::Size();
+    outputSize_ = cv::Size();
+}
+
+std::string VideoSource::getDescription() const {
+    std::ostringstream description;
+    if (grayOutput_) {
+        description << "gstreamer, GRAY8 " << outputSize_.width << "x" << outputSize_.height;
+    } else {
+        description << capture_.getBackendName() << ", BGR " << outputSize_.width << "x" << outputSize_.height
+                    << ", threads: " << (threads_ > 0 ? std::to_string(threads_) : "auto");
+    }
+    return description.str();
+}
@@ -0,0 +1,100 @@
+// VideoSource.hpp
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <opencv2/core.hpp>
+#include <opencv2/videoio.hpp>
+
+/**
+ * @brief Video decoding front-end
+ */
+enum class VideoDecoder {
+    AUTO = 0,   // GStreamer luma path if available, FFmpeg otherwise
+    GSTREAMER,  // GStreamer: Y plane scaled to the analysis size inside the decoder pipeline
+    FFMPEG      // FFmpeg: full-resolution BGR frames, multi-threaded decoding
+};
+
+/**
+ * @brief Parses a decoder name ("auto", "gstreamer", "ffmpeg")
+ *
+ * @param name Decoder name
+ * @param decoder Parsed decoder
+ * @return true if the name is known
+ */
+bool parseVideoDecoder(const std::string& name, VideoDecoder& decoder);
+
+/**
+ * @brief Video file reader delivering frames for the optical flow analysis
+ *
+ * With GStreamer the decoder output (native YUV) is scaled to the analysis
+ * resolution and only the luma plane is handed over as 8-bit grayscale, so
+ * no full-resolution BGR image is ever created. The FFmpeg fallback decodes
+ * with multiple threads and returns BGR frames at the source resolution.
+ * Frame rate, frame count and source size always come from the container.
+ */
+class VideoSource {
+public:
+    /**
+     * @brief Opens a video file
+     *
+     * @param file Video file
+     * @param decoder Decoding front-end
+     * @param analysisHeight Output height of the GStreamer luma path (width keeps the aspect ratio)
+     * @param threads Decoder threads (0 = decoder default)
+     * @return false if the file cannot be opened with the requested decoder
+     */
+    bool open(const std::filesystem::path& file, VideoDecoder decoder, int analysisHeight, int threads = 0);
+
+    /**
+     * @brief Decodes the next frame
+     *
+     * @param frame Output frame (grayscale at the analysis size if isGrayOutput(), BGR otherwise);
+     *              an existing buffer of the right size is reused
+     * @return false at the end of the stream
+     */
+    bool read(cv::Mat& frame);
+
+    /**
+     * @brief Advances past the next frame without converting it to an image
+     *
+     * @return false at the end of the stream
+     */
+    bool skip();
+
+    /**
+     * @brief Presentation time of the last decoded frame in seconds (0 if unknown)
+     */
+    double getPosition() const;
+
+    void release();
+
+    bool isOpened() const { return capture_.isOpened(); }
+
+    bool isGrayOutput() const { return grayOutput_; }
+
+    double getFrameRate() const { return frameRate_; }
+
+    int getFrameCount() const { return frameCount_; }
+
+    const cv::Size& getFrameSize() const { return frameSize_; }
+
+    const cv::Size& getOutputSize() const { return outputSize_; }
+
+    /**
+     * @brief Decoder and output format, for logging (e.g. "gstreamer, GRAY8 640x360")
+     */
+    std::string getDescription() const;
+
+private:
+    bool openGStreamer(const std::filesystem::path& file, const cv::Size& outputSize);
+    bool openFFmpeg(const std::filesystem::path& file, int threads);
+
+    cv::VideoCapture capture_;
+    bool grayOutput_ = false;
+    double frameRate_ = 0.0;
+    int frameCount_ = 0;
+    int threads_ = 0;
+    cv::Size frameSize_;
+    cv::Size outputSize_;
+};
@@ -0,0 +1,164 @@
+// CsvReader.cpp
+#include "CsvReader.hpp"
+#include <charconv>
+#include <cstring>
+
+CsvReader::CsvReader(size_t bufferSize)
+    : buffer_(bufferSize < 64 ? 64 : bufferSize)
+{
+}
+
+bool CsvReader::open(const std::filesystem::path& path) {
+    close();
+
+    file_.open(path, std::ios::binary);
+    if (!file_.is_open()) {
+        return false;
+    }
+
+    std::string_view line;
+    if (!readLine(line)) {
+        close();
+        return false;
+    }
+
+    splitFields(line);
+    for (std::string_view name : fields_) {
+        header_.emplace_back(name);
+    }
+    fields_.clear();
+    return true;
+}
+
+void CsvReader::close() {
+    if (file_.is_open()) {
+        file_.close();
+    }
+    file_.clear();
+    begin_ = 0;
+    end_ = 0;
+    bufferOffset_ = 0;
+    eof_ = false;
+    header_.clear();
+    fields_.clear();
+    rowNumber_ = 0;
+    rowOffset_ = 0;
+}
+
+int CsvReader::columnIndex(std::string_view name) const {
+    for (size_t i = 0; i < header_.size(); ++i) {
+        if (header_[i] == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+bool CsvReader::next() {
+    std::string_view line;
+    while (readLine(line)) {
+        if (line.empty()) continue; // skip blank lines
+        splitFields(line);
+        rowNumber_++;
+        return true;
+    }
+    fields_.clear();
+    return false;
+}
+
+bool CsvReader::getDouble(size_t column, double& value) const {
+    std::string_view text = field(column);
+    if (text.empty()) return false;
+
+    const char* first = text.data();
+    const char* last = text.data() + text.size();
+    if (*first == '+') ++first;
+
+    auto result = std::from_chars(first, last, value);
+    return result.ec == std::errc() && result.ptr == last;
+}
+
+bool CsvReader::getInt64(size_t column, int64_t& value) const {
+    std::string_view text = field(column);
+    if (text.empty()) return false;
+
+    const char* first = text.data();
+    const char* last = text.data() + text.size();
+    if (*first == '+') ++first;
+
+    auto result = std::from_chars(first, last, value);
+    return result.ec == std::errc() && result.ptr == last;
+}
+
+bool CsvReader::readLine(std::string_view& line) {
+    size_t searchFrom = begin_;
+
+    while (true) {
+        const char* data = buffer_.data();
+        const void* newline = std::memchr(data + searchFrom, '\n', end_ - searchFrom);
+
+        if (newline != nullptr) {
+            size_t lineEnd = static_cast<const char*>(newline) - data;
+            rowOffset_ = bufferOffset_ + begin_;
+            line = std::string_view(data + begin_, lineEnd - begin_);
+            begin_ = lineEnd + 1;
+            break;
+        }
+
+        if (eof_) {
+            if (begin_ == end_) return false;
+            // Last row without trailing newline
+            rowOffset_ = bufferOffset_ + begin_;
+            line = std::string_view(data + begin_, end_ - begin_);
+            begin_ = end_;
+            break;
+        }
+
+        searchFrom = end_;
+        size_t consumed = begin_;
+        if (!fillBuffer()) {
+            eof_ = true;
+        }
+        searchFrom -= consumed;
+    }
+
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    return true;
+}
+
+bool CsvReader::fillBuffer() {
+    // Move the unread tail to the front, grow only if a single row fills the whole buffer
+    size_t pending = end_ - begin_;
+    if (begin_ > 0) {
+        std::memmove(buffer_.data(), buffer_.data() + begin_, pending);
+        bufferOffset_ += begin_;
+        begin_ = 0;
+        end_ = pending;
+    }
+    if (end_ == buffer_.size()) {
+        buffer_.resize(buffer_.size() * 2);
+    }
+
+    file_.read(buffer_.data() + end_, static_cast<std::streamsize>(buffer_.size() - end_));
+    std::streamsize count = file_.gcount();
+    end_ += static_cast<size_t>(count);
+    return count > 0;
+}
+
+void CsvReader::splitFields(std::string_view line) {
+    fields_.clear();
+
+    const char* cursor = line.data();
+    const char* last = line.data() + line.size();
+    while (true) {
+        const char* comma = static_cast<const char*>(std::memchr(cursor, ',', last - cursor));
+        if (comma == nullptr) {
+            fields_.emplace_back(cursor, last - cursor);
+            break;
+        }
+        fields_.emplace_back(cursor, comma - cursor);
+        cursor = comma + 1;
+    }
+}
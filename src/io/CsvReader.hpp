@@ -0,0 +1,120 @@
+// CsvReader.hpp
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Streaming reader for comma separated log exports (PX4 ULog -> CSV)
+ *
+ * Reads the file through one large buffer and splits rows in place:
+ * fields are string_views into the buffer and numbers are parsed with
+ * std::from_chars, so reading a row performs no heap allocation once the
+ * buffers reached their steady-state size. Column indices are resolved once
+ * from the header. Quoted fields are not supported (PX4 exports contain none).
+ */
+class CsvReader {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param bufferSize Initial read buffer size in bytes (grows if a single row does not fit)
+     */
+    explicit CsvReader(size_t bufferSize = 1 << 20);
+
+    /**
+     * @brief Opens a file and reads its header row
+     *
+     * @param path CSV file path
+     * @return true if the file was opened and the header was read
+     */
+    bool open(const std::filesystem::path& path);
+
+    /**
+     * @brief Closes the file
+     */
+    void close();
+
+    bool isOpen() const { return file_.is_open(); }
+
+    /**
+     * @brief Column names read from the header row
+     */
+    const std::vector<std::string>& getHeader() const { return header_; }
+
+    /**
+     * @brief Resolves a column name to its index
+     *
+     * @param name Column name
+     * @return Column index or -1 if the column does not exist
+     */
+    int columnIndex(std::string_view name) const;
+
+    /**
+     * @brief Advances to the next data row
+     *
+     * @return false at end of file
+     */
+    bool next();
+
+    /**
+     * @brief Number of data rows read so far
+     */
+    uint64_t getRowNumber() const { return rowNumber_; }
+
+    /**
+     * @brief Byte offset of the current row from the beginning of the file
+     */
+    uint64_t getRowOffset() const { return rowOffset_; }
+
+    size_t fieldCount() const { return fields_.size(); }
+
+    /**
+     * @brief Raw field of the current row (valid until the next call to next())
+     *
+     * @param column Column index
+     * @return Field contents or an empty view if the row is shorter
+     */
+    std::string_view field(size_t column) const {
+        return column < fields_.size() ? fields_[column] : std::string_view();
+    }
+
+    /**
+     * @brief Parses a field of the current row as floating point number
+     *
+     * @param column Column index
+     * @param value Parsed value
+     * @return true if the whole field is a valid number
+     */
+    bool getDouble(size_t column, double& value) const;
+
+    /**
+     * @brief Parses a field of the current row as integer
+     *
+     * @param column Column index
+     * @param value Parsed value
+     * @return true if the whole field is a valid integer
+     */
+    bool getInt64(size_t column, int64_t& value) const;
+
+private:
+    bool readLine(std::string_view& line);
+    bool fillBuffer();
+    void splitFields(std::string_view line);
+
+    std::ifstream file_;
+    std::vector<char> buffer_;
+    size_t begin_ = 0;         // first unread byte in buffer_
+    size_t end_ = 0;           // one past the last valid byte in buffer_
+    uint64_t bufferOffset_ = 0; // file offset of buffer_[0]
+    bool eof_ = false;
+
+    std::vector<std::string> header_;
+    std::vector<std::string_view> fields_;
+    uint64_t rowNumber_ = 0;
+    uint64_t rowOffset_ = 0;
+};
@@ -0,0 +1,200 @@
+// InputIndex.cpp
+#include "InputIndex.hpp"
+#include "CsvReader.hpp"
+#include "Timestamp.hpp"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+// Sidecar layout: magic, file size, file time, row count, offsets[rows], timestamps[rows]
+const char INDEX_MAGIC[8] = {'F', 'L', 'I', 'D', 'X', '0', '0', '1'};
+
+bool fileStamp(const std::filesystem::path& path, uint64_t& size, int64_t& time) {
+    std::error_code ec;
+    size = std::filesystem::file_size(path, ec);
+    if (ec) return false;
+    auto modified = std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+    time = static_cast<int64_t>(modified.time_since_epoch().count());
+    return true;
+}
+
+template <typename T>
+bool readValue(std::ifstream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+template <typename T>
+void writeValue(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+} // namespace
+
+bool InputIndex::build(const std::filesystem::path& csvFile, std::string_view timestampColumn) {
+    clear();
+
+    CsvReader reader;
+    if (!fileStamp(csvFile, fileSize_, fileTime_) || !reader.open(csvFile)) {
+        return false;
+    }
+
+    const int column = reader.columnIndex(timestampColumn);
+    if (column < 0) {
+        clear();
+        return false;
+    }
+
+    // Rough pre-size from the file size avoids most reallocations on long logs
+    const size_t expectedRows = static_cast<size_t>(fileSize_ / 64);
+    rowOffsets_.reserve(expectedRows);
+    timestamps_.reserve(expectedRows);
+
+    while (reader.next()) {
+        int64_t timestamp;
+        if (!parseTimestampUs(reader.field(column), timestamp)) {
+            timestamp = INVALID_TIMESTAMP;
+        }
+        rowOffsets_.push_back(reader.getRowOffset());
+        timestamps_.push_back(timestamp);
+    }
+
+    computeStatistics();
+    return true;
+}
+
+bool InputIndex::load(const std::filesystem::path& indexFile, const std::filesystem::path& csvFile) {
+    clear();
+
+    uint64_t csvSize;
+    int64_t csvTime;
+    if (!fileStamp(csvFile, csvSize, csvTime)) {
+        return false;
+    }
+
+    std::ifstream in(indexFile, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+
+    char magic[sizeof(INDEX_MAGIC)];
+    uint64_t rows = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0 ||
+        !readValue(in, fileSize_) || !readValue(in, fileTime_) || !readValue(in, rows)) {
+        clear();
+        return false;
+    }
+
+    // Stale sidecar: the CSV file changed since the index was written
+    if (fileSize_ != csvSize || fileTime_ != csvTime || rows > csvSize) {
+        clear();
+        return false;
+    }
+
+    rowOffsets_.resize(rows);
+    timestamps_.resize(rows);
+    if (!in.read(reinterpret_cast<char*>(rowOffsets_.data()), rows * sizeof(uint64_t)) ||
+        !in.read(reinterpret_cast<char*>(timestamps_.data()), rows * sizeof(int64_t))) {
+        clear();
+        return false;
+    }
+
+    computeStatistics();
+    fromSidecar_ = true;
+    return true;
+}
+
+bool InputIndex::save(const std::filesystem::path& indexFile) const {
+    // Write to a temporary file first so an interrupted run never leaves a truncated sidecar
+    std::filesystem::path tmpFile = indexFile;
+    tmpFile += ".tmp";
+
+    std::ofstream out(tmpFile, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    const uint64_t rows = rowOffsets_.size();
+    out.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    writeValue(out, fileSize_);
+    writeValue(out, fileTime_);
+    writeValue(out, rows);
+    out.write(reinterpret_cast<const char*>(rowOffsets_.data()), rows * sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(timestamps_.data()), rows * sizeof(int64_t));
+    out.close();
+
+    std::error_code ec;
+    if (!out) {
+        std::filesystem::remove(tmpFile, ec);
+        return false;
+    }
+    std::filesystem::rename(tmpFile, indexFile, ec);
+    return !ec;
+}
+
+bool InputIndex::loadOrBuild(const std::filesystem::path& csvFile, const std::filesystem::path& indexFile,
+                             std::string_view timestampColumn) {
+    if (!indexFile.empty() && load(indexFile, csvFile)) {
+        return true;
+    }
+
+    if (!build(csvFile, timestampColumn)) {
+        return false;
+    }
+
+    // A sidecar that cannot be written is not an error, the index is simply rebuilt next time
+    if (!indexFile.empty()) {
+        save(indexFile);
+    }
+    return true;
+}
+
+void InputIndex::clear() {
+    rowOffsets_.clear();
+    timestamps_.clear();
+    fileSize_ = 0;
+    fileTime_ = 0;
+    firstTimestampUs_ = INVALID_TIMESTAMP;
+    lastTimestampUs_ = INVALID_TIMESTAMP;
+    meanRate_ = 0.0;
+    minInterval_ = 0.0;
+    maxInterval_ = 0.0;
+    intervalJitter_ = 0.0;
+    fromSidecar_ = false;
+}
+
+void InputIndex::computeStatistics() {
+    // Single pass over consecutive valid timestamps (Welford's running variance)
+    int64_t previous = INVALID_TIMESTAMP;
+    size_t intervals = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+
+    for (int64_t timestamp : timestamps_) {
+        if (timestamp == INVALID_TIMESTAMP) continue;
+
+        if (firstTimestampUs_ == INVALID_TIMESTAMP) {
+            firstTimestampUs_ = timestamp;
+        }
+        lastTimestampUs_ = timestamp;
+
+        if (previous != INVALID_TIMESTAMP) {
+            double interval = (timestamp - previous) * 1e-6;
+            if (intervals == 0 || interval < minInterval_) minInterval_ = interval;
+            if (intervals == 0 || interval > maxInterval_) maxInterval_ = interval;
+
+            ++intervals;
+            double delta = interval - mean;
+            mean += delta / intervals;
+            m2 += delta * (interval - mean);
+        }
+        previous = timestamp;
+    }
+
+    if (intervals > 0 && mean > 0.0) {
+        meanRate_ = 1.0 / mean;
+        intervalJitter_ = std::sqrt(m2 / intervals);
+    }
+}
@@ -0,0 +1,125 @@
+// InputIndex.hpp
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Row index of a CSV log built in a single pass
+ *
+ * Holds the byte offset and the parsed timestamp of every data row together
+ * with sample-rate statistics, so the file does not have to be re-scanned to
+ * count lines or estimate its rate. The index can be persisted as a sidecar
+ * file; a sidecar is only reused while the size and modification time of the
+ * CSV file still match.
+ */
+class InputIndex {
+public:
+    /**
+     * @brief Timestamp stored for rows whose timestamp field could not be parsed
+     */
+    static constexpr int64_t INVALID_TIMESTAMP = INT64_MIN;
+
+    /**
+     * @brief Builds the index by reading the CSV file once
+     *
+     * @param csvFile CSV file path
+     * @param timestampColumn Name of the timestamp column
+     * @return true if the file and the timestamp column were found
+     */
+    bool build(const std::filesystem::path& csvFile, std::string_view timestampColumn = "timestamp");
+
+    /**
+     * @brief Loads a sidecar index of the given CSV file
+     *
+     * @param indexFile Sidecar index path
+     * @param csvFile CSV file the index must describe
+     * @return false if the sidecar is missing, corrupt or stale
+     */
+    bool load(const std::filesystem::path& indexFile, const std::filesystem::path& csvFile);
+
+    /**
+     * @brief Writes the index as a sidecar file
+     *
+     * @param indexFile Sidecar index path
+     * @return true on success
+     */
+    bool save(const std::filesystem::path& indexFile) const;
+
+    /**
+     * @brief Loads the sidecar if it is up to date, otherwise builds the index and writes the sidecar
+     *
+     * @param csvFile CSV file path
+     * @param indexFile Sidecar index path (empty = do not persist)
+     * @param timestampColumn Name of the timestamp column
+     * @return true if the index is available
+     */
+    bool loadOrBuild(const std::filesystem::path& csvFile, const std::filesystem::path& indexFile,
+                     std::string_view timestampColumn = "timestamp");
+
+    /**
+     * @brief Number of data rows (blank lines excluded)
+     */
+    size_t getRowCount() const { return rowOffsets_.size(); }
+
+    /**
+     * @brief Byte offset of a data row from the beginning of the file
+     */
+    uint64_t getRowOffset(size_t row) const { return rowOffsets_[row]; }
+
+    /**
+     * @brief Timestamp of a data row in microseconds (INVALID_TIMESTAMP if malformed)
+     */
+    int64_t getTimestampUs(size_t row) const { return timestamps_[row]; }
+
+    /**
+     * @brief First valid timestamp in microseconds (INVALID_TIMESTAMP if none)
+     */
+    int64_t getFirstTimestampUs() const { return firstTimestampUs_; }
+
+    /**
+     * @brief Last valid timestamp in microseconds (INVALID_TIMESTAMP if none)
+     */
+    int64_t getLastTimestampUs() const { return lastTimestampUs_; }
+
+    /**
+     * @brief Mean sample rate in Hz over the whole file (0 if unknown)
+     */
+    double getMeanRate() const { return meanRate_; }
+
+    /**
+     * @brief Smallest and largest interval between consecutive samples in seconds
+     */
+    double getMinInterval() const { return minInterval_; }
+    double getMaxInterval() const { return maxInterval_; }
+
+    /**
+     * @brief Standard deviation of the sample interval in seconds
+     */
+    double getIntervalJitter() const { return intervalJitter_; }
+
+    /**
+     * @brief Whether the index was read from an up-to-date sidecar
+     */
+    bool isFromSidecar() const { return fromSidecar_; }
+
+private:
+    void clear();
+    void computeStatistics();
+
+    std::vector<uint64_t> rowOffsets_;
+    std::vector<int64_t> timestamps_;
+    uint64_t fileSize_ = 0;
+    int64_t fileTime_ = 0;
+
+    int64_t firstTimestampUs_ = INVALID_TIMESTAMP;
+    int64_t lastTimestampUs_ = INVALID_TIMESTAMP;
+    double meanRate_ = 0.0;
+    double minInterval_ = 0.0;
+    double maxInterval_ = 0.0;
+    double intervalJitter_ = 0.0;
+    bool fromSidecar_ = false;
+};
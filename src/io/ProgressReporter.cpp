@@ -0,0 +1,200 @@
+// ProgressReporter.cpp
+#include "ProgressReporter.hpp"
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+// Serializes whole reports of all reporters writing to the same stream (batch mode)
+std::mutex outputMutex;
+
+const int TTY_LINES = 12;
+
+// JSON has no NaN/Inf literals
+struct JsonNumber {
+    double value;
+};
+
+std::ostream& operator<<(std::ostream& out, JsonNumber number) {
+    if (std::isfinite(number.value)) {
+        out << number.value;
+    } else {
+        out << "null";
+    }
+    return out;
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+} // namespace
+
+bool parseProgressMode(const std::string& name, ProgressMode& mode) {
+    if (name == "none") {
+        mode = ProgressMode::NONE;
+    } else if (name == "tty") {
+        mode = ProgressMode::TTY;
+    } else if (name == "jsonl") {
+        mode = ProgressMode::JSONL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+ProgressReporter::ProgressReporter(ProgressMode mode, double rateHz, std::ostream& out, std::string label)
+    : mode_(mode)
+    , period_(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(1.0 / (rateHz > 0.0 ? rateHz : 5.0))))
+    , out_(out)
+    , label_(std::move(label))
+{
+}
+
+ProgressReporter::~ProgressReporter() {
+    {
+        std::lock_guard<std::mutex> lock(stopMutex_);
+        stop_ = true;
+    }
+    stopCondition_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void ProgressReporter::start() {
+    if (mode_ == ProgressMode::NONE || thread_.joinable()) {
+        return;
+    }
+
+    startTime_ = std::chrono::steady_clock::now();
+    lastReportTime_ = startTime_;
+    thread_ = std::thread(&ProgressReporter::run, this);
+}
+
+void ProgressReporter::publish(const ProgressSnapshot& snapshot) {
+    std::unique_lock<std::mutex> lock(snapshotMutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return;
+    }
+    snapshot_ = snapshot;
+    ++version_;
+}
+
+void ProgressReporter::finish(const ProgressSnapshot& snapshot) {
+    if (!thread_.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stopMutex_);
+        stop_ = true;
+    }
+    stopCondition_.notify_all();
+    thread_.join();
+
+    report(snapshot, true);
+}
+
+void ProgressReporter::run() {
+    std::unique_lock<std::mutex> stopLock(stopMutex_);
+    while (!stopCondition_.wait_for(stopLock, period_, [this]() { return stop_; })) {
+        ProgressSnapshot snapshot;
+        uint64_t version;
+        {
+            std::lock_guard<std::mutex> lock(snapshotMutex_);
+            snapshot = snapshot_;
+            version = version_;
+        }
+
+        // Nothing new since the last report
+        if (version == reportedVersion_) continue;
+        reportedVersion_ = version;
+
+        stopLock.unlock();
+        report(snapshot, false);
+        stopLock.lock();
+    }
+}
+
+void ProgressReporter::report(const ProgressSnapshot& snapshot, bool final) {
+    auto now = std::chrono::steady_clock::now();
+    double interval = std::chrono::duration<double>(now - lastReportTime_).count();
+    double elapsed = std::chrono::duration<double>(now - startTime_).count();
+
+    // Final report shows the average rate, periodic reports the rate since the previous report
+    double frameRate = 0.0;
+    if (final) {
+        frameRate = elapsed > 0.0 ? snapshot.frame / elapsed : 0.0;
+    } else if (interval > 0.0) {
+        frameRate = (snapshot.frame - lastFrame_) / interval;
+    }
+    lastFrame_ = snapshot.frame;
+    lastReportTime_ = now;
+
+    if (mode_ == ProgressMode::TTY) {
+        writeTty(snapshot, frameRate);
+    } else if (mode_ == ProgressMode::JSONL) {
+        writeJson(snapshot, frameRate, elapsed, final);
+    }
+}
+
+void ProgressReporter::writeTty(const ProgressSnapshot& snapshot, double frameRate) {
+    std::ostringstream block;
+    block << std::fixed << std::setprecision(10);
+
+    // Redraw the previous block in place
+    if (ttyLines_ > 0) {
+        block << "\033[" << ttyLines_ << "A";
+    }
+    block << "\033[2K      frame:           " << snapshot.frame << " / " << snapshot.totalFrames << "\n"
+          << "\033[2K      rate:            " << std::setprecision(1) << frameRate << " fps\n" << std::setprecision(10)
+          << "\033[2K      log_sample:      " << snapshot.logSamples << " / " << snapshot.logTotal << "\n"
+          << "\033[2K      gps_sample:      " << snapshot.gpsSamples << " / " << snapshot.gpsTotal << "\n"
+          << "\033[2K      speed:           " << snapshot.speed << " m/s\n"
+          << "\033[2K      altitude:        " << snapshot.altitude << " m\n"
+          << "\033[2K      heading:         " << snapshot.heading << " deg\n"
+          << "\033[2K      dr_lat:          " << snapshot.drLat << "\n"
+          << "\033[2K      dr_lon:          " << snapshot.drLon << "\n"
+          << "\033[2K      gps_lat:         " << snapshot.gpsLat << "\n"
+          << "\033[2K      gps_lon:         " << snapshot.gpsLon << "\n"
+          << "\033[2K      gps_vel:         " << snapshot.gpsVel << " m/s\n";
+    ttyLines_ = TTY_LINES;
+
+    std::lock_guard<std::mutex> lock(outputMutex);
+    out_ << block.str() << std::flush;
+}
+
+void ProgressReporter::writeJson(const ProgressSnapshot& snapshot, double frameRate, double elapsed, bool final) {
+    std::ostringstream line;
+    line << std::setprecision(10)
+         << "{\"label\":\"" << jsonEscape(label_) << "\""
+         << ",\"final\":" << (final ? "true" : "false")
+         << ",\"elapsed_s\":" << JsonNumber{elapsed}
+         << ",\"frame\":" << snapshot.frame
+         << ",\"total_frames\":" << snapshot.totalFrames
+         << ",\"frames_per_s\":" << JsonNumber{frameRate}
+         << ",\"log_sample\":" << snapshot.logSamples
+         << ",\"log_total\":" << snapshot.logTotal
+         << ",\"gps_sample\":" << snapshot.gpsSamples
+         << ",\"gps_total\":" << snapshot.gpsTotal
+         << ",\"speed_mps\":" << JsonNumber{snapshot.speed}
+         << ",\"altitude\":" << JsonNumber{snapshot.altitude}
+         << ",\"heading\":" << JsonNumber{snapshot.heading}
+         << ",\"dr_lat\":" << JsonNumber{snapshot.drLat}
+         << ",\"dr_lon\":" << JsonNumber{snapshot.drLon}
+         << ",\"gps_lat\":" << JsonNumber{snapshot.gpsLat}
+         << ",\"gps_lon\":" << JsonNumber{snapshot.gpsLon}
+         << ",\"gps_vel\":" << JsonNumber{snapshot.gpsVel}
+         << "}\n";
+
+    std::lock_guard<std::mutex> lock(outputMutex);
+    out_ << line.str() << std::flush;
+}
@@ -0,0 +1,118 @@
+// ProgressReporter.hpp
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Progress output mode
+ */
+enum class ProgressMode {
+    NONE = 0,   // no progress output
+    TTY,        // in-place ANSI block for interactive terminals
+    JSONL       // one JSON object per line for headless runs
+};
+
+/**
+ * @brief Parses a progress mode name ("none", "tty", "jsonl")
+ *
+ * @param name Mode name
+ * @param mode Parsed mode
+ * @return true if the name is known
+ */
+bool parseProgressMode(const std::string& name, ProgressMode& mode);
+
+/**
+ * @brief Processing state shown by the progress reporter
+ */
+struct ProgressSnapshot {
+    int64_t frame = 0;
+    int64_t totalFrames = 0;
+    int64_t logSamples = 0;
+    int64_t logTotal = 0;
+    int64_t gpsSamples = 0;
+    int64_t gpsTotal = 0;
+    double speed = 0.0;
+    double altitude = 0.0;
+    double heading = 0.0;
+    double drLat = 0.0;
+    double drLon = 0.0;
+    double gpsLat = 0.0;
+    double gpsLon = 0.0;
+    double gpsVel = 0.0;
+};
+
+/**
+ * @brief Reports processing progress from its own thread at a fixed rate
+ *
+ * The processing loop only publishes snapshots; publishing never waits (if the
+ * reporter is copying the previous snapshot the update is dropped, the next
+ * frame replaces it anyway). Terminal or stream I/O happens on the reporter
+ * thread, at most rateHz times per second.
+ */
+class ProgressReporter {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param mode Output mode (NONE starts no thread)
+     * @param rateHz Reports per second
+     * @param out Output stream (JSON lines of concurrent reporters are not interleaved)
+     * @param label Name written with every JSON line (e.g. the flight name)
+     */
+    ProgressReporter(ProgressMode mode, double rateHz, std::ostream& out, std::string label = "");
+
+    ~ProgressReporter();
+
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+    /**
+     * @brief Starts the reporter thread
+     */
+    void start();
+
+    /**
+     * @brief Publishes the current state without blocking
+     */
+    void publish(const ProgressSnapshot& snapshot);
+
+    /**
+     * @brief Stops the reporter thread after writing the final state
+     *
+     * @param snapshot Final state (always reported)
+     */
+    void finish(const ProgressSnapshot& snapshot);
+
+private:
+    void run();
+    void report(const ProgressSnapshot& snapshot, bool final);
+    void writeTty(const ProgressSnapshot& snapshot, double frameRate);
+    void writeJson(const ProgressSnapshot& snapshot, double frameRate, double elapsed, bool final);
+
+    ProgressMode mode_;
+    std::chrono::steady_clock::duration period_;
+    std::ostream& out_;
+    std::string label_;
+
+    std::mutex snapshotMutex_;
+    ProgressSnapshot snapshot_;
+    uint64_t version_ = 0;
+
+    std::mutex stopMutex_;
+    std::condition_variable stopCondition_;
+    bool stop_ = false;
+    std::thread thread_;
+
+    // Reporter thread state
+    uint64_t reportedVersion_ = 0;
+    int ttyLines_ = 0;
+    int64_t lastFrame_ = 0;
+    std::chrono::steady_clock::time_point startTime_;
+    std::chrono::steady_clock::time_point lastReportTime_;
+};
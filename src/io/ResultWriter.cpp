@@ -0,0 +1,295 @@
+// ResultWriter.cpp
+#include "ResultWriter.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+
+// Records are stored in the host byte order, which the format fixes to little-endian
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "The binary result format is little-endian; big-endian hosts are not supported"
+#endif
+
+namespace {
+
+const char RESULT_MAGIC[8] = {'F', 'L', 'O', 'R', 'E', 'S', '0', '1'};
+const size_t HEADER_ALIGNMENT = 64;
+const int CSV_PRECISION = 10;
+
+// Longest formatted value: sign, 20 integer digits, point, CSV_PRECISION decimals
+const size_t MAX_VALUE_CHARS = 64;
+
+template <typename T>
+void appendBytes(std::vector<char>& out, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(value));
+}
+
+template <typename T>
+T readBytes(const char* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+bool parseResultFormat(const std::string& name, ResultFormat& format) {
+    if (name == "csv") {
+        format = ResultFormat::CSV;
+    } else if (name == "bin") {
+        format = ResultFormat::BINARY;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* resultFormatExtension(ResultFormat format) {
+    return format == ResultFormat::BINARY ? ".bin" : ".csv";
+}
+
+ResultWriter::ResultWriter(size_t bufferSize)
+    : buffer_(bufferSize < 4096 ? 4096 : bufferSize)
+{
+}
+
+ResultWriter::~ResultWriter() {
+    close();
+}
+
+bool ResultWriter::open(const std::filesystem::path& path, ResultFormat format, const std::vector<ResultColumn>& columns) {
+    close();
+
+    if (columns.empty()) {
+        return false;
+    }
+
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        return false;
+    }
+
+    format_ = format;
+    columns_ = columns;
+    used_ = 0;
+    failed_ = false;
+
+    std::vector<char> header;
+    if (format_ == ResultFormat::CSV) {
+        for (size_t i = 0; i < columns_.size(); ++i) {
+            if (i > 0) header.push_back(',');
+            header.insert(header.end(), columns_[i].name.begin(), columns_[i].name.end());
+        }
+        header.push_back('\n');
+    } else {
+        header.insert(header.end(), RESULT_MAGIC, RESULT_MAGIC + sizeof(RESULT_MAGIC));
+        appendBytes(header, uint32_t(0)); // header size, patched below
+        appendBytes(header, static_cast<uint32_t>(columns_.size() * sizeof(double)));
+        appendBytes(header, static_cast<uint32_t>(columns_.size()));
+        appendBytes(header, uint32_t(0));
+        for (const ResultColumn& column : columns_) {
+            const size_t length = std::min<size_t>(column.name.size(), 255);
+            header.push_back(static_cast<char>(column.type));
+            header.push_back(static_cast<char>(length));
+            header.insert(header.end(), column.name.begin(), column.name.begin() + length);
+        }
+        header.resize((header.size() + HEADER_ALIGNMENT - 1) / HEADER_ALIGNMENT * HEADER_ALIGNMENT, '\0');
+
+        const uint32_t headerSize = static_cast<uint32_t>(header.size());
+        std::memcpy(header.data() + sizeof(RESULT_MAGIC), &headerSize, sizeof(headerSize));
+    }
+
+    file_.write(header.data(), static_cast<std::streamsize>(header.size()));
+    if (!file_) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool ResultWriter::close() {
+    if (!file_.is_open()) {
+        return !failed_;
+    }
+
+    flush();
+    file_.close();
+    if (!file_) {
+        failed_ = true;
+    }
+    file_.clear();
+    return !failed_;
+}
+
+bool ResultWriter::write(const double* values) {
+    if (!file_.is_open() || failed_) {
+        return false;
+    }
+
+    const size_t maxRecordSize = columns_.size() * MAX_VALUE_CHARS;
+    if (buffer_.size() - used_ < maxRecordSize) {
+        if (!flush()) return false;
+        if (buffer_.size() < maxRecordSize) buffer_.resize(maxRecordSize);
+    }
+
+    if (format_ == ResultFormat::BINARY) {
+        char* out = buffer_.data() + used_;
+        for (size_t i = 0; i < columns_.size(); ++i, out += sizeof(double)) {
+            if (columns_[i].type == ResultColumn::Type::INT64) {
+                const int64_t integer = static_cast<int64_t>(values[i]);
+                std::memcpy(out, &integer, sizeof(integer));
+            } else {
+                std::memcpy(out, &values[i], sizeof(double));
+            }
+        }
+        used_ += columns_.size() * sizeof(double);
+    } else {
+        for (size_t i = 0; i < columns_.size(); ++i) {
+            if (i > 0) buffer_[used_++] = ',';
+            appendCsvValue(values[i], columns_[i].type);
+        }
+        buffer_[used_++] = '\n';
+    }
+    return true;
+}
+
+void ResultWriter::appendCsvValue(double value, ResultColumn::Type type) {
+    char* begin = buffer_.data() + used_;
+    char* end = begin + MAX_VALUE_CHARS - 1;
+    std::to_chars_result result;
+    if (type == ResultColumn::Type::INT64) {
+        result = std::to_chars(begin, end, static_cast<int64_t>(value));
+    } else {
+        result = std::to_chars(begin, end, value, std::chars_format::fixed, CSV_PRECISION);
+    }
+
+    // Values too large for the fixed notation (never expected in navigation results)
+    if (result.ec != std::errc()) {
+        result = std::to_chars(begin, end, value);
+    }
+    used_ += static_cast<size_t>(result.ptr - begin);
+}
+
+bool ResultWriter::flush() {
+    if (used_ > 0) {
+        file_.write(buffer_.data(), static_cast<std::streamsize>(used_));
+        used_ = 0;
+        if (!file_) failed_ = true;
+    }
+    return !failed_;
+}
+
+bool ResultReader::open(const std::filesystem::path& path) {
+    close();
+
+    file_.open(path, std::ios::binary);
+    if (!file_.is_open()) {
+        return false;
+    }
+
+    char fixed[sizeof(RESULT_MAGIC) + 4 * sizeof(uint32_t)];
+    if (!file_.read(fixed, sizeof(fixed)) || std::memcmp(fixed, RESULT_MAGIC, sizeof(RESULT_MAGIC)) != 0) {
+        close();
+        return false;
+    }
+
+    const uint32_t headerSize = readBytes<uint32_t>(fixed + 8);
+    const uint32_t recordSize = readBytes<uint32_t>(fixed + 12);
+    const uint32_t columnCount = readBytes<uint32_t>(fixed + 16);
+    if (columnCount == 0 || recordSize != columnCount * sizeof(double) || headerSize < sizeof(fixed)) {
+        close();
+        return false;
+    }
+
+    std::vector<char> header(headerSize - sizeof(fixed));
+    if (!file_.read(header.data(), static_cast<std::streamsize>(header.size()))) {
+        close();
+        return false;
+    }
+
+    size_t pos = 0;
+    for (uint32_t i = 0; i < columnCount; ++i) {
+        if (pos + 2 > header.size()) {
+            close();
+            return false;
+        }
+        ResultColumn column;
+        column.type = static_cast<ResultColumn::Type>(header[pos]);
+        const size_t length = static_cast<unsigned char>(header[pos + 1]);
+        pos += 2;
+        if (pos + length > header.size()) {
+            close();
+            return false;
+        }
+        column.name.assign(header.data() + pos, length);
+        pos += length;
+        columns_.push_back(column);
+    }
+
+    std::error_code ec;
+    const uint64_t fileSize = std::filesystem::file_size(path, ec);
+    if (ec || fileSize < headerSize) {
+        close();
+        return false;
+    }
+    const uint64_t partial = (fileSize - headerSize) % recordSize;
+    if (partial != 0) {
+        std::cerr << "Warning: " << path << " ends in a partial record (" << partial << " bytes), ignored." << std::endl;
+    }
+    recordCount_ = (fileSize - headerSize) / recordSize;
+    record_.resize(recordSize);
+    return true;
+}
+
+void ResultReader::close() {
+    if (file_.is_open()) {
+        file_.close();
+    }
+    file_.clear();
+    columns_.clear();
+    record_.clear();
+    recordCount_ = 0;
+    recordsRead_ = 0;
+}
+
+bool ResultReader::next(std::vector<double>& values) {
+    if (!file_.is_open() || recordsRead_ >= recordCount_) {
+        return false;
+    }
+    if (!file_.read(record_.data(), static_cast<std::streamsize>(record_.size()))) {
+        return false;
+    }
+    ++recordsRead_;
+
+    values.resize(columns_.size());
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        const char* data = record_.data() + i * sizeof(double);
+        if (columns_[i].type == ResultColumn::Type::INT64) {
+            values[i] = static_cast<double>(readBytes<int64_t>(data));
+        } else {
+            values[i] = readBytes<double>(data);
+        }
+    }
+    return true;
+}
+
+bool convertResultsToCsv(const std::filesystem::path& binaryFile, const std::filesystem::path& csvFile) {
+    ResultReader reader;
+    if (!reader.open(binaryFile)) {
+        return false;
+    }
+
+    ResultWriter writer;
+    if (!writer.open(csvFile, ResultFormat::CSV, reader.getColumns())) {
+        return false;
+    }
+
+    std::vector<double> values;
+    while (reader.next(values)) {
+        if (!writer.write(values.data())) {
+            return false;
+        }
+    }
+    return writer.close();
+}
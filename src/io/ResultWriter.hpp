@@ -0,0 +1,165 @@
+// ResultWriter.hpp
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Output format of the navigation results
+ */
+enum class ResultFormat {
+    CSV = 0,
+    BINARY
+};
+
+/**
+ * @brief Parses a result format name ("csv", "bin")
+ *
+ * @param name Format name
+ * @param format Parsed format
+ * @return true if the name is known
+ */
+bool parseResultFormat(const std::string& name, ResultFormat& format);
+
+/**
+ * @brief File extension of a result format, including the dot
+ */
+const char* resultFormatExtension(ResultFormat format);
+
+/**
+ * @brief Column of a result file
+ */
+struct ResultColumn {
+    enum class Type : uint8_t {
+        INT64 = 0,
+        FLOAT64 = 1
+    };
+
+    std::string name;
+    Type type = Type::FLOAT64;
+};
+
+/**
+ * @brief Buffered writer for per-frame navigation results
+ *
+ * CSV rows are formatted with std::to_chars (10 decimals, as before).
+ * The binary format stores fixed-width records in native byte order, which is
+ * little-endian on all supported hosts (big-endian builds fail), after a small
+ * self-describing header, so files can be memory-mapped and read as an array:
+ *
+ *  - char[8]  magic "FLORES01"
+ *  - uint32   header size in bytes (offset of the first record, multiple of 64)
+ *  - uint32   record size in bytes (8 per column)
+ *  - uint32   column count
+ *  - uint32   reserved (0)
+ *  - per column: uint8 type (0 = int64, 1 = float64), uint8 name length, name bytes
+ *  - zero padding up to the header size
+ *  - records: one int64/float64 per column, in column order
+ *
+ * The record count is (file size - header size) / record size; a trailing
+ * partial record is ignored with a warning.
+ */
+class ResultWriter {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param bufferSize Output buffer size in bytes
+     */
+    explicit ResultWriter(size_t bufferSize = 1 << 16);
+
+    ~ResultWriter();
+
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+
+    /**
+     * @brief Creates the output file and writes its header
+     *
+     * @param path Output file path
+     * @param format Output format
+     * @param columns Result schema
+     * @return true on success
+     */
+    bool open(const std::filesystem::path& path, ResultFormat format, const std::vector<ResultColumn>& columns);
+
+    /**
+     * @brief Flushes the buffer and closes the file
+     *
+     * @return false if any write failed
+     */
+    bool close();
+
+    bool isOpen() const { return file_.is_open(); }
+
+    /**
+     * @brief Appends one record
+     *
+     * @param values One value per column (INT64 columns are truncated to integers)
+     * @return false if the file is not open or a write failed
+     */
+    bool write(const double* values);
+
+    const std::vector<ResultColumn>& getColumns() const { return columns_; }
+
+private:
+    void appendCsvValue(double value, ResultColumn::Type type);
+    bool flush();
+
+    std::ofstream file_;
+    ResultFormat format_ = ResultFormat::CSV;
+    std::vector<ResultColumn> columns_;
+    std::vector<char> buffer_;
+    size_t used_ = 0;
+    bool failed_ = false;
+};
+
+/**
+ * @brief Sequential reader of binary result files
+ */
+class ResultReader {
+public:
+    /**
+     * @brief Opens a binary result file and reads its header
+     *
+     * @param path Result file path
+     * @return false if the file is missing or not a result file
+     */
+    bool open(const std::filesystem::path& path);
+
+    void close();
+
+    const std::vector<ResultColumn>& getColumns() const { return columns_; }
+
+    /**
+     * @brief Number of complete records in the file
+     */
+    uint64_t getRecordCount() const { return recordCount_; }
+
+    /**
+     * @brief Reads the next record
+     *
+     * @param values One value per column
+     * @return false at the end of the file
+     */
+    bool next(std::vector<double>& values);
+
+private:
+    std::ifstream file_;
+    std::vector<ResultColumn> columns_;
+    std::vector<char> record_;
+    uint64_t recordCount_ = 0;
+    uint64_t recordsRead_ = 0;
+};
+
+/**
+ * @brief Converts a binary result file to CSV
+ *
+ * @param binaryFile Binary result file
+ * @param csvFile Output CSV file
+ * @return true on success
+ */
+bool convertResultsToCsv(const std::filesystem::path& binaryFile, const std::filesystem::path& csvFile);
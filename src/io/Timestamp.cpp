@@ -0,0 +1,67 @@
+// Timestamp.cpp
+#include "Timestamp.hpp"
+#include <charconv>
+
+namespace {
+
+// Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant's days_from_civil)
+int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(year - era * 400);
+    const unsigned doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+bool parseFixed(std::string_view text, size_t pos, size_t length, int& value) {
+    if (pos + length > text.size()) return false;
+    value = 0;
+    for (size_t i = pos; i < pos + length; ++i) {
+        if (text[i] < '0' || text[i] > '9') return false;
+        value = value * 10 + (text[i] - '0');
+    }
+    return true;
+}
+
+} // namespace
+
+bool parseTimestampUs(std::string_view text, int64_t& microseconds) {
+    if (text.empty()) return false;
+
+    // Raw PX4 timestamp in microseconds
+    if (text.size() < 10 || text[4] != '-') {
+        auto result = std::from_chars(text.data(), text.data() + text.size(), microseconds);
+        return result.ec == std::errc() && result.ptr == text.data() + text.size();
+    }
+
+    // YYYY-MM-DD HH:MM:SS[.fraction]
+    int year, month, day, hour, minute, second;
+    if (!parseFixed(text, 0, 4, year) || text[4] != '-' ||
+        !parseFixed(text, 5, 2, month) || text.size() < 19 || text[7] != '-' ||
+        !parseFixed(text, 8, 2, day) || (text[10] != ' ' && text[10] != 'T') ||
+        !parseFixed(text, 11, 2, hour) || text[13] != ':' ||
+        !parseFixed(text, 14, 2, minute) || text[16] != ':' ||
+        !parseFixed(text, 17, 2, second)) {
+        return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) {
+        return false;
+    }
+
+    int64_t fractionUs = 0;
+    if (text.size() > 19) {
+        if (text[19] != '.' || text.size() == 20) return false;
+        int64_t scale = 100000;
+        for (size_t i = 20; i < text.size(); ++i) {
+            if (text[i] < '0' || text[i] > '9') return false;
+            fractionUs += (text[i] - '0') * scale; // digits beyond microseconds are truncated
+            scale /= 10;
+        }
+    }
+
+    int64_t seconds = daysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day)) * 86400
+                    + hour * 3600 + minute * 60 + second;
+    microseconds = seconds * 1000000 + fractionUs;
+    return true;
+}
@@ -0,0 +1,18 @@
+// Timestamp.hpp
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Parses a log timestamp to microseconds since the Unix epoch
+ *
+ * Accepts raw PX4 timestamps (integer microseconds) as well as the
+ * "YYYY-MM-DD HH:MM:SS[.ffffff]" form written by scripts/convert_timestamp.py
+ * (a 'T' separator and up to nanosecond fractions are also accepted; time is UTC).
+ *
+ * @param text Timestamp field
+ * @param microseconds Parsed timestamp in microseconds
+ * @return true if the field is a valid timestamp
+ */
+bool parseTimestampUs(std::string_view text, int64_t& microseconds);
@@ -1,11 +1,38 @@
 #include "DeadReckoningProcessor.hpp"
 
+bool parseDeadReckoningIntegration(const std::string& name, DeadReckoningIntegration& integration) {
+    if (name == "great-circle") {
+        integration = DeadReckoningIntegration::GREAT_CIRCLE;
+    } else if (name == "enu") {
+        integration = DeadReckoningIntegration::LOCAL_ENU;
+    } else {
+        return false;
+    }
+    return true;
+}
+
 DeadReckoningProcessor::DeadReckoningProcessor() {}
 
 GPSData DeadReckoningProcessor::getGPSData() const {
+    if (!gpsDataValid_) {
+        frame_.fromENU(Vector3D(east_, north_, 0.0), gpsData_);
+        // The tangent plane rises above the ellipsoid away from the anchor; the altitude stays the one of the fix
+        gpsData_.setAltitude(frame_.getReference().getAltitude());
+        gpsDataValid_ = true;
+    }
     return gpsData_;
 }
 
+void DeadReckoningProcessor::reanchor() {
+    frame_ = LocalFrame(getGPSData());
+    east_ = 0.0;
+    north_ = 0.0;
+
+    // Local north east of the anchor is turned towards the pole by east * tan(lat) / N
+    const double lat = frame_.getReference().getLatitude() * M_PI / 180.0;
+    convergence_ = std::tan(lat) / frame_.getPrimeVerticalRadius();
+}
+
 bool DeadReckoningProcessor::update(GPSData initialGpsData, double altitude, double heading, double speed, double dt) {
     const double R = 6378137.0;
     const double HEADING_CORRECTION_DEG = 90.0;
@@ -17,10 +44,30 @@ bool DeadReckoningProcessor::update(GPSData initialGpsData, double altitude, dou
         }
 
         gpsData_ = initialGpsData;
+        gpsDataValid_ = true;
+        reanchor();
         lastAltitude_ = altitude;
         lastHeading_ = heading;
         lastSpeed_ = speed;
         hasPrevData_ = true;
+    } else if (integration_ == DeadReckoningIntegration::LOCAL_ENU) {
+        if (altitude <= 0.0) return false;
+
+        // Heading is counterclockwise from east of the local north, the anchor frame's north is
+        // turned against it by the meridian convergence
+        double distance = speed * dt;
+        double direction = heading + east_ * convergence_;
+        east_ += distance * std::cos(direction);
+        north_ += distance * std::sin(direction);
+        gpsDataValid_ = false;
+
+        if (east_ * east_ + north_ * north_ > REANCHOR_DISTANCE_M * REANCHOR_DISTANCE_M) {
+            reanchor();
+        }
+
+        lastAltitude_ = altitude;
+        lastHeading_ = heading;
+        lastSpeed_ = speed;
     } else {
         if (altitude <= 0.0) return false;
 
@@ -49,4 +96,3 @@ bool DeadReckoningProcessor::update(GPSData initialGpsData, double altitude, dou
 
     return true;
 }
-
@@ -1,10 +1,37 @@
 #pragma once
+#include <string>
 #include "IDRProcessor.hpp"
+#include "../sensors/LocalFrame.hpp"
+
+/**
+ * @brief Position integration used by DeadReckoningProcessor
+ */
+enum class DeadReckoningIntegration {
+    GREAT_CIRCLE = 0,   // spherical destination formula on every step
+    LOCAL_ENU           // planar steps in an ENU frame anchored at the initial fix
+};
+
+/**
+ * @brief Parses an integration name ("great-circle", "enu")
+ *
+ * @param name Integration name
+ * @param integration Parsed integration
+ * @return true if the name is known
+ */
+bool parseDeadReckoningIntegration(const std::string& name, DeadReckoningIntegration& integration);
 
 class DeadReckoningProcessor : public IDRProcessor {
 public:
+    // LOCAL_ENU moves the anchor to the current position once it is this far away, so the
+    // tangent plane stays close to the ellipsoid and its north close to the local north
+    static constexpr double REANCHOR_DISTANCE_M = 1000.0;
+
     DeadReckoningProcessor();
 
+    /**
+     * @brief Current position; LOCAL_ENU converts the ENU position to geodetic coordinates here,
+     *        at most once per update
+     */
     GPSData getGPSData() const override;
 
     double getLastAltitude() const { return lastAltitude_; }
@@ -12,12 +39,30 @@ public:
     double getLastSpeed() const { return lastSpeed_; }
     bool hasPreviousData() const { return hasPrevData_; }
 
+    /**
+     * @brief Selects the position integration (call before the first update)
+     */
+    void setIntegration(DeadReckoningIntegration integration) { integration_ = integration; }
+
+    DeadReckoningIntegration getIntegration() const { return integration_; }
+
     bool update(GPSData initialGpsData, double altitude, double heading, double speed, double dt) override;
 
 private:
-    GPSData gpsData_;
+    void reanchor();
+
+    DeadReckoningIntegration integration_ = DeadReckoningIntegration::LOCAL_ENU;
+
+    // LOCAL_ENU state: frame anchored at the last anchor fix and the position in it in meters
+    LocalFrame frame_;
+    double east_ = 0.0;
+    double north_ = 0.0;
+    double convergence_ = 0.0;  // Meridian convergence per meter east of the anchor, rad/m
+
+    mutable GPSData gpsData_;
+    mutable bool gpsDataValid_ = true;  // gpsData_ matches the ENU position
     double lastAltitude_ = 0.0;
     double lastHeading_ = 0.0;
     double lastSpeed_ = 0.0;
     bool hasPrevData_ = false;
-};
\ No newline at end of file
+};
@@ -8,4 +8,11 @@ public:
     virtual GPSData getGPSData() const = 0;
 
     virtual bool update(GPSData initialGpsData, double altitude, double heading, double speed, double dt) = 0;
+
+    /**
+     * @brief Corrects the position with an absolute fix (after the first update)
+     *
+     * @return true if the fix was used; open-loop processors ignore fixes
+     */
+    virtual bool correct(const GPSData& fix) { (void)fix; return false; }
 };
\ No newline at end of file
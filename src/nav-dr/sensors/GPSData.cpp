@@ -1,5 +1,6 @@
 // GPSData.cpp
 #include "GPSData.hpp"
+#include "LocalFrame.hpp"
 #include <cmath>
 
 
@@ -110,65 +111,8 @@ Vector3D GPSData::toENU(double referenceLatitude, double referenceLongitude, dou
 }
 
 void GPSData::fromENU(const Vector3D& enuPosition, double referenceLatitude, double referenceLongitude, double referenceAltitude) {
-    // Constants for coordinate conversion
-    const double DEG_TO_RAD = M_PI / 180.0;
-    const double RAD_TO_DEG = 180.0 / M_PI;
-    
-    // WGS84 ellipsoid parameters
-    const double a = 6378137.0;          // Semi-major axis length [m]
-    const double f = 1.0 / 298.257223563; // Flattening
-    const double e2 = 2.0 * f - f * f;    // First eccentricity squared
-    
-    // Convert reference point to radians
-    double refLat = referenceLatitude * DEG_TO_RAD;
-    double refLon = referenceLongitude * DEG_TO_RAD;
-    
-    // Extract ENU coordinates
-    double east = enuPosition.getX();
-    double north = enuPosition.getY();
-    double up = enuPosition.getZ();
-    
-    // Calculate prime vertical radius of curvature for reference point
-    double N_ref = a / sqrt(1.0 - e2 * sin(refLat) * sin(refLat));
-    
-    // ECEF coordinates of reference point
-    double x_ref = (N_ref + referenceAltitude) * cos(refLat) * cos(refLon);
-    double y_ref = (N_ref + referenceAltitude) * cos(refLat) * sin(refLon);
-    double z_ref = (N_ref * (1.0 - e2) + referenceAltitude) * sin(refLat);
-    
-    // ENU to ECEF transformation matrix
-    double dX = -sin(refLon) * east - sin(refLat) * cos(refLon) * north + cos(refLat) * cos(refLon) * up;
-    double dY = cos(refLon) * east - sin(refLat) * sin(refLon) * north + cos(refLat) * sin(refLon) * up;
-    double dZ = cos(refLat) * north + sin(refLat) * up;
-    
-    // Calculate ECEF coordinates of the target point
-    double x = x_ref + dX;
-    double y = y_ref + dY;
-    double z = z_ref + dZ;
-    
-    // Convert ECEF to geodetic coordinates
-    double p = sqrt(x*x + y*y);
-    
-    // Iterative calculation of latitude
-    double lat = atan2(z, p * (1.0 - e2));
-    for (int i = 0; i < 5; ++i) {
-        double N = a / sqrt(1.0 - e2 * sin(lat) * sin(lat));
-        double h = p / cos(lat) - N;
-        double latNew = atan2(z, p * (1.0 - e2 * N / (N + h)));
-        
-        if (fabs(lat - latNew) < 1e-9) break;
-        lat = latNew;
-    }
-    
-    // Calculate longitude and altitude
-    double lon = atan2(y, x);
-    double N = a / sqrt(1.0 - e2 * sin(lat) * sin(lat));
-    double h = p / cos(lat) - N;
-    
-    // Convert back to degrees
-    latitude = lat * RAD_TO_DEG;
-    longitude = lon * RAD_TO_DEG;
-    altitude = h;
+    // Closed-form ECEF -> geodetic conversion; convert many points against one reference with LocalFrame
+    LocalFrame(referenceLatitude, referenceLongitude, referenceAltitude).fromENU(enuPosition, *this);
 }
 
 double GPSData::distanceTo(const GPSData& other) const {
@@ -0,0 +1,233 @@
+// GeodeticBatch.cpp
+#include "GeodeticBatch.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+// WGS84 ellipsoid
+const double WGS84_A = 6378137.0;
+const double WGS84_F = 1.0 / 298.257223563;
+const double WGS84_E2 = 2.0 * WGS84_F - WGS84_F * WGS84_F;
+
+const double PI = 3.14159265358979323846;
+const double DEG_TO_RAD = PI / 180.0;
+const double RAD_TO_DEG = 180.0 / PI;
+
+// Points per block of the two-pass ECEF -> geodetic loops (stays in L1)
+const size_t BLOCK_SIZE = 256;
+
+// Adding 1.5 * 2^52 rounds to an integer and leaves it in the low mantissa bits
+const double ROUND_MAGIC = 6755399441055744.0;
+
+inline uint64_t toBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline double fromBits(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// sin and cos for |x| < 2^20 (fdlibm kernels on [-pi/4, pi/4], quadrant selected with bit operations)
+inline void sinCos(double x, double& sine, double& cosine) {
+    const double TWO_OVER_PI = 6.36619772367581382433e-01;
+    const double PIO2_HI = 1.57079632673412561417e+00;
+    const double PIO2_LO = 6.07710050650619224932e-11;
+
+    const double S1 = -1.66666666666666324348e-01;
+    const double S2 = 8.33333333332248946124e-03;
+    const double S3 = -1.98412698298579493134e-04;
+    const double S4 = 2.75573137070700676789e-06;
+    const double S5 = -2.50507602534068634195e-08;
+    const double S6 = 1.58969099521155010221e-10;
+
+    const double C1 = 4.16666666666666019037e-02;
+    const double C2 = -1.38888888888741095749e-03;
+    const double C3 = 2.48015872894767294178e-05;
+    const double C4 = -2.75573143513906633035e-07;
+    const double C5 = 2.08757232129817482790e-09;
+    const double C6 = -1.13596475577881948265e-11;
+
+    const double shifted = x * TWO_OVER_PI + ROUND_MAGIC;
+    const uint64_t quadrant = toBits(shifted);
+    const double q = shifted - ROUND_MAGIC;
+
+    const double r = (x - q * PIO2_HI) - q * PIO2_LO;
+    const double r2 = r * r;
+    const double s = r + r * r2 * (S1 + r2 * (S2 + r2 * (S3 + r2 * (S4 + r2 * (S5 + r2 * S6)))));
+    const double c = 1.0 - 0.5 * r2 + r2 * r2 * (C1 + r2 * (C2 + r2 * (C3 + r2 * (C4 + r2 * (C5 + r2 * C6)))));
+
+    // Odd quadrants swap sin and cos, quadrants 2-3 negate sin, 1-2 negate cos
+    const uint64_t swap = 0 - (quadrant & 1);
+    const uint64_t sBits = toBits(s);
+    const uint64_t cBits = toBits(c);
+    sine = fromBits(((sBits & ~swap) | (cBits & swap)) ^ ((quadrant & 2) << 62));
+    cosine = fromBits(((cBits & ~swap) | (sBits & swap)) ^ (((quadrant + 1) & 2) << 62));
+}
+
+// atan(num / den) for 0 <= num <= den (Cephes atan rational approximation)
+inline double atanRatio(double num, double den) {
+    const double P0 = -8.750608600031904122785e-01;
+    const double P1 = -1.615753718733365076637e+01;
+    const double P2 = -7.500855792314704667340e+01;
+    const double P3 = -1.228866684490136173410e+02;
+    const double P4 = -6.485021904942025371773e+01;
+    const double Q0 = 2.485846490142306297962e+01;
+    const double Q1 = 1.650270098316988542046e+02;
+    const double Q2 = 4.328810604912902668951e+02;
+    const double Q3 = 4.853903996359136964868e+02;
+    const double Q4 = 1.945506571482613964425e+02;
+
+    // Both sides of every selection are computed, so the compiler can turn them into blends.
+    // Above 0.66 use atan(t) = pi/4 + atan((t - 1) / (t + 1))
+    const bool upper = num > 0.66 * den;
+    const double uNum = upper ? num - den : num;
+    const double uDen = upper ? num + den : den;
+    const double u = uNum / (uDen > 0.0 ? uDen : 1.0);
+    const double z = u * u;
+    const double p = (((P0 * z + P1) * z + P2) * z + P3) * z + P4;
+    const double q = ((((z + Q0) * z + Q1) * z + Q2) * z + Q3) * z + Q4;
+    const double offset = upper ? 0.25 * PI : 0.0;
+    return u + u * z * p / q + offset;
+}
+
+// atan2 with branch-free octant reduction
+inline double atan2Kernel(double y, double x) {
+    const double ax = std::fabs(x);
+    const double ay = std::fabs(y);
+    const bool steep = ay > ax;
+    const double octant = atanRatio(steep ? ax : ay, steep ? ay : ax);
+
+    const double complement = 0.5 * PI - octant;
+    const double quadrant = steep ? complement : octant;
+    const double mirrored = PI - quadrant;
+    const double angle = x < 0.0 ? mirrored : quadrant;
+    return std::copysign(angle, y);
+}
+
+// Vermeille's closed-form ECEF -> geodetic latitude and altitude from the distance to the axis p and z.
+// The cube root of c = 1 + x, x < 0.1 for any point farther than ~100 km from the Earth's center, is one
+// Halley step from its second-order Taylor expansion (error 5 x^3 / 81 before the step, below 1 ulp after).
+inline void vermeille(double p, double z, double& halfTangent, double& altitude) {
+    const double E4 = WGS84_E2 * WGS84_E2;
+    const double INV_A2 = 1.0 / (WGS84_A * WGS84_A);
+    const double pp = p * p * INV_A2;
+    const double q = (1.0 - WGS84_E2) * z * z * INV_A2;
+    const double r = (pp + q - E4) * (1.0 / 6.0);
+    const double s = E4 * pp * q / (4.0 * r * r * r);
+
+    const double x = s + std::sqrt(s * (2.0 + s));
+    const double c = 1.0 + x;
+    const double t0 = 1.0 + x * (1.0 / 3.0 - x * (1.0 / 9.0));
+    const double t03 = t0 * t0 * t0;
+
+    // t = num / den after the Halley step, t + 1 / t = (num^2 + den^2) / (num den)
+    const double num = t0 * (t03 + 2.0 * c);
+    const double den = 2.0 * t03 + c;
+    const double u = r * (1.0 + (num * num + den * den) / (num * den));
+    const double v = std::sqrt(u * u + E4 * q);
+    const double w = WGS84_E2 * (u + v - q) / (2.0 * v);
+    const double k = std::sqrt(u + v + w * w) - w;
+
+    // d = k p / (k + e2), h = (k + e2 - 1) / k * sqrt(d^2 + z^2) with one division
+    const double inverse = 1.0 / (k * (k + WGS84_E2));
+    const double d = k * k * p * inverse;
+    const double dz = std::sqrt(d * d + z * z);
+
+    // lat = 2 atan(halfTangent), |halfTangent| <= 1
+    halfTangent = z / (d + dz);
+    altitude = (k + WGS84_E2 - 1.0) * (k + WGS84_E2) * inverse * dz;
+}
+
+// Reference point of a conversion, ECEF coordinates in the frame rotated by the reference longitude
+struct Reference {
+    Reference(double latitude, double longitude, double altitude) {
+        const double lat = latitude * DEG_TO_RAD;
+        sinLat = std::sin(lat);
+        cosLat = std::cos(lat);
+        lon = longitude;
+        const double N = WGS84_A / std::sqrt(1.0 - WGS84_E2 * sinLat * sinLat);
+        x = (N + altitude) * cosLat;
+        z = (N * (1.0 - WGS84_E2) + altitude) * sinLat;
+    }
+
+    double sinLat;
+    double cosLat;
+    double lon;
+    double x;
+    double z;
+};
+
+} // namespace
+
+void geodeticToENUBatch(const double* __restrict latitude, const double* __restrict longitude,
+                        const double* __restrict altitude, size_t count,
+                        double referenceLatitude, double referenceLongitude, double referenceAltitude,
+                        double* __restrict east, double* __restrict north, double* __restrict up) {
+    const Reference ref(referenceLatitude, referenceLongitude, referenceAltitude);
+
+    for (size_t i = 0; i < count; ++i) {
+        double sinLat, cosLat, sinLon, cosLon;
+        sinCos(latitude[i] * DEG_TO_RAD, sinLat, cosLat);
+        sinCos((longitude[i] - ref.lon) * DEG_TO_RAD, sinLon, cosLon);
+
+        const double N = WGS84_A / std::sqrt(1.0 - WGS84_E2 * sinLat * sinLat);
+        const double horizontal = (N + altitude[i]) * cosLat;
+        const double dx = horizontal * cosLon - ref.x;
+        const double dz = (N * (1.0 - WGS84_E2) + altitude[i]) * sinLat - ref.z;
+
+        east[i] = horizontal * sinLon;
+        north[i] = ref.cosLat * dz - ref.sinLat * dx;
+        up[i] = ref.cosLat * dx + ref.sinLat * dz;
+    }
+}
+
+void enuToGeodeticBatch(const double* __restrict east, const double* __restrict north,
+                        const double* __restrict up, size_t count,
+                        double referenceLatitude, double referenceLongitude, double referenceAltitude,
+                        double* __restrict latitude, double* __restrict longitude, double* __restrict altitude) {
+    const Reference ref(referenceLatitude, referenceLongitude, referenceAltitude);
+
+    // Two passes per block split the long chain of divisions and square roots, so that independent
+    // points overlap in the pipeline; the first pass leaves tan(lat / 2) in latitude
+    for (size_t begin = 0; begin < count; begin += BLOCK_SIZE) {
+        const size_t end = begin + BLOCK_SIZE < count ? begin + BLOCK_SIZE : count;
+
+        for (size_t i = begin; i < end; ++i) {
+            const double x = ref.x + ref.cosLat * up[i] - ref.sinLat * north[i];
+            const double y = east[i];
+            const double z = ref.z + ref.cosLat * north[i] + ref.sinLat * up[i];
+            vermeille(std::sqrt(x * x + y * y), z, latitude[i], altitude[i]);
+        }
+
+        for (size_t i = begin; i < end; ++i) {
+            const double x = ref.x + ref.cosLat * up[i] - ref.sinLat * north[i];
+            const double lon = ref.lon + atan2Kernel(east[i], x) * RAD_TO_DEG;
+            const double wrap = lon > 180.0 ? -360.0 : (lon < -180.0 ? 360.0 : 0.0);
+            longitude[i] = lon + wrap;
+            latitude[i] = 2.0 * RAD_TO_DEG * std::copysign(atanRatio(std::fabs(latitude[i]), 1.0), latitude[i]);
+        }
+    }
+}
+
+void ecefToGeodeticBatch(const double* __restrict x, const double* __restrict y, const double* __restrict z,
+                         size_t count,
+                         double* __restrict latitude, double* __restrict longitude, double* __restrict altitude) {
+    for (size_t begin = 0; begin < count; begin += BLOCK_SIZE) {
+        const size_t end = begin + BLOCK_SIZE < count ? begin + BLOCK_SIZE : count;
+
+        for (size_t i = begin; i < end; ++i) {
+            vermeille(std::sqrt(x[i] * x[i] + y[i] * y[i]), z[i], latitude[i], altitude[i]);
+        }
+
+        for (size_t i = begin; i < end; ++i) {
+            longitude[i] = atan2Kernel(y[i], x[i]) * RAD_TO_DEG;
+            latitude[i] = 2.0 * RAD_TO_DEG * std::copysign(atanRatio(std::fabs(latitude[i]), 1.0), latitude[i]);
+        }
+    }
+}
@@ -0,0 +1,114 @@
+// LocalFrame.cpp
+#include "LocalFrame.hpp"
+#include "GeodeticBatch.hpp"
+#include <cmath>
+
+namespace {
+
+// WGS84 ellipsoid
+const double WGS84_A = 6378137.0;
+const double WGS84_F = 1.0 / 298.257223563;
+const double WGS84_E2 = 2.0 * WGS84_F - WGS84_F * WGS84_F;
+
+const double DEG_TO_RAD = M_PI / 180.0;
+
+} // namespace
+
+LocalFrame::LocalFrame()
+    : LocalFrame(0.0, 0.0, 0.0)
+{
+}
+
+LocalFrame::LocalFrame(double referenceLatitude, double referenceLongitude, double referenceAltitude)
+    : LocalFrame(GPSData(referenceLatitude, referenceLongitude, referenceAltitude))
+{
+}
+
+LocalFrame::LocalFrame(const GPSData& reference)
+    : reference_(reference)
+{
+    const double lat = reference.getLatitude() * DEG_TO_RAD;
+    const double lon = reference.getLongitude() * DEG_TO_RAD;
+    const double sinLat = std::sin(lat);
+    const double cosLat = std::cos(lat);
+    const double sinLon = std::sin(lon);
+    const double cosLon = std::cos(lon);
+
+    primeVerticalRadius_ = WGS84_A / std::sqrt(1.0 - WGS84_E2 * sinLat * sinLat);
+    origin_ = geodeticToECEF(reference.getLatitude(), reference.getLongitude(), reference.getAltitude());
+
+    rotation_[0][0] = -sinLon;
+    rotation_[0][1] = cosLon;
+    rotation_[0][2] = 0.0;
+    rotation_[1][0] = -sinLat * cosLon;
+    rotation_[1][1] = -sinLat * sinLon;
+    rotation_[1][2] = cosLat;
+    rotation_[2][0] = cosLat * cosLon;
+    rotation_[2][1] = cosLat * sinLon;
+    rotation_[2][2] = sinLat;
+}
+
+Vector3D LocalFrame::toENU(double latitude, double longitude, double altitude) const {
+    return ecefToENU(geodeticToECEF(latitude, longitude, altitude));
+}
+
+void LocalFrame::fromENU(const Vector3D& enuPosition, GPSData& position) const {
+    double latitude, longitude, altitude;
+    ecefToGeodetic(enuToECEF(enuPosition), latitude, longitude, altitude);
+    position.setLatitude(latitude);
+    position.setLongitude(longitude);
+    position.setAltitude(altitude);
+}
+
+Vector3D LocalFrame::ecefToENU(const Vector3D& ecefPosition) const {
+    const double dx = ecefPosition.getX() - origin_.getX();
+    const double dy = ecefPosition.getY() - origin_.getY();
+    const double dz = ecefPosition.getZ() - origin_.getZ();
+    return Vector3D(rotation_[0][0] * dx + rotation_[0][1] * dy,
+                    rotation_[1][0] * dx + rotation_[1][1] * dy + rotation_[1][2] * dz,
+                    rotation_[2][0] * dx + rotation_[2][1] * dy + rotation_[2][2] * dz);
+}
+
+Vector3D LocalFrame::enuToECEF(const Vector3D& enuPosition) const {
+    // The rotation is orthonormal, ENU -> ECEF is its transpose
+    const double east = enuPosition.getX();
+    const double north = enuPosition.getY();
+    const double up = enuPosition.getZ();
+    return Vector3D(origin_.getX() + rotation_[0][0] * east + rotation_[1][0] * north + rotation_[2][0] * up,
+                    origin_.getY() + rotation_[0][1] * east + rotation_[1][1] * north + rotation_[2][1] * up,
+                    origin_.getZ() + rotation_[1][2] * north + rotation_[2][2] * up);
+}
+
+void LocalFrame::toENU(const double* latitude, const double* longitude, const double* altitude, size_t count,
+                       double* east, double* north, double* up) const {
+    geodeticToENUBatch(latitude, longitude, altitude, count,
+                       reference_.getLatitude(), reference_.getLongitude(), reference_.getAltitude(),
+                       east, north, up);
+}
+
+void LocalFrame::fromENU(const double* east, const double* north, const double* up, size_t count,
+                         double* latitude, double* longitude, double* altitude) const {
+    enuToGeodeticBatch(east, north, up, count,
+                       reference_.getLatitude(), reference_.getLongitude(), reference_.getAltitude(),
+                       latitude, longitude, altitude);
+}
+
+Vector3D LocalFrame::geodeticToECEF(double latitude, double longitude, double altitude) {
+    const double lat = latitude * DEG_TO_RAD;
+    const double lon = longitude * DEG_TO_RAD;
+    const double sinLat = std::sin(lat);
+    const double cosLat = std::cos(lat);
+    const double N = WGS84_A / std::sqrt(1.0 - WGS84_E2 * sinLat * sinLat);
+    const double horizontal = (N + altitude) * cosLat;
+    return Vector3D(horizontal * std::cos(lon),
+                    horizontal * std::sin(lon),
+                    (N * (1.0 - WGS84_E2) + altitude) * sinLat);
+}
+
+void LocalFrame::ecefToGeodetic(const Vector3D& ecefPosition, double& latitude, double& longitude, double& altitude) {
+    // Single point through the closed-form batch kernel, so scalar and batch results are identical
+    const double x = ecefPosition.getX();
+    const double y = ecefPosition.getY();
+    const double z = ecefPosition.getZ();
+    ecefToGeodeticBatch(&x, &y, &z, 1, &latitude, &longitude, &altitude);
+}
@@ -0,0 +1,134 @@
+// LocalFrame.hpp
+#pragma once
+
+#include <cstddef>
+#include "GPSData.hpp"
+
+/**
+ * @brief Local East-North-Up frame anchored at a reference position
+ *
+ * The reference point's ECEF coordinates, prime vertical radius and ECEF -> ENU
+ * rotation are computed once in the constructor, so each conversion only
+ * pays for the point itself (one sin/cos pair of latitude and longitude
+ * towards ENU; one closed-form ECEF -> geodetic step back). Use it instead of
+ * GPSData::toENU / GPSData::fromENU wherever many points share a reference.
+ *
+ * Conversions run in double precision (agreement with the long double
+ * GPSData::toENU within 1e-7 m for points within 1000 km of the reference).
+ */
+class LocalFrame {
+public:
+    /**
+     * @brief Frame at latitude, longitude and altitude 0
+     */
+    LocalFrame();
+
+    /**
+     * @brief Constructor
+     *
+     * @param reference Reference position (origin of the frame)
+     */
+    explicit LocalFrame(const GPSData& reference);
+
+    /**
+     * @brief Constructor
+     *
+     * @param referenceLatitude Reference latitude in degrees
+     * @param referenceLongitude Reference longitude in degrees
+     * @param referenceAltitude Reference altitude in meters
+     */
+    LocalFrame(double referenceLatitude, double referenceLongitude, double referenceAltitude);
+
+    const GPSData& getReference() const { return reference_; }
+
+    /**
+     * @brief ECEF coordinates of the reference point in meters
+     */
+    const Vector3D& getOrigin() const { return origin_; }
+
+    /**
+     * @brief Prime vertical radius of curvature N at the reference latitude in meters
+     */
+    double getPrimeVerticalRadius() const { return primeVerticalRadius_; }
+
+    /**
+     * @brief Element of the ECEF -> ENU rotation (rows: east, north, up)
+     */
+    double getRotation(int row, int col) const { return rotation_[row][col]; }
+
+    /**
+     * @brief Converts geodetic coordinates to ENU coordinates of this frame
+     *
+     * @param latitude Latitude in degrees
+     * @param longitude Longitude in degrees
+     * @param altitude Altitude in meters
+     * @return Position in ENU coordinates (East, North, Up) in meters
+     */
+    Vector3D toENU(double latitude, double longitude, double altitude) const;
+
+    /**
+     * @brief Converts a GPS position to ENU coordinates of this frame
+     */
+    Vector3D toENU(const GPSData& position) const {
+        return toENU(position.getLatitude(), position.getLongitude(), position.getAltitude());
+    }
+
+    /**
+     * @brief Converts ENU coordinates of this frame to geodetic coordinates
+     *
+     * @param enuPosition Position in ENU coordinates (East, North, Up)
+     * @param position Receives latitude, longitude and altitude (other fields are kept)
+     */
+    void fromENU(const Vector3D& enuPosition, GPSData& position) const;
+
+    /**
+     * @brief Converts ECEF coordinates to ENU coordinates of this frame
+     */
+    Vector3D ecefToENU(const Vector3D& ecefPosition) const;
+
+    /**
+     * @brief Converts ENU coordinates of this frame to ECEF coordinates
+     */
+    Vector3D enuToECEF(const Vector3D& enuPosition) const;
+
+    /**
+     * @brief Batch toENU on structure-of-arrays input (see geodeticToENUBatch)
+     */
+    void toENU(const double* latitude, const double* longitude, const double* altitude, size_t count,
+               double* east, double* north, double* up) const;
+
+    /**
+     * @brief Batch fromENU on structure-of-arrays input (see enuToGeodeticBatch)
+     */
+    void fromENU(const double* east, const double* north, const double* up, size_t count,
+                 double* latitude, double* longitude, double* altitude) const;
+
+    /**
+     * @brief Converts WGS84 geodetic coordinates to ECEF coordinates
+     *
+     * @param latitude Latitude in degrees
+     * @param longitude Longitude in degrees
+     * @param altitude Altitude in meters
+     * @return ECEF position in meters
+     */
+    static Vector3D geodeticToECEF(double latitude, double longitude, double altitude);
+
+    /**
+     * @brief Converts ECEF coordinates to WGS84 geodetic coordinates (Vermeille's closed form)
+     *
+     * Valid for points farther than ~100 km from the Earth's center (the cube root is a single
+     * Halley step); any position on or near the surface qualifies.
+     *
+     * @param ecefPosition ECEF position in meters
+     * @param latitude Latitude in degrees (output)
+     * @param longitude Longitude in degrees (output)
+     * @param altitude Altitude in meters (output)
+     */
+    static void ecefToGeodetic(const Vector3D& ecefPosition, double& latitude, double& longitude, double& altitude);
+
+private:
+    GPSData reference_;
+    Vector3D origin_;
+    double primeVerticalRadius_ = 0.0;
+    double rotation_[3][3] = {};
+};
@@ -0,0 +1,46 @@
+#include "dense_cpu.hpp"
+#include "utils.hpp"
+#include <opencv2/imgproc.hpp>
+
+bool CpuDenseFlowBackend::process(const cv::Mat& frame, int scaledHeight, FlowMeasurement& measurement) {
+    int scaledWidth = static_cast<int>(frame.cols * (scaledHeight / static_cast<float>(frame.rows)));
+    cv::Size scaledSize(scaledWidth, scaledHeight);
+
+    // Buffers keep their allocation as long as the size does not change
+    if (frame.size() == scaledSize)
+        frame.copyTo(currSmall_);
+    else
+        cv::resize(frame, currSmall_, scaledSize);
+
+    if (!hasPrev_) {
+        cv::swap(prevSmall_, currSmall_);
+        hasPrev_ = true;
+        return false;
+    }
+    if (prevSmall_.size() != currSmall_.size()) {
+        rescaleFrame(prevSmall_, currSmall_.size());
+    }
+
+    FlowMoments moments;
+    if (!sampling_.appliesTo(currSmall_.size())) {
+        computeFlow(prevSmall_, currSmall_, flow_, 0);
+        accumulateFlow(flow_, cv::Point(0, 0), currSmall_.size(), 1, cv::Mat(), moments, prevSmall_);
+    } else {
+        const cv::Rect frameRect(cv::Point(0, 0), currSmall_.size());
+        for (size_t i = 0; i < sampling_.regions.size(); ++i) {
+            const cv::Rect& region = sampling_.regions[i];
+            const int margin = sampling_.margin;
+            const cv::Rect area = cv::Rect(region.x - margin, region.y - margin,
+                                           region.width + 2 * margin, region.height + 2 * margin) & frameRect;
+
+            computeFlow(prevSmall_(area), currSmall_(area), flow_, static_cast<int>(i));
+            const cv::Rect inner(region.x - area.x, region.y - area.y, region.width, region.height);
+            accumulateFlow(flow_(inner), region.tl(), currSmall_.size(), sampling_.stride,
+                           sampling_.mask(region), moments, prevSmall_(region));
+        }
+    }
+    measurement = moments.toMeasurement();
+
+    cv::swap(prevSmall_, currSmall_);
+    return true;
+}
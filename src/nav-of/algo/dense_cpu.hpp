@@ -0,0 +1,33 @@
+#pragma once
+#include <opencv2/core.hpp>
+#include "../core/IFlowBackend.hpp"
+
+/**
+ * @brief Common state of the CPU dense flow backends
+ *
+ * Keeps a ping-pong pair of downscaled frames and the flow field between
+ * calls; derived classes only provide the flow computation itself. With a
+ * sampling set, flow is computed per region and the regions are reduced
+ * together, so pixels outside the regions cost nothing.
+ */
+class CpuDenseFlowBackend : public IFlowBackend {
+public:
+    bool process(const cv::Mat& frame, int scaledHeight, FlowMeasurement& measurement) override;
+
+    void reset() override { hasPrev_ = false; }
+
+protected:
+    /**
+     * @brief Computes the flow between two (sub)images
+     *
+     * @param region Index of the sampling region (0 for the whole frame), lets
+     *        backends keep per-region state between frames
+     */
+    virtual void computeFlow(const cv::Mat& prevSmall, const cv::Mat& currSmall, cv::Mat& flow, int region) = 0;
+
+private:
+    cv::Mat prevSmall_;
+    cv::Mat currSmall_;
+    cv::Mat flow_;
+    bool hasPrev_ = false;
+};
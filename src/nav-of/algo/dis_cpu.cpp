@@ -0,0 +1,10 @@
+#include "dis_cpu.hpp"
+
+// DIS splits its patch search into stripes processed with cv::parallel_for_
+// and keeps its pyramid buffers between calls
+DisCpuBackend::DisCpuBackend()
+    : dis_(cv::DISOpticalFlow::create(cv::DISOpticalFlow::PRESET_MEDIUM)) {}
+
+void DisCpuBackend::computeFlow(const cv::Mat& prevSmall, const cv::Mat& currSmall, cv::Mat& flow, int /*region*/) {
+    dis_->calc(prevSmall, currSmall, flow);
+}
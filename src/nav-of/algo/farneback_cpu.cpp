@@ -0,0 +1,9 @@
+#include "farneback_cpu.hpp"
+
+// Same parameters as the CUDA backend, so both report comparable magnitudes
+FarnebackCpuBackend::FarnebackCpuBackend()
+    : farneback_(cv::FarnebackOpticalFlow::create(5, 0.5, false, 13, 3, 5, 1.1, 0)) {}
+
+void FarnebackCpuBackend::computeFlow(const cv::Mat& prevSmall, const cv::Mat& currSmall, cv::Mat& flow, int /*region*/) {
+    farneback_->calc(prevSmall, currSmall, flow);
+}
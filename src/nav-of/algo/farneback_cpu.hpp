@@ -0,0 +1,16 @@
+#pragma once
+#include <opencv2/video.hpp>
+#include "dense_cpu.hpp"
+
+class FarnebackCpuBackend : public CpuDenseFlowBackend {
+public:
+    FarnebackCpuBackend();
+
+    const char* getName() const override { return "farneback-cpu"; }
+
+protected:
+    void computeFlow(const cv::Mat& prevSmall, const cv::Mat& currSmall, cv::Mat& flow, int region) override;
+
+private:
+    cv::Ptr<cv::FarnebackOpticalFlow> farneback_;
+};
@@ -1,50 +1,129 @@
 #include "farneback_gpu.hpp"
-#include <opencv2/cudaoptflow.hpp>
+#include <algorithm>
 #include <opencv2/cudaarithm.hpp>
-#include <opencv2/cudawarping.hpp>
-#include <opencv2/core/cuda.hpp>
-#include <cmath>
+#include <opencv2/imgproc.hpp>
 
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
+FarnebackGpuBackend::FarnebackGpuBackend()
+    : farneback_(cv::cuda::FarnebackOpticalFlow::create(5, 0.5, false, 13, 3, 5, 1.1, 0)) {}
 
-float computeFarnebackGpuMagnitude(const cv::Mat& prevFrame, const cv::Mat& currFrame, int scaledHeight) {
-    int scaledWidth = static_cast<int>(prevFrame.cols * (scaledHeight / static_cast<float>(prevFrame.rows)));
+void FarnebackGpuBackend::setSampling(const FlowSampling& sampling) {
+    IFlowBackend::setSampling(sampling);
+    reductionArea_ = cv::Rect();
+}
 
-    cv::Mat prevSmall, currSmall;
-    cv::resize(prevFrame, prevSmall, cv::Size(scaledWidth, scaledHeight));
-    cv::resize(currFrame, currSmall, cv::Size(scaledWidth, scaledHeight));
+void FarnebackGpuBackend::updateReduction(const cv::Rect& area, const cv::Size& frameSize, bool sampled) {
+    if (area == reductionArea_ && frameSize == reductionFrameSize_ && sampled == reductionSampled_) return;
 
-    cv::Mat prevGray, currGray;
-    if (prevSmall.channels() == 3)
-        cv::cvtColor(prevSmall, prevGray, cv::COLOR_BGR2GRAY);
-    else
-        prevGray = prevSmall;
+    const double cx = (frameSize.width - 1) * 0.5;
+    const double cy = (frameSize.height - 1) * 0.5;
+    const int stride = sampled ? std::max(sampling_.stride, 1) : 1;
+    cv::Mat basis(area.size(), CV_32FC2);
+    cv::Mat mask(area.size(), CV_8UC1);
+    positionMoments_ = FlowMoments();
+    for (int y = 0; y < area.height; ++y) {
+        cv::Vec2f* row = basis.ptr<cv::Vec2f>(y);
+        unsigned char* maskRow = mask.ptr<unsigned char>(y);
+        const int frameY = area.y + y;
+        const unsigned char* samplingRow = sampled ? sampling_.mask.ptr<unsigned char>(frameY) : nullptr;
+        for (int x = 0; x < area.width; ++x) {
+            const int frameX = area.x + x;
+            const double rx = frameX - cx;
+            const double ry = frameY - cy;
+            row[x] = cv::Vec2f(static_cast<float>(-ry), static_cast<float>(rx));
+
+            const bool used = !sampled
+                || (samplingRow[frameX] && frameX % stride == 0 && frameY % stride == 0);
+            maskRow[x] = used ? 255 : 0;
+            if (!used) continue;
+            positionMoments_.count += 1.0;
+            positionMoments_.sumRx += rx;
+            positionMoments_.sumRy += ry;
+            positionMoments_.sumR2 += rx * rx + ry * ry;
+        }
+    }
+    rotationBasisGpu_.upload(basis);
+    if (sampled) {
+        reductionMaskGpu_.upload(mask);
+    } else {
+        reductionMaskGpu_ = cv::cuda::GpuMat();
+    }
+
+    reductionArea_ = area;
+    reductionFrameSize_ = frameSize;
+    reductionSampled_ = sampled;
+}
+
+bool FarnebackGpuBackend::process(const cv::Mat& frame, int scaledHeight, FlowMeasurement& measurement) {
+    int scaledWidth = static_cast<int>(frame.cols * (scaledHeight / static_cast<float>(frame.rows)));
+    cv::Size scaledSize(scaledWidth, scaledHeight);
 
-    if (currSmall.channels() == 3)
-        cv::cvtColor(currSmall, currGray, cv::COLOR_BGR2GRAY);
+    // Host and device buffers are allocated on the first frame and reused afterwards
+    if (frame.size() == scaledSize)
+        frame.copyTo(currSmall_);
     else
-        currGray = currSmall;
+        cv::resize(frame, currSmall_, scaledSize);
+
+    currGpu_.upload(currSmall_, stream_);
+
+    if (!hasPrev_) {
+        prevGpu_.swap(currGpu_);
+        cv::swap(prevSmall_, currSmall_);
+        stream_.waitForCompletion();
+        hasPrev_ = true;
+        return false;
+    }
+    if (prevGpu_.size() != currGpu_.size()) {
+        // The host copy of the previous frame is rescaled, no device resize needed
+        rescaleFrame(prevSmall_, currSmall_.size());
+        prevGpu_.upload(prevSmall_, stream_);
+    }
+
+    const cv::Size frameSize = currSmall_.size();
+    const bool sampled = sampling_.appliesTo(frameSize);
+    cv::Rect area(cv::Point(0, 0), frameSize);
+    if (sampled) {
+        cv::Rect bounds;
+        for (const cv::Rect& region : sampling_.regions) {
+            const int margin = sampling_.margin;
+            bounds |= cv::Rect(region.x - margin, region.y - margin,
+                               region.width + 2 * margin, region.height + 2 * margin);
+        }
+        area &= bounds;
+    }
+    updateReduction(area, frameSize, sampled);
 
-    cv::cuda::GpuMat d_prev(prevGray);
-    cv::cuda::GpuMat d_curr(currGray);
+    farneback_->calc(prevGpu_(area), currGpu_(area), flowGpu_, stream_);
 
-    auto fb = cv::cuda::FarnebackOpticalFlow::create(
-        5, 0.5, false, 13, 3, 5, 1.1, 0
-    );
+    cv::cuda::split(flowGpu_, flowChannels_, stream_);
+    cv::cuda::magnitude(flowChannels_[0], flowChannels_[1], magnitudeGpu_, stream_);
+    cv::cuda::calcSum(magnitudeGpu_, sumGpu_, reductionMaskGpu_, stream_);
 
-    cv::cuda::GpuMat flowGpu;
-    fb->calc(d_prev, d_curr, flowGpu);
+    // Mean flow vector and rotation moments (same reduction as accumulateFlow(), without downloading the field)
+    cv::cuda::calcSum(flowGpu_, flowSumGpu_, reductionMaskGpu_, stream_);
+    cv::cuda::multiply(flowGpu_, rotationBasisGpu_, productGpu_, 1.0, -1, stream_);
+    cv::cuda::calcSum(productGpu_, crossSumGpu_, reductionMaskGpu_, stream_);
+    cv::cuda::calcSqrSum(flowGpu_, squareSumGpu_, reductionMaskGpu_, stream_);
 
-    std::vector<cv::cuda::GpuMat> flowChannels(2);
-    cv::cuda::split(flowGpu, flowChannels);
+    sumGpu_.download(sumHost_, stream_);
+    flowSumGpu_.download(flowSumHost_, stream_);
+    crossSumGpu_.download(crossSumHost_, stream_);
+    squareSumGpu_.download(squareSumHost_, stream_);
+    stream_.waitForCompletion();
 
-    cv::cuda::GpuMat magnitudeGpu;
-    cv::cuda::magnitude(flowChannels[0], flowChannels[1], magnitudeGpu);
+    const cv::Vec2d flowSum = flowSumHost_.at<cv::Vec2d>(0, 0);
+    const cv::Vec2d crossSum = crossSumHost_.at<cv::Vec2d>(0, 0);
+    const cv::Vec2d squareSum = squareSumHost_.at<cv::Vec2d>(0, 0);
 
-    cv::Scalar sumMag = cv::cuda::sum(magnitudeGpu);
-    float averageMag = static_cast<float>(sumMag[0]) / (magnitudeGpu.rows * magnitudeGpu.cols);
+    FlowMoments moments = positionMoments_;
+    moments.sumMagnitude = sumHost_.at<double>(0, 0);
+    moments.sumU = flowSum[0];
+    moments.sumV = flowSum[1];
+    moments.sumCross = crossSum[0] + crossSum[1];
+    moments.sumSquares = squareSum[0] + squareSum[1];
+    measurement = moments.toMeasurement();
 
-    return averageMag;
-}
\ No newline at end of file
+    // The current frame becomes the previous one without another upload
+    prevGpu_.swap(currGpu_);
+    cv::swap(prevSmall_, currSmall_);
+    return true;
+}
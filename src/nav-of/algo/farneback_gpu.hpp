@@ -1,5 +1,61 @@
 #pragma once
 #include <opencv2/core.hpp>
+#include <opencv2/core/cuda.hpp>
+#include <opencv2/cudaoptflow.hpp>
+#include "../core/IFlowBackend.hpp"
+#include "utils.hpp"
 
-float computeFarnebackGpuMagnitude(const cv::Mat& prevFrame, const cv::Mat& currFrame, int scaledHeight);
+/**
+ * @brief Farneback flow on the GPU, reduced on the device
+ *
+ * With a sampling set the flow is computed once on the bounding box of the
+ * regions (one launch per region would cost more than the skipped pixels) and
+ * the reduction is masked to the sampled pixels. The confidence rests on the
+ * residual of the rigid image motion only (the image texture stays on the device).
+ */
+class FarnebackGpuBackend : public IFlowBackend {
+public:
+    FarnebackGpuBackend();
 
+    const char* getName() const override { return "farneback-gpu"; }
+
+    bool process(const cv::Mat& frame, int scaledHeight, FlowMeasurement& measurement) override;
+
+    void reset() override { hasPrev_ = false; }
+
+    void setSampling(const FlowSampling& sampling) override;
+
+private:
+    void updateReduction(const cv::Rect& area, const cv::Size& frameSize, bool sampled);
+
+    cv::Ptr<cv::cuda::FarnebackOpticalFlow> farneback_;
+    cv::cuda::Stream stream_;
+
+    cv::Mat prevSmall_;  // Host copy of the previous frame, rescaled when the analysis scale changes
+    cv::Mat currSmall_;
+    cv::Mat sumHost_;
+    cv::Mat flowSumHost_;
+    cv::Mat crossSumHost_;
+    cv::Mat squareSumHost_;
+
+    cv::cuda::GpuMat prevGpu_;
+    cv::cuda::GpuMat currGpu_;
+    cv::cuda::GpuMat flowGpu_;
+    cv::cuda::GpuMat flowChannels_[2];
+    cv::cuda::GpuMat magnitudeGpu_;
+    cv::cuda::GpuMat sumGpu_;
+    cv::cuda::GpuMat rotationBasisGpu_;  // (-ry, rx) relative to the frame center
+    cv::cuda::GpuMat reductionMaskGpu_;  // Sampled pixels of the flow area, empty = all
+    cv::cuda::GpuMat productGpu_;
+    cv::cuda::GpuMat flowSumGpu_;
+    cv::cuda::GpuMat crossSumGpu_;
+    cv::cuda::GpuMat squareSumGpu_;
+
+    // Flow area and the position moments of its sampled pixels
+    cv::Rect reductionArea_;
+    cv::Size reductionFrameSize_;
+    bool reductionSampled_ = false;
+    FlowMoments positionMoments_;
+
+    bool hasPrev_ = false;
+};
@@ -0,0 +1,44 @@
+#include "frame_step_policy.hpp"
+#include <algorithm>
+#include <cmath>
+
+FrameStepPolicy::FrameStepPolicy(int maxStep, double maxDisplacementPx)
+    : maxStep_(std::max(maxStep, 1))
+    , maxDisplacementPx_(maxDisplacementPx) {}
+
+void FrameStepPolicy::setMaxStep(int maxStep) {
+    maxStep_ = std::max(maxStep, 1);
+    reset();
+}
+
+void FrameStepPolicy::reset() {
+    step_ = 1;
+    calmEvaluations_ = 0;
+}
+
+int FrameStepPolicy::update(double displacementPx, double yawRate, double acceleration, double confidence) {
+    const bool maneuvering = std::fabs(yawRate) > MANEUVER_YAW_RATE
+        || std::fabs(acceleration) > MANEUVER_ACCELERATION
+        || !(confidence >= MIN_CONFIDENCE)
+        || !std::isfinite(displacementPx);
+    if (maneuvering) {
+        reset();
+        return step_;
+    }
+
+    // Largest step whose displacement stays inside the sweet spot
+    int limit = maxStep_;
+    if (displacementPx > 0.0) {
+        limit = static_cast<int>(std::clamp(std::floor(maxDisplacementPx_ / displacementPx), 1.0,
+                                            static_cast<double>(maxStep_)));
+    }
+
+    if (step_ > limit) {
+        step_ = limit;
+        calmEvaluations_ = 0;
+    } else if (step_ < limit && ++calmEvaluations_ >= CALM_EVALUATIONS) {
+        ++step_;
+        calmEvaluations_ = 0;
+    }
+    return step_;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+/**
+ * @brief Picks how many frames apart the flow is measured
+ *
+ * On calm segments the flow between frames k and k+n carries the same
+ * information as n single-frame measurements, so the step grows by one frame
+ * after every CALM_EVALUATIONS calm measurements, as long as the displacement
+ * over the step stays below the upper end of the flow algorithm's sweet spot.
+ * Turning, accelerating or a low confidence drop the step to 1 immediately.
+ */
+class FrameStepPolicy {
+public:
+    static constexpr double MANEUVER_YAW_RATE = 0.15;     // rad/s
+    static constexpr double MANEUVER_ACCELERATION = 1.0;  // m/s^2
+    static constexpr double MIN_CONFIDENCE = 0.5;
+    static constexpr int CALM_EVALUATIONS = 3;
+
+    /**
+     * @brief Constructor
+     *
+     * @param maxStep Largest step in frames (1 disables skipping)
+     * @param maxDisplacementPx Largest displacement per measurement, pixels of the analysed frame
+     */
+    FrameStepPolicy(int maxStep, double maxDisplacementPx);
+
+    void setMaxStep(int maxStep);
+
+    /**
+     * @brief Chooses the step after a measurement
+     *
+     * @param displacementPx Expected displacement per frame in pixels of the analysed frame
+     * @param yawRate Camera yaw rate in rad/s
+     * @param acceleration Change of the filtered speed in m/s^2
+     * @param confidence Confidence of the measurement (0-1)
+     * @return Frames until the next measurement
+     */
+    int update(double displacementPx, double yawRate, double acceleration, double confidence);
+
+    /**
+     * @brief Returns to measuring every frame
+     */
+    void reset();
+
+    int getStep() const { return step_; }
+
+    int getMaxStep() const { return maxStep_; }
+
+private:
+    int maxStep_;
+    double maxDisplacementPx_;
+
+    int step_ = 1;
+    int calmEvaluations_ = 0;
+};
@@ -1,33 +1,405 @@
 #include "horn_schunck.hpp"
+#include <cstring>
 #include <opencv2/imgproc.hpp>
 
-void hornSchunck(const cv::Mat& prevGray, const cv::Mat& currGray,
-                 cv::Mat& u, cv::Mat& v, float alpha, int iterations) {
-    cv::Mat I1 = prevGray.clone(), I2 = currGray.clone();
-    I1.convertTo(I1, CV_32F);
-    I2.convertTo(I2, CV_32F);
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLORA_HS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// The AVX2 kernel is compiled with a function target attribute and only called after a CPUID check,
+// so the library still runs on CPUs without AVX2 (GCC/Clang only)
+#if defined(FLORA_HS_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define FLORA_HS_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+const float EDGE_WEIGHT = 1.0f / 6.0f;
+const float CORNER_WEIGHT = 1.0f / 12.0f;
 
-    cv::Mat Ix, Iy, It;
-    cv::Sobel(I1, Ix, CV_32F, 1, 0, 3);
-    cv::Sobel(I1, Iy, CV_32F, 0, 1, 3);
-    It = I2 - I1;
+// Iterations between two convergence checks (a check costs about one extra pass)
+const int CONVERGENCE_CHECK_INTERVAL = 5;
 
-    u = cv::Mat::zeros(I1.size(), CV_32F);
-    v = cv::Mat::zeros(I1.size(), CV_32F);
+// Minimum width and height of the coarsest pyramid level
+const int MIN_LEVEL_SIZE = 16;
 
-    cv::Mat kernel = (cv::Mat_<float>(3,3) << 1/12.0f, 1/6.0f, 1/12.0f,
-                                              1/6.0f,  0.0f, 1/6.0f,
-                                              1/12.0f, 1/6.0f, 1/12.0f);
+// One output row of a Jacobi iteration; flow pointers address column 0 of rows with a one pixel border
+struct RowPointers {
+    const float* uUp;
+    const float* u;
+    const float* uDown;
+    const float* vUp;
+    const float* v;
+    const float* vDown;
+    const float* ix;
+    const float* iy;
+    const float* it;
+    const float* invDenom;
+    float* uOut;
+    float* vOut;
+};
 
-    for (int iter = 0; iter < iterations; ++iter) {
-        cv::Mat uAvg, vAvg;
-        cv::filter2D(u, uAvg, -1, kernel);
-        cv::filter2D(v, vAvg, -1, kernel);
+using RowKernel = void (*)(const RowPointers& row, int cols);
 
-        cv::Mat num = Ix.mul(uAvg) + Iy.mul(vAvg) + It;
-        cv::Mat denom = alpha * alpha + Ix.mul(Ix) + Iy.mul(Iy);
+void updateRange(const RowPointers& p, int begin, int end) {
+    for (int x = begin; x < end; ++x) {
+        float uAvg = (p.uUp[x] + p.uDown[x] + p.u[x - 1] + p.u[x + 1]) * EDGE_WEIGHT
+                   + (p.uUp[x - 1] + p.uUp[x + 1] + p.uDown[x - 1] + p.uDown[x + 1]) * CORNER_WEIGHT;
+        float vAvg = (p.vUp[x] + p.vDown[x] + p.v[x - 1] + p.v[x + 1]) * EDGE_WEIGHT
+                   + (p.vUp[x - 1] + p.vUp[x + 1] + p.vDown[x - 1] + p.vDown[x + 1]) * CORNER_WEIGHT;
 
-        u = uAvg - Ix.mul(num) / denom;
-        v = vAvg - Iy.mul(num) / denom;
+        float t = (p.ix[x] * uAvg + p.iy[x] * vAvg + p.it[x]) * p.invDenom[x];
+        p.uOut[x] = uAvg - p.ix[x] * t;
+        p.vOut[x] = vAvg - p.iy[x] * t;
     }
-}
\ No newline at end of file
+}
+
+void updateRowScalar(const RowPointers& p, int cols) {
+    updateRange(p, 0, cols);
+}
+
+#ifdef FLORA_HS_SSE2
+inline __m128 stencilSse2(const float* up, const float* row, const float* down, int x, __m128 edge, __m128 corner) {
+    __m128 edges = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(up + x), _mm_loadu_ps(down + x)),
+                              _mm_add_ps(_mm_loadu_ps(row + x - 1), _mm_loadu_ps(row + x + 1)));
+    __m128 corners = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(up + x - 1), _mm_loadu_ps(up + x + 1)),
+                                _mm_add_ps(_mm_loadu_ps(down + x - 1), _mm_loadu_ps(down + x + 1)));
+    return _mm_add_ps(_mm_mul_ps(edges, edge), _mm_mul_ps(corners, corner));
+}
+
+void updateRowSse2(const RowPointers& p, int cols) {
+    const __m128 edge = _mm_set1_ps(EDGE_WEIGHT);
+    const __m128 corner = _mm_set1_ps(CORNER_WEIGHT);
+
+    int x = 0;
+    for (; x + 4 <= cols; x += 4) {
+        __m128 uAvg = stencilSse2(p.uUp, p.u, p.uDown, x, edge, corner);
+        __m128 vAvg = stencilSse2(p.vUp, p.v, p.vDown, x, edge, corner);
+        __m128 ix = _mm_loadu_ps(p.ix + x);
+        __m128 iy = _mm_loadu_ps(p.iy + x);
+
+        __m128 num = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ix, uAvg), _mm_mul_ps(iy, vAvg)), _mm_loadu_ps(p.it + x));
+        __m128 t = _mm_mul_ps(num, _mm_loadu_ps(p.invDenom + x));
+        _mm_storeu_ps(p.uOut + x, _mm_sub_ps(uAvg, _mm_mul_ps(ix, t)));
+        _mm_storeu_ps(p.vOut + x, _mm_sub_ps(vAvg, _mm_mul_ps(iy, t)));
+    }
+    updateRange(p, x, cols);
+}
+#endif
+
+#ifdef FLORA_HS_AVX2
+__attribute__((target("avx2,fma")))
+inline __m256 stencilAvx2(const float* up, const float* row, const float* down, int x, __m256 edge, __m256 corner) {
+    __m256 edges = _mm256_add_ps(_mm256_add_ps(_mm256_loadu_ps(up + x), _mm256_loadu_ps(down + x)),
+                                 _mm256_add_ps(_mm256_loadu_ps(row + x - 1), _mm256_loadu_ps(row + x + 1)));
+    __m256 corners = _mm256_add_ps(_mm256_add_ps(_mm256_loadu_ps(up + x - 1), _mm256_loadu_ps(up + x + 1)),
+                                   _mm256_add_ps(_mm256_loadu_ps(down + x - 1), _mm256_loadu_ps(down + x + 1)));
+    return _mm256_fmadd_ps(edges, edge, _mm256_mul_ps(corners, corner));
+}
+
+__attribute__((target("avx2,fma")))
+void updateRowAvx2(const RowPointers& p, int cols) {
+    const __m256 edge = _mm256_set1_ps(EDGE_WEIGHT);
+    const __m256 corner = _mm256_set1_ps(CORNER_WEIGHT);
+
+    int x = 0;
+    for (; x + 8 <= cols; x += 8) {
+        __m256 uAvg = stencilAvx2(p.uUp, p.u, p.uDown, x, edge, corner);
+        __m256 vAvg = stencilAvx2(p.vUp, p.v, p.vDown, x, edge, corner);
+        __m256 ix = _mm256_loadu_ps(p.ix + x);
+        __m256 iy = _mm256_loadu_ps(p.iy + x);
+
+        __m256 num = _mm256_fmadd_ps(ix, uAvg, _mm256_fmadd_ps(iy, vAvg, _mm256_loadu_ps(p.it + x)));
+        __m256 t = _mm256_mul_ps(num, _mm256_loadu_ps(p.invDenom + x));
+        _mm256_storeu_ps(p.uOut + x, _mm256_fnmadd_ps(ix, t, uAvg));
+        _mm256_storeu_ps(p.vOut + x, _mm256_fnmadd_ps(iy, t, vAvg));
+    }
+    updateRange(p, x, cols);
+}
+#endif
+
+struct KernelChoice {
+    RowKernel kernel;
+    const char* name;
+};
+
+// Kernels compiled into this build, fastest first
+const KernelChoice KERNELS[] = {
+#ifdef FLORA_HS_AVX2
+    {updateRowAvx2, "avx2"},
+#endif
+#ifdef FLORA_HS_SSE2
+    {updateRowSse2, "sse2"},
+#endif
+    {updateRowScalar, "scalar"},
+};
+const int KERNEL_COUNT = sizeof(KERNELS) / sizeof(KERNELS[0]);
+
+bool isSupported(int kernel) {
+#ifdef FLORA_HS_AVX2
+    if (KERNELS[kernel].kernel == updateRowAvx2) {
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    }
+#endif
+    (void)kernel;
+    return true;
+}
+
+// Fastest kernel this CPU runs (the scalar one always does)
+int bestKernel() {
+    static const int best = []() {
+        int kernel = 0;
+        while (!isSupported(kernel)) ++kernel;
+        return kernel;
+    }();
+    return best;
+}
+
+// Reflects the border columns of padded rows [begin, end) (BORDER_REFLECT_101)
+void reflectColumns(cv::Mat& padded, int begin, int end) {
+    const int last = padded.cols - 1;
+    for (int y = begin; y < end; ++y) {
+        float* row = padded.ptr<float>(y);
+        row[0] = row[2];
+        row[last] = row[last - 2];
+    }
+}
+
+// Reflects the border rows of a padded buffer whose border columns are already filled
+void reflectRows(cv::Mat& padded) {
+    const int last = padded.rows - 1;
+    const size_t rowBytes = padded.cols * sizeof(float);
+    std::memcpy(padded.ptr<float>(0), padded.ptr<float>(2), rowBytes);
+    std::memcpy(padded.ptr<float>(last), padded.ptr<float>(last - 2), rowBytes);
+}
+
+// Resamples a flow component to another level size, scaling the vectors with the resolution
+void resizeFlow(const cv::Mat& src, cv::Mat& dst, cv::Mat& scratch, const cv::Size& size, double scale) {
+    const int interpolation = size.width < src.cols ? cv::INTER_AREA : cv::INTER_LINEAR;
+    cv::resize(src, scratch, size, 0.0, 0.0, interpolation);
+    scratch.convertTo(dst, CV_32F, scale);
+}
+
+} // namespace
+
+HornSchunckSolver::HornSchunckSolver(float alpha, int iterations)
+    : alpha_(alpha)
+    , iterations_(iterations)
+{
+}
+
+const char* HornSchunckSolver::getKernelName() {
+    return KERNELS[bestKernel()].name;
+}
+
+bool HornSchunckSolver::setKernel(const std::string& name) {
+    if (name == "auto") {
+        kernel_ = -1;
+        return true;
+    }
+    for (int kernel = 0; kernel < KERNEL_COUNT; ++kernel) {
+        if (name == KERNELS[kernel].name && isSupported(kernel)) {
+            kernel_ = kernel;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* HornSchunckSolver::getActiveKernelName() const {
+    return KERNELS[kernel_ < 0 ? bestKernel() : kernel_].name;
+}
+
+void HornSchunckSolver::prepare(const cv::Mat& prevGray, const cv::Mat& currGray, const cv::Mat* u0, const cv::Mat* v0) {
+    prevGray.convertTo(prev_, CV_32F);
+    currGray.convertTo(curr_, CV_32F);
+
+    // The 3x3 Sobel kernel weights the difference by 8; scaled back so the flow is in pixels
+    cv::Sobel(prev_, ix_, CV_32F, 1, 0, 3, 1.0 / 8.0);
+    cv::Sobel(prev_, iy_, CV_32F, 0, 1, 3, 1.0 / 8.0);
+
+    if (u0 != nullptr) {
+        // Warp the current frame back by the initial flow
+        mapX_.create(prev_.size(), CV_32F);
+        mapY_.create(prev_.size(), CV_32F);
+        for (int y = 0; y < prev_.rows; ++y) {
+            const float* u = u0->ptr<float>(y);
+            const float* v = v0->ptr<float>(y);
+            float* mapX = mapX_.ptr<float>(y);
+            float* mapY = mapY_.ptr<float>(y);
+            for (int x = 0; x < prev_.cols; ++x) {
+                mapX[x] = x + u[x];
+                mapY[x] = y + v[x];
+            }
+        }
+        cv::remap(curr_, warped_, mapX_, mapY_, cv::INTER_LINEAR, cv::BORDER_REPLICATE);
+        cv::subtract(warped_, prev_, it_);
+    } else {
+        cv::subtract(curr_, prev_, it_);
+    }
+
+    // alpha^2 + Ix^2 + Iy^2 does not change between iterations; with an initial flow the
+    // constancy equation is linearized around it: It = I2(x + w0) - I1(x) - Ix u0 - Iy v0
+    const float alpha2 = alpha_ * alpha_;
+    invDenom_.create(prev_.size(), CV_32F);
+    for (int y = 0; y < prev_.rows; ++y) {
+        const float* ix = ix_.ptr<float>(y);
+        const float* iy = iy_.ptr<float>(y);
+        float* it = it_.ptr<float>(y);
+        float* inv = invDenom_.ptr<float>(y);
+        for (int x = 0; x < prev_.cols; ++x) {
+            inv[x] = 1.0f / (alpha2 + ix[x] * ix[x] + iy[x] * iy[x]);
+        }
+        if (u0 != nullptr) {
+            const float* u = u0->ptr<float>(y);
+            const float* v = v0->ptr<float>(y);
+            for (int x = 0; x < prev_.cols; ++x) {
+                it[x] -= ix[x] * u[x] + iy[x] * v[x];
+            }
+        }
+    }
+
+    const cv::Size padded(prev_.cols + 2, prev_.rows + 2);
+    for (int i = 0; i < 2; ++i) {
+        u_[i].create(padded, CV_32F);
+        v_[i].create(padded, CV_32F);
+    }
+
+    if (u0 != nullptr) {
+        const cv::Rect interior(1, 1, prev_.cols, prev_.rows);
+        cv::Mat uInterior = u_[0](interior);
+        cv::Mat vInterior = v_[0](interior);
+        u0->copyTo(uInterior);
+        v0->copyTo(vInterior);
+        reflectColumns(u_[0], 1, prev_.rows + 1);
+        reflectColumns(v_[0], 1, prev_.rows + 1);
+        reflectRows(u_[0]);
+        reflectRows(v_[0]);
+    } else {
+        u_[0].setTo(0.0f);
+        v_[0].setTo(0.0f);
+    }
+}
+
+void HornSchunckSolver::iterate(int src) {
+    const int dst = 1 - src;
+    const int rows = prev_.rows;
+    const int cols = prev_.cols;
+    const RowKernel kernel = KERNELS[kernel_ < 0 ? bestKernel() : kernel_].kernel;
+
+    cv::parallel_for_(cv::Range(0, rows), [&](const cv::Range& range) {
+        for (int y = range.start; y < range.end; ++y) {
+            RowPointers p;
+            p.uUp = u_[src].ptr<float>(y) + 1;
+            p.u = u_[src].ptr<float>(y + 1) + 1;
+            p.uDown = u_[src].ptr<float>(y + 2) + 1;
+            p.vUp = v_[src].ptr<float>(y) + 1;
+            p.v = v_[src].ptr<float>(y + 1) + 1;
+            p.vDown = v_[src].ptr<float>(y + 2) + 1;
+            p.ix = ix_.ptr<float>(y);
+            p.iy = iy_.ptr<float>(y);
+            p.it = it_.ptr<float>(y);
+            p.invDenom = invDenom_.ptr<float>(y);
+            p.uOut = u_[dst].ptr<float>(y + 1) + 1;
+            p.vOut = v_[dst].ptr<float>(y + 1) + 1;
+            kernel(p, cols);
+        }
+        // Each band owns the border columns of its rows
+        reflectColumns(u_[dst], range.start + 1, range.end + 1);
+        reflectColumns(v_[dst], range.start + 1, range.end + 1);
+    });
+
+    reflectRows(u_[dst]);
+    reflectRows(v_[dst]);
+}
+
+bool HornSchunckSolver::hasConverged(int latest) const {
+    const cv::Rect interior(1, 1, prev_.cols, prev_.rows);
+    const double change = cv::norm(u_[latest](interior), u_[1 - latest](interior), cv::NORM_L1)
+                        + cv::norm(v_[latest](interior), v_[1 - latest](interior), cv::NORM_L1);
+    return change < epsilon_ * 2.0 * interior.area();
+}
+
+int HornSchunckSolver::compute(const cv::Mat& prevGray, const cv::Mat& currGray, cv::Mat& u, cv::Mat& v,
+                               bool useInitialFlow) {
+    CV_Assert(prevGray.size() == currGray.size() && prevGray.type() == currGray.type());
+
+    // The reflected border needs at least two rows and columns
+    if (prevGray.rows < 2 || prevGray.cols < 2) {
+        u = cv::Mat::zeros(prevGray.size(), CV_32F);
+        v = cv::Mat::zeros(prevGray.size(), CV_32F);
+        return 0;
+    }
+
+    const bool hasInitialFlow = useInitialFlow
+        && u.size() == prevGray.size() && u.type() == CV_32F
+        && v.size() == prevGray.size() && v.type() == CV_32F;
+    prepare(prevGray, currGray, hasInitialFlow ? &u : nullptr, hasInitialFlow ? &v : nullptr);
+
+    int src = 0;
+    int iter = 0;
+    while (iter < iterations_) {
+        iterate(src);
+        src = 1 - src;
+        ++iter;
+        if (epsilon_ > 0.0f && iter % CONVERGENCE_CHECK_INTERVAL == 0 && hasConverged(src)) break;
+    }
+
+    const cv::Rect interior(1, 1, prev_.cols, prev_.rows);
+    u_[src](interior).copyTo(u);
+    v_[src](interior).copyTo(v);
+    return iter;
+}
+
+PyramidalHornSchunck::PyramidalHornSchunck(int levels, float alpha, int iterations, float epsilon)
+    : levels_(levels > 0 ? levels : 1)
+    , solver_(alpha, iterations)
+{
+    solver_.setConvergenceThreshold(epsilon);
+}
+
+int PyramidalHornSchunck::compute(const cv::Mat& prevGray, const cv::Mat& currGray, cv::Mat& u, cv::Mat& v,
+                                  bool warmStart) {
+    CV_Assert(prevGray.size() == currGray.size() && prevGray.type() == currGray.type());
+
+    int maxLevel = 0;
+    for (cv::Size size = prevGray.size(); maxLevel + 1 < levels_; ++maxLevel) {
+        size = cv::Size((size.width + 1) / 2, (size.height + 1) / 2);
+        if (size.width < MIN_LEVEL_SIZE || size.height < MIN_LEVEL_SIZE) break;
+    }
+    cv::buildPyramid(prevGray, prevPyramid_, maxLevel);
+    cv::buildPyramid(currGray, currPyramid_, maxLevel);
+
+    // Seed the coarsest level with the flow of the previous frame pair
+    bool hasFlow = warmStart
+        && u.size() == prevGray.size() && u.type() == CV_32F
+        && v.size() == prevGray.size() && v.type() == CV_32F;
+    if (hasFlow) {
+        const cv::Size coarsest = prevPyramid_[maxLevel].size();
+        resizeFlow(u, levelU_, scaled_, coarsest, coarsest.width / static_cast<double>(u.cols));
+        resizeFlow(v, levelV_, scaled_, coarsest, coarsest.height / static_cast<double>(v.rows));
+    }
+
+    int iterations = 0;
+    for (int level = maxLevel; level >= 0; --level) {
+        const cv::Size size = prevPyramid_[level].size();
+        if (hasFlow && levelU_.size() != size) {
+            resizeFlow(levelU_, levelU_, scaled_, size, size.width / static_cast<double>(levelU_.cols));
+            resizeFlow(levelV_, levelV_, scaled_, size, size.height / static_cast<double>(levelV_.rows));
+        }
+        iterations += solver_.compute(prevPyramid_[level], currPyramid_[level], levelU_, levelV_, hasFlow);
+        hasFlow = true;
+    }
+
+    levelU_.copyTo(u);
+    levelV_.copyTo(v);
+    return iterations;
+}
+
+void hornSchunck(const cv::Mat& prevGray, const cv::Mat& currGray,
+                 cv::Mat& u, cv::Mat& v, float alpha, int iterations) {
+    HornSchunckSolver solver(alpha, iterations);
+    solver.compute(prevGray, currGray, u, v);
+}
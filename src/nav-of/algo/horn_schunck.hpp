@@ -1,5 +1,146 @@
 #pragma once
+#include <string>
+#include <vector>
 #include <opencv2/core.hpp>
 
+/**
+ * @brief Horn-Schunck optical flow solver with preallocated working buffers
+ *
+ * The image derivatives (in intensity per pixel) and the per-pixel factor
+ * 1 / (alpha^2 + Ix^2 + Iy^2) are computed once per frame pair. Every Jacobi iteration is a single fused
+ * pass (averaging stencil + update) over row bands processed in parallel with
+ * cv::parallel_for_; the row kernel uses AVX2/FMA or SSE2 when the CPU
+ * supports it and a scalar loop otherwise. Buffers are kept between calls and
+ * only reallocated when the frame size changes.
+ *
+ * Starting from an initial flow (u0, v0), the current frame is warped by it
+ * and the brightness constancy is linearized around it, so the iterations
+ * refine the given flow instead of starting from zero. Iterations stop early
+ * once the mean flow update per iteration drops below the convergence
+ * threshold.
+ */
+class HornSchunckSolver {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param alpha Smoothness weight
+     * @param iterations Jacobi iterations per frame pair
+     */
+    explicit HornSchunckSolver(float alpha = 1.0f, int iterations = 100);
+
+    void setAlpha(float alpha) { alpha_ = alpha; }
+
+    void setIterations(int iterations) { iterations_ = iterations; }
+
+    /**
+     * @brief Sets the mean absolute flow update in pixels below which iterations stop (0 = always run all)
+     */
+    void setConvergenceThreshold(float epsilon) { epsilon_ = epsilon; }
+
+    /**
+     * @brief Computes the flow from prevGray to currGray
+     *
+     * @param prevGray Previous frame (CV_8UC1 or CV_32FC1)
+     * @param currGray Current frame (same size and type)
+     * @param u Horizontal flow (CV_32FC1); initial flow on input if useInitialFlow is set
+     * @param v Vertical flow (CV_32FC1); initial flow on input if useInitialFlow is set
+     * @param useInitialFlow Refine u and v instead of starting from zero (ignored if their size does not match)
+     * @return Number of iterations run
+     */
+    int compute(const cv::Mat& prevGray, const cv::Mat& currGray, cv::Mat& u, cv::Mat& v, bool useInitialFlow = false);
+
+    /**
+     * @brief Row kernel selected for this CPU ("avx2", "sse2" or "scalar")
+     */
+    static const char* getKernelName();
+
+    /**
+     * @brief Forces a row kernel ("avx2", "sse2", "scalar"; "auto" selects the fastest one again)
+     *
+     * @return false if the kernel is not compiled in or not supported by this CPU (the selection is kept)
+     */
+    bool setKernel(const std::string& name);
+
+    /**
+     * @brief Row kernel used by compute()
+     */
+    const char* getActiveKernelName() const;
+
+private:
+    void prepare(const cv::Mat& prevGray, const cv::Mat& currGray, const cv::Mat* u0, const cv::Mat* v0);
+    void iterate(int src);
+    bool hasConverged(int src) const;
+
+    float alpha_;
+    int iterations_;
+    float epsilon_ = 0.0f;
+    int kernel_ = -1;  // Index of the forced row kernel, -1 = fastest for this CPU
+
+    cv::Mat prev_;
+    cv::Mat curr_;
+    cv::Mat ix_;
+    cv::Mat iy_;
+    cv::Mat it_;
+    cv::Mat invDenom_;
+    cv::Mat warped_;
+    cv::Mat mapX_;
+    cv::Mat mapY_;
+
+    // Ping-pong flow buffers with a one pixel border (reflected, as cv::filter2D does)
+    cv::Mat u_[2];
+    cv::Mat v_[2];
+};
+
+/**
+ * @brief Coarse-to-fine Horn-Schunck on an image pyramid
+ *
+ * The flow is solved on the coarsest level first; every finer level starts
+ * from the upsampled flow of the level below and only refines it, so large
+ * displacements converge in a few iterations per level. The coarsest level
+ * can be seeded with the flow of the previous frame pair (warm start).
+ */
+class PyramidalHornSchunck {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param levels Pyramid levels including the full resolution (coarsest level keeps at least 16 px)
+     * @param alpha Smoothness weight
+     * @param iterations Maximum Jacobi iterations per level
+     * @param epsilon Convergence threshold per level (mean absolute flow update in pixels)
+     */
+    explicit PyramidalHornSchunck(int levels = 4, float alpha = 10.0f, int iterations = 30, float epsilon = 0.01f);
+
+    /**
+     * @brief Computes the flow from prevGray to currGray
+     *
+     * @param prevGray Previous frame (CV_8UC1)
+     * @param currGray Current frame (same size and type)
+     * @param u Horizontal flow (CV_32FC1); flow of the previous frame pair on input if warmStart is set
+     * @param v Vertical flow (CV_32FC1); flow of the previous frame pair on input if warmStart is set
+     * @param warmStart Seed the coarsest level with u and v (ignored if their size does not match)
+     * @return Total number of iterations over all levels
+     */
+    int compute(const cv::Mat& prevGray, const cv::Mat& currGray, cv::Mat& u, cv::Mat& v, bool warmStart = false);
+
+private:
+    int levels_;
+    HornSchunckSolver solver_;
+    std::vector<cv::Mat> prevPyramid_;
+    std::vector<cv::Mat> currPyramid_;
+    cv::Mat levelU_;
+    cv::Mat levelV_;
+    cv::Mat scaled_;
+};
+
+/**
+ * @brief Horn-Schunck flow from prevGray to currGray (HornSchunckSolver without an initial flow or early stop)
+ *
+ * The image derivatives are in intensity per pixel (3x3 Sobel / 8), so the flow is in pixels. Before
+ * HornSchunckSolver the plain Sobel response (8 times larger) was used against an unscaled temporal
+ * derivative: the flow for a given alpha is now 8 times the old flow for 8 * alpha, so callers tuned on
+ * the old scaling divide their alpha by 8.
+ */
 void hornSchunck(const cv::Mat& prevGray, const cv::Mat& currGray,
                  cv::Mat& u, cv::Mat& v, float alpha = 1.0f, int iterations = 100);
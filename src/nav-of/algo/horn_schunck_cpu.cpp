@@ -0,0 +1,34 @@
+#include "horn_schunck_cpu.hpp"
+
+// Four pyramid levels of at most 30 iterations each, warm-started from the previous frame pair;
+// rows are split with cv::parallel_for_
+HornSchunckCpuBackend::HornSchunckCpuBackend()
+    : solver_(4, 10.0f, 30, 0.01f) {}
+
+void HornSchunckCpuBackend::reset() {
+    CpuDenseFlowBackend::reset();
+    for (RegionFlow& regionFlow : regionFlows_) {
+        regionFlow.valid = false;
+    }
+}
+
+void HornSchunckCpuBackend::setSampling(const FlowSampling& sampling) {
+    CpuDenseFlowBackend::setSampling(sampling);
+
+    // Region indices refer to other rectangles now
+    regionFlows_.clear();
+}
+
+void HornSchunckCpuBackend::computeFlow(const cv::Mat& prevSmall, const cv::Mat& currSmall, cv::Mat& flow, int region) {
+    if (static_cast<int>(regionFlows_.size()) <= region) {
+        regionFlows_.resize(region + 1);
+    }
+
+    // The solver starts from zero flow if the region changed size since the previous frame
+    RegionFlow& regionFlow = regionFlows_[region];
+    solver_.compute(prevSmall, currSmall, regionFlow.u, regionFlow.v, regionFlow.valid);
+    regionFlow.valid = true;
+
+    cv::Mat channels[] = {regionFlow.u, regionFlow.v};
+    cv::merge(channels, 2, flow);
+}
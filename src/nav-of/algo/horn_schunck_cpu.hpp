@@ -0,0 +1,29 @@
+#pragma once
+#include <vector>
+#include "dense_cpu.hpp"
+#include "horn_schunck.hpp"
+
+class HornSchunckCpuBackend : public CpuDenseFlowBackend {
+public:
+    HornSchunckCpuBackend();
+
+    const char* getName() const override { return "hs-cpu"; }
+
+    void reset() override;
+
+    void setSampling(const FlowSampling& sampling) override;
+
+protected:
+    void computeFlow(const cv::Mat& prevSmall, const cv::Mat& currSmall, cv::Mat& flow, int region) override;
+
+private:
+    // Flow of the previous frame pair per sampling region, warm start of the next one
+    struct RegionFlow {
+        cv::Mat u;
+        cv::Mat v;
+        bool valid = false;
+    };
+
+    PyramidalHornSchunck solver_;
+    std::vector<RegionFlow> regionFlows_;
+};
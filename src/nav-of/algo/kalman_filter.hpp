@@ -1,12 +1,18 @@
 #pragma once
+#include <algorithm>
 
 class Kalman1D {
 public:
     Kalman1D() : x(0.0f), p(1.0f), q(0.01f), r(0.1f) {}
 
     float update(float measurement) {
+        return update(measurement, 1.0f);
+    }
+
+    // The measurement noise grows as the confidence drops, so bad frames move the estimate less
+    float update(float measurement, float confidence) {
         p += q;
-        float k = p / (p + r);
+        float k = p / (p + r / std::max(confidence, 0.05f));
         x += k * (measurement - x);
         p *= (1 - k);
         return x;
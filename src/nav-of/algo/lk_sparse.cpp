@@ -0,0 +1,218 @@
+#include "lk_sparse.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <opencv2/imgproc.hpp>
+
+namespace {
+
+const int MAX_CORNERS = 300;
+const double CORNER_QUALITY = 0.01;
+const double CORNER_MIN_DISTANCE = 8.0;
+const int REDETECT_INTERVAL = 10;   // frames
+const int MIN_POINTS = 50;          // re-detect earlier when fewer points survive
+const int MIN_TRACKED = 8;          // fewer tracks give no measurement
+const cv::Size WINDOW_SIZE(21, 21);
+const int PYRAMID_LEVELS = 3;
+const float INLIER_RADIUS = 1.0f;   // pixels around the rigid motion of the frame
+const int RANSAC_ITERATIONS = 64;
+const float MIN_PAIR_DISTANCE = 16.0f;  // pixels between the two points of a hypothesis
+const int REFINE_ITERATIONS = 2;
+
+float median(const std::vector<float>& values, std::vector<float>& scratch) {
+    scratch.assign(values.begin(), values.end());
+    auto middle = scratch.begin() + scratch.size() / 2;
+    std::nth_element(scratch.begin(), middle, scratch.end());
+    return *middle;
+}
+
+// Small-angle rigid image motion: flow(p) = translation + rotation * (-(p.y - origin.y), p.x - origin.x)
+struct RigidMotion {
+    cv::Point2f origin;
+    cv::Point2f translation;
+    float rotation = 0.0f;
+
+    cv::Point2f flowAt(const cv::Point2f& point) const {
+        return translation + rotation * cv::Point2f(origin.y - point.y, point.x - origin.x);
+    }
+};
+
+// Motion through two tracks; false if the points are too close to fix the rotation
+bool motionFromPair(const cv::Point2f& p0, const cv::Point2f& f0, const cv::Point2f& p1, const cv::Point2f& f1,
+                    RigidMotion& motion) {
+    const cv::Point2f d = p1 - p0;
+    const float d2 = d.dot(d);
+    if (d2 < MIN_PAIR_DISTANCE * MIN_PAIR_DISTANCE) return false;
+
+    const cv::Point2f df = f1 - f0;
+    motion.origin = p0;
+    motion.translation = f0;
+    motion.rotation = (d.x * df.y - d.y * df.x) / d2;
+    return true;
+}
+
+// Marks the tracks within INLIER_RADIUS of the motion and returns their number
+int markInliers(const RigidMotion& motion, const std::vector<cv::Point2f>& from, const std::vector<cv::Point2f>& flow,
+                std::vector<unsigned char>& inlier) {
+    int count = 0;
+    inlier.resize(from.size());
+    for (size_t i = 0; i < from.size(); ++i) {
+        const cv::Point2f e = flow[i] - motion.flowAt(from[i]);
+        inlier[i] = e.dot(e) <= INLIER_RADIUS * INLIER_RADIUS;
+        count += inlier[i];
+    }
+    return count;
+}
+
+} // namespace
+
+void SparseLkBackend::reset() {
+    hasPrev_ = false;
+    points_.clear();
+    rng_ = cv::RNG();
+}
+
+void SparseLkBackend::setSampling(const FlowSampling& sampling) {
+    IFlowBackend::setSampling(sampling);
+
+    // Tracks outside the new mask are dropped by detecting again
+    points_.clear();
+}
+
+void SparseLkBackend::detect() {
+    // Corners are only searched where the sampling mask allows (the stride does not apply to corners)
+    const cv::Mat mask = sampling_.appliesTo(prevSmall_.size()) ? sampling_.mask : cv::Mat();
+    cv::goodFeaturesToTrack(prevSmall_, points_, MAX_CORNERS, CORNER_QUALITY, CORNER_MIN_DISTANCE, mask);
+    framesSinceDetect_ = 0;
+}
+
+bool SparseLkBackend::process(const cv::Mat& frame, int scaledHeight, FlowMeasurement& measurement) {
+    int scaledWidth = static_cast<int>(frame.cols * (scaledHeight / static_cast<float>(frame.rows)));
+    cv::Size scaledSize(scaledWidth, scaledHeight);
+
+    if (frame.size() == scaledSize)
+        frame.copyTo(currSmall_);
+    else
+        cv::resize(frame, currSmall_, scaledSize);
+
+    // The pyramid of the current frame is reused as the previous one on the next call
+    cv::buildOpticalFlowPyramid(currSmall_, currPyramid_, WINDOW_SIZE, PYRAMID_LEVELS);
+
+    if (!hasPrev_) {
+        cv::swap(prevSmall_, currSmall_);
+        std::swap(prevPyramid_, currPyramid_);
+        points_.clear();
+        hasPrev_ = true;
+        return false;
+    }
+    if (prevSmall_.size() != currSmall_.size()) {
+        // The tracks are detected again on the rescaled previous frame
+        rescaleFrame(prevSmall_, currSmall_.size());
+        cv::buildOpticalFlowPyramid(prevSmall_, prevPyramid_, WINDOW_SIZE, PYRAMID_LEVELS);
+        points_.clear();
+    }
+
+    if (static_cast<int>(points_.size()) < MIN_POINTS || framesSinceDetect_ >= REDETECT_INTERVAL) {
+        detect();
+    }
+
+    bool measured = false;
+    if (!points_.empty()) {
+        const size_t attempted = points_.size();
+        cv::calcOpticalFlowPyrLK(prevPyramid_, currPyramid_, points_, nextPoints_, status_, errors_,
+                                 WINDOW_SIZE, PYRAMID_LEVELS);
+
+        from_.clear();
+        flow_.clear();
+        dx_.clear();
+        dy_.clear();
+        for (size_t i = 0; i < points_.size(); ++i) {
+            if (!status_[i]) continue;
+            from_.push_back(points_[i]);
+            flow_.push_back(nextPoints_[i] - points_[i]);
+            dx_.push_back(flow_.back().x);
+            dy_.push_back(flow_.back().y);
+        }
+
+        const int tracked = static_cast<int>(from_.size());
+        if (tracked >= MIN_TRACKED) {
+            // Translation and rotation are estimated together, so the tracks far from the center
+            // still agree with the model while the camera yaws. Hypotheses: the median translation
+            // and the motions through random pairs of tracks; the one with most inliers wins.
+            RigidMotion best;
+            best.translation = cv::Point2f(median(dx_, scratch_), median(dy_, scratch_));
+            int bestCount = markInliers(best, from_, flow_, inliers_);
+
+            RigidMotion candidate;
+            for (int iteration = 0; iteration < RANSAC_ITERATIONS; ++iteration) {
+                const int a = rng_.uniform(0, tracked);
+                const int b = rng_.uniform(0, tracked);
+                if (!motionFromPair(from_[a], flow_[a], from_[b], flow_[b], candidate)) continue;
+                const int count = markInliers(candidate, from_, flow_, inliers_);
+                if (count > bestCount) {
+                    best = candidate;
+                    bestCount = count;
+                }
+            }
+
+            // Least-squares refit on the inliers, about their centroid like the dense reduction
+            const cv::Point2f center((currSmall_.cols - 1) * 0.5f, (currSmall_.rows - 1) * 0.5f);
+            FlowMoments moments;
+            for (int refine = 0; refine < REFINE_ITERATIONS; ++refine) {
+                markInliers(best, from_, flow_, inliers_);
+                moments = FlowMoments();
+                for (int i = 0; i < tracked; ++i) {
+                    if (!inliers_[i]) continue;
+                    const double rx = from_[i].x - center.x;
+                    const double ry = from_[i].y - center.y;
+                    const double u = flow_[i].x;
+                    const double v = flow_[i].y;
+                    moments.count += 1.0;
+                    moments.sumMagnitude += std::hypot(u, v);
+                    moments.sumU += u;
+                    moments.sumV += v;
+                    moments.sumRx += rx;
+                    moments.sumRy += ry;
+                    moments.sumCross += rx * v - ry * u;
+                    moments.sumR2 += rx * rx + ry * ry;
+                    moments.sumSquares += u * u + v * v;
+                }
+                if (moments.count <= 0.0) break;
+
+                measurement = moments.toMeasurement();
+                best.origin = center + cv::Point2f(static_cast<float>(moments.sumRx / moments.count),
+                                                   static_cast<float>(moments.sumRy / moments.count));
+                best.translation = cv::Point2f(measurement.dx, measurement.dy);
+                best.rotation = measurement.rotation;
+            }
+
+            // The inliers of the final fit are tracked further
+            size_t kept = 0;
+            size_t track = 0;
+            for (size_t i = 0; i < points_.size(); ++i) {
+                if (!status_[i]) continue;
+                if (inliers_[track++]) points_[kept++] = nextPoints_[i];
+            }
+            points_.resize(kept);
+
+            if (moments.count <= 0.0) {
+                measurement = FlowMeasurement();
+                measurement.dx = best.translation.x;
+                measurement.dy = best.translation.y;
+                measurement.avgMagnitude = std::hypot(measurement.dx, measurement.dy);
+                measurement.hasDirection = true;
+            }
+
+            // Corners carry texture by construction; lost tracks and outliers lower the confidence
+            measurement.confidence *= static_cast<float>(kept) / static_cast<float>(attempted);
+            measured = true;
+        } else {
+            points_.clear();
+        }
+    }
+    ++framesSinceDetect_;
+
+    cv::swap(prevSmall_, currSmall_);
+    std::swap(prevPyramid_, currPyramid_);
+    return measured;
+}
@@ -0,0 +1,45 @@
+#include "scale_policy.hpp"
+#include <algorithm>
+#include <cmath>
+
+AdaptiveScalePolicy::AdaptiveScalePolicy(int baseHeight, int minHeight, double minDisplacementPx,
+                                         double maxDisplacementPx)
+    : baseHeight_(baseHeight)
+    , minDisplacementPx_(minDisplacementPx)
+    , maxDisplacementPx_(maxDisplacementPx)
+{
+    while ((baseHeight_ >> levels_) >= minHeight && (baseHeight_ >> levels_) > 0) {
+        ++levels_;
+    }
+}
+
+void AdaptiveScalePolicy::reset() {
+    level_ = 0;
+    framesAtLevel_ = 0;
+}
+
+int AdaptiveScalePolicy::update(double baseDisplacementPx, double confidence) {
+    ++framesAtLevel_;
+    if (!std::isfinite(baseDisplacementPx) || baseDisplacementPx < 0.0) return getHeight();
+
+    const bool lowConfidence = confidence < LOW_CONFIDENCE;
+    const double displacement = std::ldexp(baseDisplacementPx, -level_);
+    const bool inSweetSpot = displacement >= minDisplacementPx_ && displacement <= maxDisplacementPx_;
+    if ((inSweetSpot && !lowConfidence) || framesAtLevel_ < MIN_FRAMES_PER_LEVEL) return getHeight();
+
+    // Coarsest level that keeps the displacement at or above the lower end of the sweet spot
+    int target = 0;
+    if (baseDisplacementPx > minDisplacementPx_) {
+        target = static_cast<int>(std::floor(std::log2(baseDisplacementPx / minDisplacementPx_)));
+    }
+    if (lowConfidence) {
+        target = std::min(target, level_) - 1;
+    }
+    target = std::clamp(target, 0, levels_ - 1);
+
+    if (target != level_) {
+        level_ = target;
+        framesAtLevel_ = 0;
+    }
+    return getHeight();
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+/**
+ * @brief Picks the analysis resolution per frame from the expected image motion
+ *
+ * Candidate heights are the base height halved once per pyramid level, down
+ * to a minimum height. The expected displacement per frame halves with every
+ * level, so the policy takes the coarsest level at which it still reaches the
+ * lower end of the flow algorithm's sweet spot: slow motion (or a high
+ * altitude) is measured at full resolution, fast motion close to the ground at
+ * a fraction of the pixels. Low confidence asks for one level finer.
+ *
+ * A size change costs the backends a rescale of their previous frame (and the
+ * sparse backend new corners), so the current level is kept while its
+ * displacement stays inside the sweet spot and is held for at least
+ * MIN_FRAMES_PER_LEVEL frames.
+ */
+class AdaptiveScalePolicy {
+public:
+    static constexpr int MIN_FRAMES_PER_LEVEL = 15;
+    static constexpr double LOW_CONFIDENCE = 0.3;
+
+    /**
+     * @brief Constructor
+     *
+     * @param baseHeight Finest analysis height in pixels (level 0)
+     * @param minHeight Coarsest allowed analysis height in pixels
+     * @param minDisplacementPx Lower end of the sweet spot, pixels per frame
+     * @param maxDisplacementPx Upper end of the sweet spot, pixels per frame
+     */
+    AdaptiveScalePolicy(int baseHeight, int minHeight, double minDisplacementPx, double maxDisplacementPx);
+
+    /**
+     * @brief Chooses the level for the next frames
+     *
+     * @param baseDisplacementPx Expected displacement per frame at the base height
+     * @param confidence Confidence of the last measurement (0-1)
+     * @return Analysis height of the chosen level
+     */
+    int update(double baseDisplacementPx, double confidence);
+
+    /**
+     * @brief Returns to the base height
+     */
+    void reset();
+
+    int getHeight() const { return baseHeight_ >> level_; }
+
+    int getLevel() const { return level_; }
+
+    int getLevelCount() const { return levels_; }
+
+private:
+    int baseHeight_;
+    int levels_ = 1;
+    double minDisplacementPx_;
+    double maxDisplacementPx_;
+
+    int level_ = 0;
+    int framesAtLevel_ = 0;
+};
@@ -1,12 +1,148 @@
 #include "utils.hpp"
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <opencv2/imgproc.hpp>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+namespace {
+
+// Residual RMS (pixels) at which the rigid-motion part of the confidence is 1/2,
+// plus a share of the flow magnitude since larger motion carries more parallax
+const double RESIDUAL_HALF_PX = 0.5;
+const double RESIDUAL_HALF_RELATIVE = 0.25;
+
+// Mean gradient (gray levels per pixel) at which the texture part of the confidence is 1/2
+const double TEXTURE_HALF = 4.0;
+
+} // namespace
+
 float calculateMetricScale(float altitude, float fovDeg, int imageDiagonalPx) {
     float fovRad = fovDeg * static_cast<float>(M_PI) / 180.0f;
     float diagonalMeters = 2.0f * altitude * std::tan(fovRad / 2.0f);
     return diagonalMeters / static_cast<float>(imageDiagonalPx);
 }
+
+void rescaleFrame(cv::Mat& frame, const cv::Size& size) {
+    const int interpolation = size.width < frame.cols ? cv::INTER_AREA : cv::INTER_LINEAR;
+    cv::Mat scaled;
+    cv::resize(frame, scaled, size, 0.0, 0.0, interpolation);
+    frame = scaled;
+}
+
+FlowMeasurement FlowMoments::toMeasurement() const {
+    FlowMeasurement measurement;
+    if (count <= 0.0) return measurement;
+
+    // Moments about the centroid of the samples decouple the rotation from the translation
+    // (the centroid is the frame center when the whole frame is sampled)
+    const double meanRx = sumRx / count;
+    const double meanRy = sumRy / count;
+    const double cross = sumCross - meanRx * sumV + meanRy * sumU;
+    const double r2 = sumR2 - count * (meanRx * meanRx + meanRy * meanRy);
+
+    measurement.avgMagnitude = static_cast<float>(sumMagnitude / count);
+    measurement.dx = static_cast<float>(sumU / count);
+    measurement.dy = static_cast<float>(sumV / count);
+    measurement.rotation = r2 > 0.0 ? static_cast<float>(cross / r2) : 0.0f;
+    measurement.hasDirection = true;
+
+    // Residual of the fit: spread about the mean flow minus the part the rotation explains
+    double residual = sumSquares - (sumU * sumU + sumV * sumV) / count;
+    if (r2 > 0.0) residual -= cross * cross / r2;
+    const double residualRms = std::sqrt(std::max(residual, 0.0) / count);
+    const double texture = textureCount > 0.0 ? sumTexture / textureCount : -1.0;
+    measurement.confidence = flowConfidence(residualRms, measurement.avgMagnitude, texture);
+    return measurement;
+}
+
+float flowConfidence(double residualRms, double magnitude, double texture) {
+    const double residualHalf = RESIDUAL_HALF_PX + RESIDUAL_HALF_RELATIVE * magnitude;
+    double confidence = residualHalf / (residualHalf + residualRms);
+    if (texture >= 0.0) {
+        confidence *= texture / (texture + TEXTURE_HALF);
+    }
+    return static_cast<float>(confidence);
+}
+
+void accumulateFlow(const cv::Mat& flow, const cv::Point& origin, const cv::Size& frameSize,
+                    int stride, const cv::Mat& mask, FlowMoments& moments, const cv::Mat& image) {
+    if (flow.empty()) return;
+    if (stride < 1) stride = 1;
+
+    const double cx = (frameSize.width - 1) * 0.5;
+    const double cy = (frameSize.height - 1) * 0.5;
+
+    // First region pixel on the stride grid of the frame
+    const int firstX = (stride - origin.x % stride) % stride;
+    const int firstY = (stride - origin.y % stride) % stride;
+
+    for (int y = firstY; y < flow.rows; y += stride) {
+        const cv::Vec2f* row = flow.ptr<cv::Vec2f>(y);
+        const unsigned char* maskRow = mask.empty() ? nullptr : mask.ptr<unsigned char>(y);
+
+        // Central differences, clamped at the region border
+        const unsigned char* imageRow = nullptr;
+        const unsigned char* imageUp = nullptr;
+        const unsigned char* imageDown = nullptr;
+        if (!image.empty()) {
+            imageRow = image.ptr<unsigned char>(y);
+            imageUp = image.ptr<unsigned char>(std::max(y - 1, 0));
+            imageDown = image.ptr<unsigned char>(std::min(y + 1, image.rows - 1));
+        }
+
+        const double ry = origin.y + y - cy;
+        double rowCount = 0.0;
+        double rowMag = 0.0;
+        double rowU = 0.0;
+        double rowV = 0.0;
+        double rowX = 0.0;
+        double rowXV = 0.0;
+        double rowX2 = 0.0;
+        double rowSquares = 0.0;
+        int rowTexture = 0;
+        for (int x = firstX; x < flow.cols; x += stride) {
+            if (maskRow && !maskRow[x]) continue;
+            const float u = row[x][0];
+            const float v = row[x][1];
+            const double rx = origin.x + x - cx;
+            const float squared = u * u + v * v;
+            rowCount += 1.0;
+            rowMag += std::sqrt(squared);
+            rowSquares += squared;
+            rowU += u;
+            rowV += v;
+            rowX += rx;
+            rowXV += rx * v;
+            rowX2 += rx * rx;
+            if (imageRow) {
+                const int left = imageRow[std::max(x - 1, 0)];
+                const int right = imageRow[std::min(x + 1, image.cols - 1)];
+                rowTexture += std::abs(right - left) + std::abs(imageDown[x] - imageUp[x]);
+            }
+        }
+        moments.count += rowCount;
+        moments.sumMagnitude += rowMag;
+        moments.sumU += rowU;
+        moments.sumV += rowV;
+        moments.sumRx += rowX;
+        moments.sumRy += ry * rowCount;
+        moments.sumCross += rowXV - ry * rowU;
+        moments.sumR2 += rowX2 + ry * ry * rowCount;
+        moments.sumSquares += rowSquares;
+        if (imageRow) {
+            // Central differences span two pixels
+            moments.sumTexture += 0.5 * rowTexture;
+            moments.textureCount += rowCount;
+        }
+    }
+}
+
+FlowMeasurement reduceFlow(const cv::Mat& flow) {
+    FlowMoments moments;
+    accumulateFlow(flow, cv::Point(0, 0), flow.size(), 1, cv::Mat(), moments);
+    return moments.toMeasurement();
+}
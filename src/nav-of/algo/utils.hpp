@@ -1,3 +1,74 @@
 #pragma once
+#include <opencv2/core.hpp>
+#include "../core/IFlowBackend.hpp"
 
-float calculateMetricScale(float altitude, float fovDeg, int imageHeight);
\ No newline at end of file
+float calculateMetricScale(float altitude, float fovDeg, int imageHeight);
+
+/**
+ * @brief Resizes a backend's previous frame to the current frame size after a change of the analysis scale
+ *
+ * The frame pair is then measured at the new scale instead of priming the backend again
+ * (which would drop a measurement on every scale switch).
+ */
+void rescaleFrame(cv::Mat& frame, const cv::Size& size);
+
+/**
+ * @brief Sums over flow samples, coordinates relative to the frame center
+ *
+ * Sums of several regions of the same frame add up, so a frame can be reduced
+ * region by region.
+ */
+struct FlowMoments {
+    double count = 0.0;
+    double sumMagnitude = 0.0;
+    double sumU = 0.0;
+    double sumV = 0.0;
+    double sumRx = 0.0;
+    double sumRy = 0.0;
+    double sumCross = 0.0;  // sum(rx * v - ry * u)
+    double sumR2 = 0.0;     // sum(rx^2 + ry^2)
+    double sumSquares = 0.0;  // sum(u^2 + v^2)
+    double sumTexture = 0.0;  // sum of the image gradient magnitude (L1) at the samples
+    double textureCount = 0.0;
+
+    /**
+     * @brief Average magnitude, mean flow vector and the least-squares rotation
+     *        about the centroid of the samples (small-angle model: flow = t + rotation * (-ry, rx))
+     *
+     * The confidence combines the residual of that rigid model (independently
+     * moving objects, parallax, noise) relative to the flow magnitude with the
+     * image texture (flow over water, sky or motion blur is unreliable); without
+     * texture samples only the residual counts.
+     * hasDirection stays false if no sample was added.
+     */
+    FlowMeasurement toMeasurement() const;
+};
+
+/**
+ * @brief Adds the samples of a CV_32FC2 flow field in a single pass
+ *
+ * @param flow Flow of a region of the frame
+ * @param origin Position of the region in the frame
+ * @param frameSize Size of the whole frame (defines the center)
+ * @param stride Only pixels whose frame coordinates are multiples of stride are sampled
+ * @param mask Optional CV_8UC1 mask of the region, only nonzero pixels are sampled
+ * @param moments Sums to add to
+ * @param image Optional CV_8UC1 frame region the flow starts from; its gradient at the
+ *        samples is added as texture
+ */
+void accumulateFlow(const cv::Mat& flow, const cv::Point& origin, const cv::Size& frameSize,
+                    int stride, const cv::Mat& mask, FlowMoments& moments, const cv::Mat& image = cv::Mat());
+
+/**
+ * @brief Confidence of a flow measurement (0-1)
+ *
+ * @param residualRms RMS deviation of the flow from the fitted image motion in pixels
+ * @param magnitude Average flow magnitude in pixels
+ * @param texture Mean image gradient (L1, gray levels per pixel), negative if unknown
+ */
+float flowConfidence(double residualRms, double magnitude, double texture);
+
+/**
+ * @brief Reduces a whole CV_32FC2 flow field in a single pass
+ */
+FlowMeasurement reduceFlow(const cv::Mat& flow);
@@ -0,0 +1,88 @@
+#include "FlowBackendFactory.hpp"
+#include "../algo/dis_cpu.hpp"
+#include "../algo/farneback_cpu.hpp"
+#include "../algo/horn_schunck_cpu.hpp"
+#include "../algo/lk_sparse.hpp"
+#ifdef FLORA_USE_CUDA
+#include "../algo/farneback_gpu.hpp"
+#include <opencv2/core/cuda.hpp>
+#endif
+
+bool parseFlowBackendType(const std::string& name, FlowBackendType& type) {
+    if (name == "auto") {
+        type = FlowBackendType::AUTO;
+    } else if (name == "farneback-gpu") {
+        type = FlowBackendType::FARNEBACK_GPU;
+    } else if (name == "farneback-cpu") {
+        type = FlowBackendType::FARNEBACK_CPU;
+    } else if (name == "dis-cpu") {
+        type = FlowBackendType::DIS_CPU;
+    } else if (name == "hs-cpu") {
+        type = FlowBackendType::HORN_SCHUNCK_CPU;
+    } else if (name == "lk-sparse") {
+        type = FlowBackendType::LK_SPARSE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool isFlowBackendAvailable(FlowBackendType type) {
+    switch (type) {
+        case FlowBackendType::FARNEBACK_GPU:
+#ifdef FLORA_USE_CUDA
+            return cv::cuda::getCudaEnabledDeviceCount() > 0;
+#else
+            return false;
+#endif
+        case FlowBackendType::AUTO:
+        case FlowBackendType::FARNEBACK_CPU:
+        case FlowBackendType::DIS_CPU:
+        case FlowBackendType::HORN_SCHUNCK_CPU:
+        case FlowBackendType::LK_SPARSE:
+            return true;
+    }
+    return false;
+}
+
+FlowBackendType resolveFlowBackendType(FlowBackendType type) {
+    if (type == FlowBackendType::AUTO) {
+        return isFlowBackendAvailable(FlowBackendType::FARNEBACK_GPU) ? FlowBackendType::FARNEBACK_GPU
+                                                                       : FlowBackendType::FARNEBACK_CPU;
+    }
+    return type;
+}
+
+int getFlowBackendConcurrency(FlowBackendType type) {
+    switch (resolveFlowBackendType(type)) {
+        case FlowBackendType::FARNEBACK_GPU:
+            // Every backend runs on the current (default) CUDA device, so concurrent flights would only
+            // queue up on it
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+std::unique_ptr<IFlowBackend> createFlowBackend(FlowBackendType type) {
+    type = resolveFlowBackendType(type);
+
+    if (!isFlowBackendAvailable(type)) return nullptr;
+
+    switch (type) {
+#ifdef FLORA_USE_CUDA
+        case FlowBackendType::FARNEBACK_GPU:
+            return std::make_unique<FarnebackGpuBackend>();
+#endif
+        case FlowBackendType::FARNEBACK_CPU:
+            return std::make_unique<FarnebackCpuBackend>();
+        case FlowBackendType::DIS_CPU:
+            return std::make_unique<DisCpuBackend>();
+        case FlowBackendType::HORN_SCHUNCK_CPU:
+            return std::make_unique<HornSchunckCpuBackend>();
+        case FlowBackendType::LK_SPARSE:
+            return std::make_unique<SparseLkBackend>();
+        default:
+            return nullptr;
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <memory>
+#include <string>
+#include "IFlowBackend.hpp"
+
+enum class FlowBackendType {
+    AUTO = 0,
+    FARNEBACK_GPU,
+    FARNEBACK_CPU,
+    DIS_CPU,
+    HORN_SCHUNCK_CPU,
+    LK_SPARSE
+};
+
+/**
+ * @brief Parses a backend name ("auto", "farneback-gpu", "farneback-cpu", "dis-cpu", "hs-cpu", "lk-sparse")
+ *
+ * @param name Backend name
+ * @param type Parsed backend type
+ * @return true if the name is known
+ */
+bool parseFlowBackendType(const std::string& name, FlowBackendType& type);
+
+/**
+ * @brief Checks if the backend was compiled in and can run on this host
+ */
+bool isFlowBackendAvailable(FlowBackendType type);
+
+/**
+ * @brief Resolves AUTO to the backend createFlowBackend selects on this host
+ */
+FlowBackendType resolveFlowBackendType(FlowBackendType type);
+
+/**
+ * @brief Maximum number of backend instances worth running at the same time
+ *
+ * GPU backends are limited to one instance (all instances would share the
+ * default CUDA device), CPU backends return 0 (bounded by the CPU cores only).
+ */
+int getFlowBackendConcurrency(FlowBackendType type);
+
+/**
+ * @brief Creates a flow backend
+ *
+ * AUTO selects the CUDA Farneback when a CUDA device is present and falls
+ * back to the CPU Farneback (same algorithm and parameters) otherwise.
+ *
+ * @param type Requested backend
+ * @return Backend instance or nullptr if the backend is not available
+ */
+std::unique_ptr<IFlowBackend> createFlowBackend(FlowBackendType type);
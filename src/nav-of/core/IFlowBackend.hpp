@@ -0,0 +1,83 @@
+#pragma once
+#include <vector>
+#include <opencv2/core.hpp>
+
+/**
+ * @brief Flow between two frames reduced to a few numbers, in pixels of the resized frame
+ */
+struct FlowMeasurement {
+    float avgMagnitude = 0.0f;   // Average flow magnitude
+    float dx = 0.0f;             // Image translation, x to the right
+    float dy = 0.0f;             // Image translation, y downwards
+    float rotation = 0.0f;       // Image rotation about the frame center in radians, clockwise on screen
+    bool hasDirection = false;   // dx, dy and rotation are set
+    float confidence = 1.0f;     // 0-1: texture and agreement of the flow with a rigid image motion
+    int frameHeight = 0;         // Height of the resized frame the pixels refer to
+    double interval = 0.0;       // Seconds between the two frames (0 = one nominal frame)
+};
+
+/**
+ * @brief Part of the resized frame a backend evaluates
+ *
+ * Dense backends compute flow only inside the regions (each grown by margin
+ * pixels so the flow at the region border is not cut off) and reduce only the
+ * samples that lie inside the mask and on the stride grid. The sparse backend
+ * detects corners inside the mask only. An empty sampling covers the whole frame.
+ */
+struct FlowSampling {
+    cv::Size frameSize;              // Resized frame size the sampling was built for
+    std::vector<cv::Rect> regions;   // Disjoint rectangles where flow is computed
+    cv::Mat mask;                    // CV_8UC1 at frameSize, nonzero pixels enter the reduction
+    int stride = 1;                  // Every stride-th pixel in x and y enters the reduction
+    int margin = 8;                  // Context in pixels added around every region
+
+    /**
+     * @brief true if the sampling applies to frames of the given size
+     */
+    bool appliesTo(const cv::Size& size) const { return !regions.empty() && frameSize == size; }
+};
+
+/**
+ * @brief Stateful dense optical flow engine used by OpticalFlowProcessor
+ *
+ * A backend keeps its algorithm instance, working buffers and the previous
+ * downscaled frame between calls, so every new frame costs one resize and one
+ * flow computation. Flow is reduced to the average flow magnitude in pixels of
+ * the downscaled frame, the mean translation and the rotation of the frame.
+ */
+class IFlowBackend {
+public:
+    virtual ~IFlowBackend() = default;
+
+    /**
+     * @brief Short backend identifier (as accepted on the command line)
+     */
+    virtual const char* getName() const = 0;
+
+    /**
+     * @brief Feeds the next grayscale frame and computes flow against the previous one
+     *
+     * @param frame Current grayscale frame (CV_8UC1)
+     * @param scaledHeight Height the frame is resized to before computing flow
+     * @param measurement Flow measurement in pixels of the resized frame
+     * @return true if a measurement was produced (false for the first frame or after reset)
+     */
+    virtual bool process(const cv::Mat& frame, int scaledHeight, FlowMeasurement& measurement) = 0;
+
+    /**
+     * @brief Drops the stored previous frame (next call only primes the backend)
+     */
+    virtual void reset() = 0;
+
+    /**
+     * @brief Restricts the flow evaluation to part of the frame
+     *
+     * Ignored for frames whose resized size differs from sampling.frameSize.
+     */
+    virtual void setSampling(const FlowSampling& sampling) { sampling_ = sampling; }
+
+    const FlowSampling& getSampling() const { return sampling_; }
+
+protected:
+    FlowSampling sampling_;
+};
@@ -1,15 +1,177 @@
 #include "OpticalFlowProcessor.hpp"
-#include "../algo/horn_schunck.hpp"
-#include "../algo/farneback_gpu.hpp"
+#include "FlowBackendFactory.hpp"
 #include "../algo/utils.hpp"
+#include <algorithm>
 #include <cmath>
+#include <iostream>
+#include <sstream>
 #include <opencv2/imgproc.hpp>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
-OpticalFlowProcessor::OpticalFlowProcessor() {}
+namespace {
+
+// Smallest image shift (analysis pixels per frame) whose direction updates the heading
+const float MIN_DIRECTION_SHIFT_PX = 0.1f;
+
+// Adaptive scale: coarsest analysis height and the displacement per frame the flow backends
+// resolve best (sub-pixel motion is lost in noise, large motion needs the coarse pyramid levels)
+const int MIN_SCALED_HEIGHT_PX = 90;
+const double MIN_DISPLACEMENT_PX = 1.5;
+const double MAX_DISPLACEMENT_PX = 8.0;
+
+// Frame step: largest displacement per measurement (pixels of the analysed frame)
+const double MAX_STEP_DISPLACEMENT_PX = 8.0;
+
+// Granularity of the flow sampling: tiles without a single sampled pixel are skipped
+const int SAMPLING_TILE_PX = 32;
+
+} // namespace
+
+bool parseFlowRegion(const std::string& text, cv::Rect2f& region) {
+    std::istringstream in(text);
+    float values[4];
+    char separator = ',';
+    for (int i = 0; i < 4; ++i) {
+        if (i > 0 && (!(in >> separator) || separator != ',')) return false;
+        if (!(in >> values[i])) return false;
+    }
+    if (!(in >> std::ws).eof()) return false;
+
+    region = cv::Rect2f(values[0], values[1], values[2], values[3]);
+    return region.x >= 0.0f && region.y >= 0.0f && region.width > 0.0f && region.height > 0.0f
+        && region.x + region.width <= 1.0f && region.y + region.height <= 1.0f;
+}
+
+OpticalFlowProcessor::OpticalFlowProcessor()
+    : scalePolicy_(analysisHeight_, MIN_SCALED_HEIGHT_PX, MIN_DISPLACEMENT_PX, MAX_DISPLACEMENT_PX)
+    , stepPolicy_(1, MAX_STEP_DISPLACEMENT_PX)
+    , flowBackend_(createFlowBackend(FlowBackendType::AUTO)) {}
+
+void OpticalFlowProcessor::setAdaptiveScale(bool enabled) {
+    adaptiveScale_ = enabled;
+    scalePolicy_.reset();
+    scaledHeight_.store(scalePolicy_.getHeight(), std::memory_order_relaxed);
+}
+
+void OpticalFlowProcessor::setFlowBackend(std::unique_ptr<IFlowBackend> backend) {
+    flowBackend_ = std::move(backend);
+    samplingChanged_ = true;
+}
+
+void OpticalFlowProcessor::setMaxFrameStep(int maxStep) {
+    stepPolicy_.setMaxStep(maxStep);
+    frameStep_.store(stepPolicy_.getStep(), std::memory_order_relaxed);
+}
+
+bool OpticalFlowProcessor::acceptFrame() {
+    if (++framesSinceAccepted_ < frameStep_.load(std::memory_order_relaxed)) return false;
+    framesSinceAccepted_ = 0;
+    return true;
+}
+
+void OpticalFlowProcessor::setFlowRegions(const std::vector<cv::Rect2f>& regions) {
+    flowRegions_ = regions;
+    samplingChanged_ = true;
+}
+
+void OpticalFlowProcessor::setFlowMask(const cv::Mat& mask) {
+    flowMask_ = mask;
+    samplingChanged_ = true;
+}
+
+void OpticalFlowProcessor::setSampleStride(int stride) {
+    sampleStride_ = stride > 1 ? stride : 1;
+    samplingChanged_ = true;
+}
+
+void OpticalFlowProcessor::updateSampling(const cv::Size& size) {
+    if (!samplingChanged_ && samplingSize_ == size) return;
+    samplingChanged_ = false;
+    samplingSize_ = size;
+
+    FlowSampling sampling;
+    if (flowRegions_.empty() && flowMask_.empty() && sampleStride_ == 1) {
+        flowBackend_->setSampling(sampling);
+        return;
+    }
+    sampling.frameSize = size;
+    sampling.stride = sampleStride_;
+
+    // Sampled pixels: inside any region and not masked out
+    const cv::Rect frameRect(cv::Point(0, 0), size);
+    if (flowRegions_.empty()) {
+        sampling.mask = cv::Mat(size, CV_8UC1, cv::Scalar(255));
+    } else {
+        sampling.mask = cv::Mat::zeros(size, CV_8UC1);
+        for (const cv::Rect2f& region : flowRegions_) {
+            const cv::Rect pixels = cv::Rect(cvRound(region.x * size.width), cvRound(region.y * size.height),
+                                             cvRound(region.width * size.width), cvRound(region.height * size.height))
+                                    & frameRect;
+            if (!pixels.empty()) sampling.mask(pixels).setTo(cv::Scalar(255));
+        }
+    }
+    if (!flowMask_.empty()) {
+        cv::Mat scaledMask;
+        cv::resize(flowMask_, scaledMask, size, 0, 0, cv::INTER_NEAREST);
+        cv::compare(scaledMask, 0, scaledMask, cv::CMP_GT);
+        cv::bitwise_and(sampling.mask, scaledMask, sampling.mask);
+    }
+
+    // Tiles holding sampled pixels, merged into runs along each tile row; a run
+    // that continues a run of the same columns in the row above extends it
+    std::vector<size_t> previousRow;
+    std::vector<size_t> currentRow;
+    for (int tileY = 0; tileY < size.height; tileY += SAMPLING_TILE_PX) {
+        const int tileHeight = std::min(SAMPLING_TILE_PX, size.height - tileY);
+        currentRow.clear();
+        int runStart = -1;
+        const int tilesX = (size.width + SAMPLING_TILE_PX - 1) / SAMPLING_TILE_PX;
+        for (int tile = 0; tile <= tilesX; ++tile) {
+            // One step past the last tile closes an open run
+            const int tileX = std::min(tile * SAMPLING_TILE_PX, size.width);
+            bool active = false;
+            if (tile < tilesX) {
+                const cv::Rect tileRect(tileX, tileY, std::min(SAMPLING_TILE_PX, size.width - tileX), tileHeight);
+                active = cv::countNonZero(sampling.mask(tileRect)) > 0;
+            }
+            if (active && runStart < 0) {
+                runStart = tileX;
+            } else if (!active && runStart >= 0) {
+                const cv::Rect run(runStart, tileY, tileX - runStart, tileHeight);
+                runStart = -1;
+
+                size_t index = sampling.regions.size();
+                for (size_t above : previousRow) {
+                    const cv::Rect& region = sampling.regions[above];
+                    if (region.x == run.x && region.width == run.width) {
+                        index = above;
+                        break;
+                    }
+                }
+                if (index < sampling.regions.size()) {
+                    sampling.regions[index].height += run.height;
+                } else {
+                    sampling.regions.push_back(run);
+                }
+                currentRow.push_back(index);
+            }
+        }
+        std::swap(previousRow, currentRow);
+    }
+
+    if (sampling.regions.empty()) {
+        std::cerr << "Warning: Flow regions and mask leave no pixel of the frame, using the whole frame." << std::endl;
+        sampling = FlowSampling();
+    }
+    flowBackend_->setSampling(sampling);
+}
+
+void OpticalFlowProcessor::setFlowThreads(int threads) {
+    cv::setNumThreads(threads > 0 ? threads : cv::getNumberOfCPUs());
+}
 
 void OpticalFlowProcessor::setCameraParams(double focalLength, const std::pair<int, int>& resolution) {
     focalLengthMm_ = static_cast<float>(focalLength);
@@ -25,32 +187,117 @@ float OpticalFlowProcessor::getFrameRate() const {
 }
 
 bool OpticalFlowProcessor::update(const cv::Mat& frame, double altitude) {
-    if (frame.empty() || focalLengthMm_ == 0.0f || imageHeight_ == 0 || fps_ <= 0.0f) return false;
+    if (!isConfigured()) return false;
+
+    // Skipped frames keep the last estimate
+    const double frameTime = updateFrames_++ / static_cast<double>(fps_);
+    if (!acceptFrame()) return true;
+
+    FlowMeasurement measurement;
+    if (!prepareFrame(frame, small_)) return false;
+    if (!measureFlow(small_, frameTime, measurement)) return false;
+    return applyFlow(measurement, altitude);
+}
+
+bool OpticalFlowProcessor::prepareFrame(const cv::Mat& frame, cv::Mat& small) {
+    if (frame.empty()) return false;
+
+    // Downscale first: the grayscale conversion then touches ~1/9 of the pixels of a 1080p frame.
+    // Both steps are linear, so the result approximately matches converting at full resolution
+    // (up to the uint8 rounding of the intermediate image and the INTER_LINEAR decimation).
+    const int scaledHeight = getScaledHeight();
+    int scaledWidth = static_cast<int>(frame.cols * (scaledHeight / static_cast<float>(frame.rows)));
+    cv::Size scaledSize(scaledWidth, scaledHeight);
+
+    if (frame.channels() == 1) {
+        if (frame.size() == scaledSize) {
+            frame.copyTo(small);
+        } else {
+            cv::resize(frame, small, scaledSize);
+        }
+        return true;
+    }
+
+    cv::resize(frame, smallColor_, scaledSize);
+    cv::cvtColor(smallColor_, small, cv::COLOR_BGR2GRAY);
+    return true;
+}
 
-    cv::Mat gray;
-    cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+bool OpticalFlowProcessor::measureFlow(const cv::Mat& small, double frameTime, FlowMeasurement& measurement) {
+    if (small.empty() || !flowBackend_) return false;
 
-    if (!hasPrev_) {
-        prevGray_ = gray.clone();
-        hasPrev_ = true;
-        return false;
+    // Frames prepared before a scale change are resized by the backend, the sampling
+    // follows the size the backend works at
+    const int scaledHeight = getScaledHeight();
+    const int scaledWidth = static_cast<int>(small.cols * (scaledHeight / static_cast<float>(small.rows)));
+    updateSampling(cv::Size(scaledWidth, scaledHeight));
+
+    // Every call makes the frame the backend's previous one, measured or not
+    const double previousTime = lastFlowTime_;
+    lastFlowTime_ = frameTime;
+
+    if (!flowBackend_->process(small, scaledHeight, measurement)) return false;
+    measurement.frameHeight = scaledHeight;
+    measurement.interval = previousTime >= 0.0 && frameTime > previousTime ? frameTime - previousTime : 0.0;
+    return true;
+}
+
+bool OpticalFlowProcessor::applyFlow(const FlowMeasurement& measurement, double altitude) {
+    if (!isConfigured()) return false;
+
+    int scaledDiagonal = static_cast<int>(std::sqrt(analysisWidth_ * analysisWidth_ + analysisHeight_ * analysisHeight_));
+    float baseMetricScale = calculateMetricScale(altitude, focalLengthMm_, scaledDiagonal);
+
+    // Pixels of a reduced analysis frame cover proportionally more ground
+    float metricScale = baseMetricScale;
+    if (measurement.frameHeight > 0) {
+        metricScale *= analysisHeight_ / static_cast<float>(measurement.frameHeight);
+    }
+
+    // Flow over a frame step is scaled by the time it spans
+    const float interval = measurement.interval > 0.0 ? static_cast<float>(measurement.interval) : 1.0f / fps_;
+    const float rate = 1.0f / interval;
+
+    const double previousSpeed = speed_;
+    float rawSpeed = measurement.avgMagnitude * metricScale * rate;
+    float filteredSpeed = kalman_.update(rawSpeed, measurement.confidence);
+    speed_ = filteredSpeed;
+    confidence_ = measurement.confidence;
+
+    // Expected displacement per frame at the full analysis height
+    const double baseDisplacement = baseMetricScale > 0.0f ? speed_ / (baseMetricScale * fps_) : 0.0;
+
+    if (stepPolicy_.getMaxStep() > 1) {
+        const double displacement = baseDisplacement * getScaledHeight() / analysisHeight_;
+        const int step = stepPolicy_.update(displacement, measurement.rotation / interval,
+                                            (speed_ - previousSpeed) / interval, confidence_);
+        frameStep_.store(step, std::memory_order_relaxed);
     }
 
-    // Zakładamy, że kamera ma poziomy FOV, a przeskalowujemy do 640x360
-    int scaledWidth = 640;
-    int scaledHeight = 360;
-    int scaledDiagonal = static_cast<int>(std::sqrt(scaledWidth * scaledWidth + scaledHeight * scaledHeight));
-    float metricScale = calculateMetricScale(altitude, focalLengthMm_, scaledDiagonal);
+    if (adaptiveScale_) {
+        // The resolution follows the displacement over the whole step
+        const double stepDisplacement = baseDisplacement * getFrameStep();
+        scaledHeight_.store(scalePolicy_.update(stepDisplacement, confidence_), std::memory_order_relaxed);
+    }
+
+    if (!measurement.hasDirection) {
+        currentVelocity_ = Vector3D(filteredSpeed, 0.0, 0.0);
+        return true;
+    }
 
-    float avgMag = computeFarnebackGpuMagnitude(prevGray_, gray, scaledHeight);
+    // The ground moves against the direction of travel: forward flight shifts the image down
+    float forward = kalmanForward_.update(measurement.dy * metricScale * rate, measurement.confidence);
+    float right = kalmanRight_.update(-measurement.dx * metricScale * rate, measurement.confidence);
+    currentVelocity_ = Vector3D(forward, right, 0.0);
 
-    float rawSpeed = avgMag * metricScale * fps_;
-    float filteredSpeed = kalman_.update(rawSpeed);
+    // Below the minimum shift the direction is noise
+    if (std::hypot(measurement.dx, measurement.dy) >= MIN_DIRECTION_SHIFT_PX) {
+        heading_ = std::atan2(right, forward);
+    }
 
-    currentVelocity_ = Vector3D(filteredSpeed, 0.0, 0.0);
-    confidence_ = 1.0;
+    // A clockwise yaw of the camera turns the ground counterclockwise in the image
+    yaw_ -= measurement.rotation;
 
-    prevGray_ = gray.clone();
     return true;
 }
 
@@ -59,7 +306,7 @@ Vector3D OpticalFlowProcessor::getVelocity() const {
 }
 
 double OpticalFlowProcessor::getHeading() const {
-    return 0.0; // do rozbudowy w przyszłości
+    return heading_;
 }
 
 double OpticalFlowProcessor::getConfidenceScore() const {
@@ -1,6 +1,23 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
 #include "IOFProcessor.hpp"
+#include "IFlowBackend.hpp"
+#include "../algo/frame_step_policy.hpp"
 #include "../algo/kalman_filter.hpp"
+#include "../algo/scale_policy.hpp"
+
+/**
+ * @brief Parses a flow region "x,y,w,h" given as fractions (0-1) of the frame width and height
+ *
+ * @param text Region text
+ * @param region Parsed region
+ * @return true if the text holds four numbers describing a non-empty region inside the frame
+ */
+bool parseFlowRegion(const std::string& text, cv::Rect2f& region);
 
 class OpticalFlowProcessor : public IOFProcessor {
 public:
@@ -8,26 +25,197 @@ public:
 
     bool update(const cv::Mat& frame, double altitude) override;
 
+    /**
+     * @brief Filtered ground velocity in the camera frame (x forward = image up, y right) in m/s;
+     *        (speed, 0, 0) if the backend gives no direction
+     */
     Vector3D getVelocity() const override;
+
+    /**
+     * @brief Direction of travel from the image translation in radians, clockwise from the
+     *        top edge of the image (camera frame, not north); 0 if the backend gives no direction
+     */
     double getHeading() const override;
 
+    /**
+     * @brief Filtered ground speed in m/s from the average flow magnitude
+     */
+    double getSpeed() const { return speed_; }
+
+    /**
+     * @brief Camera yaw change since the first frame in radians, clockwise seen from above,
+     *        integrated from the image rotation
+     */
+    double getYaw() const { return yaw_; }
+
     void setCameraParams(double focalLength, const std::pair<int, int>& resolution) override;
     void setFrameRate(float fps) override;
 
     float getFrameRate() const override;
 
+    /**
+     * @brief Confidence of the last measurement (0-1), see FlowMoments::toMeasurement();
+     *        low-confidence measurements move the speed and velocity filters less
+     */
     double getConfidenceScore() const override;
 
+    /**
+     * @brief Replaces the flow backend used for frame-to-frame flow
+     *
+     * @param backend Backend instance (ownership is taken)
+     */
+    void setFlowBackend(std::unique_ptr<IFlowBackend> backend);
+
+    const IFlowBackend* getFlowBackend() const { return flowBackend_.get(); }
+
+    /**
+     * @brief Sets the number of worker threads used by the CPU backends (0 = all cores)
+     *
+     * OpenCV's thread pool is process-wide: call this once before any flow is computed,
+     * not per processor, since concurrent processors share the pool.
+     */
+    static void setFlowThreads(int threads);
+
+    /**
+     * @brief Restricts the flow to regions of the frame
+     *
+     * @param regions Regions as fractions of the frame size (empty = whole frame)
+     */
+    void setFlowRegions(const std::vector<cv::Rect2f>& regions);
+
+    /**
+     * @brief Excludes masked parts of the frame from the flow (sky, gimbal, propellers)
+     *
+     * @param mask CV_8UC1 image of any size, scaled to the analysis frame; zero pixels are excluded
+     *        (empty = no mask)
+     */
+    void setFlowMask(const cv::Mat& mask);
+
+    /**
+     * @brief Reduces the flow of dense backends on every stride-th pixel in x and y only
+     */
+    void setSampleStride(int stride);
+
+    /**
+     * @brief Lets the analysis resolution follow the expected image motion
+     *
+     * Every frame the expected displacement is derived from altitude, filtered
+     * speed and frame rate; AdaptiveScalePolicy then picks the analysis height
+     * between the full analysis height and a quarter of it. Disabled, every
+     * frame is analysed at the full analysis height.
+     */
+    void setAdaptiveScale(bool enabled);
+
+    /**
+     * @brief Allows measuring the flow over up to maxStep frames on calm segments
+     *
+     * FrameStepPolicy picks the step after every measurement; frames in between
+     * are skipped (see acceptFrame()) and the measurement is scaled by the time
+     * between the two frames. 1 measures every frame.
+     */
+    void setMaxFrameStep(int maxStep);
+
+    /**
+     * @brief Frames between two flow measurements currently chosen
+     */
+    int getFrameStep() const { return frameStep_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Decides whether the next frame of the video is analysed
+     *
+     * Call once per decoded frame, in frame order, before the frame is
+     * prepared; skipped frames need neither prepareFrame() nor measureFlow().
+     */
+    bool acceptFrame();
+
+    /**
+     * @brief Full height of the downscaled analysis frame in pixels (width keeps the aspect ratio)
+     */
+    int getAnalysisHeight() const { return analysisHeight_; }
+
+    /**
+     * @brief Height the next frames are analysed at (below getAnalysisHeight() with adaptive scale)
+     */
+    int getScaledHeight() const { return scaledHeight_.load(std::memory_order_relaxed); }
+
+    // Pipeline stages of update(); each may run on its own thread, in this order per frame
+
+    /**
+     * @brief Downscales a frame to the current analysis resolution and converts it to grayscale
+     *
+     * The frame is resized before the color conversion; grayscale input is only resized
+     * (or copied if the decoder already delivered it at the analysis size).
+     * The output buffer is reused if it already has the analysis size.
+     *
+     * @param frame Input BGR or grayscale frame
+     * @param small Output grayscale frame at analysis resolution
+     * @return false if the frame is empty
+     */
+    bool prepareFrame(const cv::Mat& frame, cv::Mat& small);
+
+    /**
+     * @brief Measures the flow against the previous analysis frame
+     *
+     * @param small Grayscale frame produced by prepareFrame()
+     * @param frameTime Presentation time of the frame in seconds
+     * @param measurement Flow measurement in pixels of the analysis frame
+     * @return false for the first frame or if the processor is not configured
+     */
+    bool measureFlow(const cv::Mat& small, double frameTime, FlowMeasurement& measurement);
+
+    /**
+     * @brief Converts a flow measurement to metric velocity and updates the filter
+     *
+     * @param measurement Flow measurement from measureFlow()
+     * @param altitude Altitude above ground in meters
+     * @return false if the processor is not configured
+     */
+    bool applyFlow(const FlowMeasurement& measurement, double altitude);
+
 private:
+    bool isConfigured() const { return focalLengthMm_ != 0.0f && imageHeight_ != 0 && fps_ > 0.0f; }
+
+    void updateSampling(const cv::Size& size);
+
     float focalLengthMm_ = 0.0f;
     int imageHeight_ = 0;
     float fps_ = 30.0f;
 
     Vector3D currentVelocity_ = Vector3D(0.0, 0.0, 0.0);
     double confidence_ = 0.0;
+    double heading_ = 0.0;
+    double speed_ = 0.0;
+    double yaw_ = 0.0;
+
+    // Zakładamy, że kamera ma poziomy FOV, a przeskalowujemy do 640x360
+    const int analysisWidth_ = 640;
+    const int analysisHeight_ = 360;
+
+    // Current analysis height; written by applyFlow(), read by the prepare and flow stages
+    std::atomic<int> scaledHeight_{360};
+    bool adaptiveScale_ = false;
+    AdaptiveScalePolicy scalePolicy_;
+
+    // Frame step; written by applyFlow(), read by acceptFrame() on the decode stage
+    std::atomic<int> frameStep_{1};
+    FrameStepPolicy stepPolicy_;
+    int framesSinceAccepted_ = 0;  // acceptFrame() state
+    double lastFlowTime_ = -1.0;   // measureFlow() state: time of the backend's previous frame
+    int64_t updateFrames_ = 0;     // Frames passed to update(), its frame clock
+
+    cv::Mat smallColor_;  // Downscaled BGR frame, input of the grayscale conversion
+    cv::Mat small_;
+
+    std::unique_ptr<IFlowBackend> flowBackend_;
 
-    cv::Mat prevGray_;
-    bool hasPrev_ = false;
+    // Flow sampling, turned into tiles of the analysis frame when the frame size is known
+    std::vector<cv::Rect2f> flowRegions_;
+    cv::Mat flowMask_;
+    int sampleStride_ = 1;
+    cv::Size samplingSize_;       // Analysis frame size of the sampling passed to the backend
+    bool samplingChanged_ = true;
 
     Kalman1D kalman_;
-};
\ No newline at end of file
+    Kalman1D kalmanForward_;
+    Kalman1D kalmanRight_;
+};
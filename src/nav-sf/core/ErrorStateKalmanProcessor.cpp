@@ -0,0 +1,190 @@
+// ErrorStateKalmanProcessor.cpp
+#include "ErrorStateKalmanProcessor.hpp"
+#include <cmath>
+#include <iostream>
+
+namespace {
+
+double wrapAngle(double angle) {
+    return std::remainder(angle, 2.0 * M_PI);
+}
+
+// The logs hold (0, 0) for rows without a fix (and no fix type or satellite count, so not GPSData::isValid)
+bool hasFix(const GPSData& fix) {
+    return std::fabs(fix.getLatitude()) <= 90.0 && std::fabs(fix.getLongitude()) <= 180.0
+        && (fix.getLatitude() != 0.0 || fix.getLongitude() != 0.0);
+}
+
+} // namespace
+
+ErrorStateKalmanProcessor::ErrorStateKalmanProcessor() {}
+
+GPSData ErrorStateKalmanProcessor::getGPSData() const {
+    if (!gpsDataValid_) {
+        frame_.fromENU(Vector3D(state_(EAST), state_(NORTH), 0.0), gpsData_);
+        gpsData_.setAltitude(state_(ALTITUDE));
+        gpsDataValid_ = true;
+    }
+    return gpsData_;
+}
+
+void ErrorStateKalmanProcessor::initialize(const GPSData& fix, double altitude, double heading, double speed) {
+    gpsData_ = fix;
+    gpsData_.setAltitude(altitude);
+    gpsDataValid_ = true;
+    reanchor();
+
+    state_ << 0.0, 0.0, altitude, speed, wrapAngle(heading), 1.0, 0.0;
+
+    // Speed = flow speed / scale and course = heading - bias start correlated with the scale and bias
+    const double gps = fix.getAccuracy() > 0.0 ? fix.getAccuracy() : noise_.gps;
+    const double scaleVariance = noise_.initialScale * noise_.initialScale;
+    const double biasVariance = noise_.initialHeadingBias * noise_.initialHeadingBias;
+
+    covariance_.setZero();
+    covariance_(EAST, EAST) = gps * gps;
+    covariance_(NORTH, NORTH) = gps * gps;
+    covariance_(ALTITUDE, ALTITUDE) = noise_.altitude * noise_.altitude;
+    covariance_(SPEED, SPEED) = noise_.flowSpeed * noise_.flowSpeed + speed * speed * scaleVariance;
+    covariance_(SPEED, SCALE) = covariance_(SCALE, SPEED) = -speed * scaleVariance;
+    covariance_(SCALE, SCALE) = scaleVariance;
+    covariance_(COURSE, COURSE) = noise_.heading * noise_.heading + biasVariance;
+    covariance_(COURSE, HEADING_BIAS) = covariance_(HEADING_BIAS, COURSE) = -biasVariance;
+    covariance_(HEADING_BIAS, HEADING_BIAS) = biasVariance;
+
+    gpsFixesUsed_ = 0;
+    gpsFixesRejected_ = 0;
+    initialized_ = true;
+}
+
+void ErrorStateKalmanProcessor::predict(double dt) {
+    // Nominal state: the dead reckoning step, the anchor frame's north is turned against the local
+    // north by the meridian convergence
+    const double distance = state_(SPEED) * dt;
+    const double direction = state_(COURSE) + state_(EAST) * convergence_;
+    const double cosDirection = std::cos(direction);
+    const double sinDirection = std::sin(direction);
+    state_(EAST) += distance * cosDirection;
+    state_(NORTH) += distance * sinDirection;
+
+    // Error state transition
+    StateMatrix F = StateMatrix::Identity();
+    F(EAST, SPEED) = dt * cosDirection;
+    F(EAST, COURSE) = -distance * sinDirection;
+    F(NORTH, SPEED) = dt * sinDirection;
+    F(NORTH, COURSE) = distance * cosDirection;
+
+    StateVector Q = StateVector::Zero();
+    Q(ALTITUDE) = noise_.altitudeRandomWalk * noise_.altitudeRandomWalk;
+    Q(SPEED) = noise_.speedRandomWalk * noise_.speedRandomWalk;
+    Q(COURSE) = noise_.courseRandomWalk * noise_.courseRandomWalk;
+    Q(SCALE) = noise_.scaleRandomWalk * noise_.scaleRandomWalk;
+    Q(HEADING_BIAS) = noise_.headingBiasRandomWalk * noise_.headingBiasRandomWalk;
+
+    covariance_ = F * covariance_ * F.transpose();
+    covariance_.diagonal() += Q * dt;
+    gpsDataValid_ = false;
+}
+
+template <int M>
+bool ErrorStateKalmanProcessor::fuse(const Eigen::Matrix<double, M, 1>& innovation,
+                                     const Eigen::Matrix<double, M, STATE_SIZE>& H,
+                                     const Eigen::Matrix<double, M, M>& R,
+                                     double gate) {
+    const Eigen::Matrix<double, STATE_SIZE, M> PHt = covariance_ * H.transpose();
+    const Eigen::Matrix<double, M, M> S = H * PHt + R;
+    const Eigen::Matrix<double, M, M> SInverse = S.inverse();
+    if (gate > 0.0 && innovation.dot(SInverse * innovation) > gate) {
+        return false;
+    }
+
+    const Eigen::Matrix<double, STATE_SIZE, M> K = PHt * SInverse;
+    const StateVector error = K * innovation;
+
+    // Joseph form (I - KH) P (I - KH)^T + K R K^T expanded to rank-M terms, symmetric for any K;
+    // the rounding asymmetry is removed on every update
+    const StateMatrix KPHt = K * PHt.transpose();
+    const StateMatrix updated = covariance_ + K * S * K.transpose() - KPHt - KPHt.transpose();
+    covariance_ = 0.5 * (updated + updated.transpose());
+
+    // Inject the error into the nominal state; the reset is the identity as all errors are additive
+    state_ += error;
+    state_(COURSE) = wrapAngle(state_(COURSE));
+    state_(HEADING_BIAS) = wrapAngle(state_(HEADING_BIAS));
+    gpsDataValid_ = false;
+    return true;
+}
+
+void ErrorStateKalmanProcessor::reanchor() {
+    frame_ = LocalFrame(getGPSData());
+    state_(EAST) = 0.0;
+    state_(NORTH) = 0.0;
+
+    // The error covariance is kept: the new frame is turned by less than 0.01 deg against the old one
+    const double lat = frame_.getReference().getLatitude() * M_PI / 180.0;
+    convergence_ = std::tan(lat) / frame_.getPrimeVerticalRadius();
+}
+
+bool ErrorStateKalmanProcessor::update(GPSData initialGpsData, double altitude, double heading, double speed, double dt) {
+    if (!initialized_) {
+        if (!hasFix(initialGpsData)) {
+            std::cerr << "Error: Initial GPS fix is invalid." << std::endl;
+            return false;
+        }
+        initialize(initialGpsData, altitude, heading, speed);
+        return true;
+    }
+
+    if (altitude <= 0.0) return false;
+
+    predict(dt);
+
+    // Flow speed = scale * speed
+    Eigen::Matrix<double, 1, STATE_SIZE> H = Eigen::Matrix<double, 1, STATE_SIZE>::Zero();
+    H(0, SPEED) = state_(SCALE);
+    H(0, SCALE) = state_(SPEED);
+    fuse<1>(Eigen::Matrix<double, 1, 1>(speed - state_(SCALE) * state_(SPEED)), H,
+            Eigen::Matrix<double, 1, 1>(noise_.flowSpeed * noise_.flowSpeed), 0.0);
+
+    // Heading = course + bias
+    if (speed >= MIN_HEADING_SPEED_MPS) {
+        H.setZero();
+        H(0, COURSE) = 1.0;
+        H(0, HEADING_BIAS) = 1.0;
+        fuse<1>(Eigen::Matrix<double, 1, 1>(wrapAngle(heading - state_(COURSE) - state_(HEADING_BIAS))), H,
+                Eigen::Matrix<double, 1, 1>(noise_.heading * noise_.heading), 0.0);
+    }
+
+    // Altitude
+    H.setZero();
+    H(0, ALTITUDE) = 1.0;
+    fuse<1>(Eigen::Matrix<double, 1, 1>(altitude - state_(ALTITUDE)), H,
+            Eigen::Matrix<double, 1, 1>(noise_.altitude * noise_.altitude), 0.0);
+
+    if (state_(EAST) * state_(EAST) + state_(NORTH) * state_(NORTH) > REANCHOR_DISTANCE_M * REANCHOR_DISTANCE_M) {
+        reanchor();
+    }
+    return true;
+}
+
+bool ErrorStateKalmanProcessor::correct(const GPSData& fix) {
+    if (!initialized_ || !hasFix(fix)) return false;
+
+    // Horizontal position of the fix in the anchor frame
+    Vector3D enu = frame_.toENU(fix.getLatitude(), fix.getLongitude(), frame_.getReference().getAltitude());
+    Eigen::Matrix<double, 2, 1> innovation(enu.getX() - state_(EAST), enu.getY() - state_(NORTH));
+
+    Eigen::Matrix<double, 2, STATE_SIZE> H = Eigen::Matrix<double, 2, STATE_SIZE>::Zero();
+    H(0, EAST) = 1.0;
+    H(1, NORTH) = 1.0;
+
+    const double sigma = fix.getAccuracy() > 0.0 ? fix.getAccuracy() : noise_.gps;
+    const Eigen::Matrix<double, 2, 2> R = Eigen::Matrix<double, 2, 2>::Identity() * (sigma * sigma);
+
+    if (!fuse<2>(innovation, H, R, GPS_GATE)) {
+        gpsFixesRejected_++;
+        return false;
+    }
+    gpsFixesUsed_++;
+    return true;
+}
@@ -0,0 +1,148 @@
+// ErrorStateKalmanProcessor.hpp
+#pragma once
+
+#include <Eigen/Dense>
+#include "../../nav-dr/core/IDRProcessor.hpp"
+#include "../../nav-dr/sensors/LocalFrame.hpp"
+
+/**
+ * @brief Error-state Kalman filter fusing optical flow speed, heading, altitude and intermittent GPS fixes
+ *
+ * The nominal state (position in a local ENU frame, altitude, ground speed, course, flow speed scale and
+ * heading bias) is propagated with the dead reckoning kinematics. The filter tracks the error of that
+ * state; each update estimates the error, injects it into the nominal state and resets it to zero.
+ *
+ * Measurements (angles counterclockwise from east in radians, as in DeadReckoningProcessor):
+ *  - flow speed = scale * ground speed
+ *  - heading    = course + heading bias (skipped below MIN_HEADING_SPEED_MPS)
+ *  - altitude   = altitude
+ *  - GPS fix    = east and north of the fix in the local frame (correct())
+ *
+ * All vectors and matrices are fixed-size Eigen types, so update() and correct() do not allocate.
+ */
+class ErrorStateKalmanProcessor : public IDRProcessor {
+public:
+    static constexpr int STATE_SIZE = 7;
+
+    using StateVector = Eigen::Matrix<double, STATE_SIZE, 1>;
+    using StateMatrix = Eigen::Matrix<double, STATE_SIZE, STATE_SIZE>;
+
+    /**
+     * @brief Indexes of the (nominal and error) state
+     */
+    enum StateIndex {
+        EAST = 0,       // m, in the local frame
+        NORTH,          // m, in the local frame
+        ALTITUDE,       // m
+        SPEED,          // ground speed, m/s
+        COURSE,         // direction of motion, rad
+        SCALE,          // flow speed / ground speed
+        HEADING_BIAS    // heading measurement - course, rad
+    };
+
+    // The local frame moves to the current position once it is this far away (see DeadReckoningProcessor)
+    static constexpr double REANCHOR_DISTANCE_M = 1000.0;
+
+    // The logged heading is the direction of a velocity that is mostly noise when hovering
+    static constexpr double MIN_HEADING_SPEED_MPS = 0.5;
+
+    // GPS fixes farther than this squared Mahalanobis distance are rejected (chi-square, 2 DOF, 99.9%)
+    static constexpr double GPS_GATE = 13.82;
+
+    /**
+     * @brief Noise model (standard deviations)
+     */
+    struct Noise {
+        // Process noise, growth per square root of a second
+        double speedRandomWalk = 0.5;           // m/s
+        double courseRandomWalk = 0.05;         // rad
+        double altitudeRandomWalk = 0.5;        // m
+        double scaleRandomWalk = 0.001;
+        double headingBiasRandomWalk = 0.0005;  // rad
+
+        // Measurement noise
+        double flowSpeed = 0.5;   // m/s
+        double heading = 0.05;    // rad
+        double altitude = 0.5;    // m
+        double gps = 3.0;         // m, for fixes without an accuracy estimate
+
+        // Initial uncertainty of the states that are not measured directly
+        double initialScale = 0.1;
+        double initialHeadingBias = 0.1;  // rad
+    };
+
+    ErrorStateKalmanProcessor();
+
+    /**
+     * @brief Current position; the ENU position is converted to geodetic coordinates here,
+     *        at most once per update
+     */
+    GPSData getGPSData() const override;
+
+    /**
+     * @brief Predicts over dt and fuses the speed, heading and altitude measurements
+     *
+     * The first call initializes the filter at initialGpsData; later calls ignore it (see correct()).
+     *
+     * @return false for an invalid initial fix or a non-positive altitude (the state is kept)
+     */
+    bool update(GPSData initialGpsData, double altitude, double heading, double speed, double dt) override;
+
+    /**
+     * @brief Fuses a GPS fix (its accuracy is used as the standard deviation when set)
+     *
+     * @return false before the first update or if the fix fails the innovation gate
+     */
+    bool correct(const GPSData& fix) override;
+
+    /**
+     * @brief Sets the noise model (call before the first update)
+     */
+    void setNoise(const Noise& noise) { noise_ = noise; }
+
+    const Noise& getNoise() const { return noise_; }
+
+    bool isInitialized() const { return initialized_; }
+
+    const StateVector& getState() const { return state_; }
+
+    const StateMatrix& getCovariance() const { return covariance_; }
+
+    const LocalFrame& getFrame() const { return frame_; }
+
+    int getGpsFixesUsed() const { return gpsFixesUsed_; }
+
+    int getGpsFixesRejected() const { return gpsFixesRejected_; }
+
+private:
+    void initialize(const GPSData& fix, double altitude, double heading, double speed);
+
+    void predict(double dt);
+
+    /**
+     * @brief Kalman update with the innovation of M measurements, injects the error and resets it
+     *
+     * @param gate Maximum squared Mahalanobis distance of the innovation (<= 0: no gate)
+     * @return false if the innovation fails the gate (nothing is changed)
+     */
+    template <int M>
+    bool fuse(const Eigen::Matrix<double, M, 1>& innovation,
+              const Eigen::Matrix<double, M, STATE_SIZE>& H,
+              const Eigen::Matrix<double, M, M>& R,
+              double gate);
+
+    void reanchor();
+
+    Noise noise_;
+    StateVector state_ = StateVector::Zero();
+    StateMatrix covariance_ = StateMatrix::Zero();
+    bool initialized_ = false;
+
+    LocalFrame frame_;
+    double convergence_ = 0.0;  // Meridian convergence per meter east of the anchor, rad/m
+
+    mutable GPSData gpsData_;
+    mutable bool gpsDataValid_ = true;  // gpsData_ matches the ENU position
+    int gpsFixesUsed_ = 0;
+    int gpsFixesRejected_ = 0;
+};
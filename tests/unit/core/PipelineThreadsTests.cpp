@@ -0,0 +1,49 @@
+// tests/unit/core/PipelineThreadsTests.cpp
+#include <gtest/gtest.h>
+#include "core/pipeline/PipelineThreads.hpp"
+#include "core/pipeline/SpscRingBuffer.hpp"
+#include <atomic>
+#include <stdexcept>
+
+// Test that join raises the stop flag and waits for a stage blocked on a full buffer
+TEST(PipelineThreadsTest, JoinStopsBlockedStage) {
+    std::atomic<bool> stop(false);
+    SpscRingBuffer<int> buffer(2);
+    std::atomic<int> pushed(0);
+
+    PipelineThreads stages(stop);
+    stages.start([&]() {
+        for (int i = 0; ; ++i) {
+            if (!buffer.push(i, stop)) return;
+            pushed++;
+        }
+    });
+    EXPECT_EQ(stages.size(), 1u);
+
+    while (pushed < 2) std::this_thread::yield();
+    stages.join();
+    EXPECT_TRUE(stop.load());
+    EXPECT_EQ(stages.size(), 0u);
+    EXPECT_EQ(pushed.load(), 2);
+}
+
+// Test that an exception leaving the consumer joins the stages instead of terminating
+TEST(PipelineThreadsTest, JoinsOnException) {
+    std::atomic<bool> stop(false);
+    SpscRingBuffer<int> buffer(2);
+    std::atomic<bool> finished(false);
+
+    try {
+        PipelineThreads stages(stop);
+        stages.start([&]() {
+            int value = 0;
+            while (buffer.push(value, stop)) value++;
+            finished = true;
+        });
+        throw std::runtime_error("consumer failed");
+    } catch (const std::runtime_error&) {
+    }
+
+    EXPECT_TRUE(stop.load());
+    EXPECT_TRUE(finished.load());
+}
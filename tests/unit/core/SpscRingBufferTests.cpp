@@ -0,0 +1,103 @@
+// tests/unit/core/SpscRingBufferTests.cpp
+#include <gtest/gtest.h>
+#include "core/pipeline/SpscRingBuffer.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// Test capacity rounding
+TEST(SpscRingBufferTest, Capacity) {
+    SpscRingBuffer<int> buffer(5);
+    EXPECT_EQ(buffer.capacity(), 8u);
+    EXPECT_TRUE(buffer.empty());
+}
+
+// Test FIFO order and full/empty handling without waiting
+TEST(SpscRingBufferTest, TryPushTryPop) {
+    SpscRingBuffer<int> buffer(4);
+
+    for (int i = 0; i < 4; ++i) {
+        int value = i;
+        EXPECT_TRUE(buffer.tryPush(value));
+    }
+    int overflow = 42;
+    EXPECT_FALSE(buffer.tryPush(overflow));
+    EXPECT_EQ(buffer.size(), 4u);
+
+    for (int i = 0; i < 4; ++i) {
+        int value = -1;
+        EXPECT_TRUE(buffer.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    int value = -1;
+    EXPECT_FALSE(buffer.tryPop(value));
+}
+
+// Test that a stopped pipeline releases a waiting consumer
+TEST(SpscRingBufferTest, StopReleasesWaiter) {
+    SpscRingBuffer<int> buffer(2);
+    std::atomic<bool> stop(true);
+
+    int value = 0;
+    EXPECT_FALSE(buffer.pop(value, stop));
+
+    int a = 1, b = 2, c = 3;
+    EXPECT_TRUE(buffer.push(a, stop));
+    EXPECT_TRUE(buffer.push(b, stop));
+    EXPECT_FALSE(buffer.push(c, stop));
+}
+
+// Test ordered transfer between two threads with backpressure
+TEST(SpscRingBufferTest, ProducerConsumer) {
+    const int count = 100000;
+    SpscRingBuffer<int> buffer(16);
+    std::atomic<bool> stop(false);
+
+    std::thread producer([&]() {
+        for (int i = 0; i < count; ++i) {
+            int value = i;
+            buffer.push(value, stop);
+        }
+    });
+
+    long long sum = 0;
+    bool ordered = true;
+    for (int i = 0; i < count; ++i) {
+        int value = -1;
+        ASSERT_TRUE(buffer.pop(value, stop));
+        ordered = ordered && (value == i);
+        sum += value;
+    }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(sum, static_cast<long long>(count) * (count - 1) / 2);
+    EXPECT_TRUE(buffer.empty());
+}
+
+// Test that a parked consumer is woken by the producer and a parked producer by the stop flag
+TEST(SpscRingBufferTest, ParkedWaiterWakes) {
+    SpscRingBuffer<int> buffer(2);
+    std::atomic<bool> stop(false);
+
+    // Long enough for the consumer to spin out and park
+    std::thread producer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        int value = 7;
+        buffer.push(value, stop);
+    });
+    int value = 0;
+    EXPECT_TRUE(buffer.pop(value, stop));
+    EXPECT_EQ(value, 7);
+    producer.join();
+
+    int a = 1, b = 2, c = 3;
+    ASSERT_TRUE(buffer.tryPush(a));
+    ASSERT_TRUE(buffer.tryPush(b));
+    std::thread stopper([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        stop = true;
+    });
+    EXPECT_FALSE(buffer.push(c, stop));
+    stopper.join();
+}
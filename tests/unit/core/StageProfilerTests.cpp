@@ -0,0 +1,91 @@
+// tests/unit/core/StageProfilerTests.cpp
+#include <gtest/gtest.h>
+#include "core/profiling/StageProfiler.hpp"
+#include <chrono>
+#include <sstream>
+#include <string>
+
+// Test that small values are counted exactly
+TEST(StageProfilerTest, HistogramExactRange) {
+    for (uint64_t value = 0; value < LatencyHistogram::SUB_BUCKETS; ++value) {
+        EXPECT_EQ(LatencyHistogram::bucketIndex(value), static_cast<int>(value));
+        EXPECT_EQ(LatencyHistogram::bucketUpperBound(static_cast<int>(value)), value);
+    }
+}
+
+// Test that every bucket covers its values with bounded relative error
+TEST(StageProfilerTest, HistogramBucketResolution) {
+    const uint64_t values[] = {33, 100, 1000, 123456, 987654321, uint64_t(1) << 40, UINT64_MAX};
+    for (uint64_t value : values) {
+        const int index = LatencyHistogram::bucketIndex(value);
+        ASSERT_LT(index, LatencyHistogram::BUCKETS);
+
+        const uint64_t upper = LatencyHistogram::bucketUpperBound(index);
+        EXPECT_GE(upper, value);
+        EXPECT_LE(static_cast<double>(upper - value), value / static_cast<double>(LatencyHistogram::SUB_BUCKETS));
+        if (index > 0) {
+            EXPECT_LT(LatencyHistogram::bucketUpperBound(index - 1), value);
+        }
+    }
+}
+
+// Test percentiles, min, max and mean
+TEST(StageProfilerTest, HistogramPercentiles) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 10000; ++value) {
+        histogram.record(value * 1000);
+    }
+
+    EXPECT_EQ(histogram.getCount(), 10000u);
+    EXPECT_EQ(histogram.getMin(), 1000u);
+    EXPECT_EQ(histogram.getMax(), 10000000u);
+    EXPECT_DOUBLE_EQ(histogram.getMean(), 5000.5 * 1000);
+
+    EXPECT_NEAR(static_cast<double>(histogram.getPercentile(50.0)), 5.0e6, 5.0e6 * 0.04);
+    EXPECT_NEAR(static_cast<double>(histogram.getPercentile(99.0)), 9.9e6, 9.9e6 * 0.04);
+    EXPECT_EQ(histogram.getPercentile(100.0), histogram.getMax());
+    EXPECT_EQ(histogram.getPercentile(0.0), histogram.getMin());
+}
+
+// Test merging and resetting histograms
+TEST(StageProfilerTest, HistogramMergeReset) {
+    LatencyHistogram first;
+    LatencyHistogram second;
+    first.record(10);
+    second.record(1000);
+    second.record(2000);
+
+    first.merge(second);
+    EXPECT_EQ(first.getCount(), 3u);
+    EXPECT_EQ(first.getMin(), 10u);
+    EXPECT_EQ(first.getMax(), 2000u);
+
+    first.reset();
+    EXPECT_EQ(first.getCount(), 0u);
+    EXPECT_EQ(first.getPercentile(50.0), 0u);
+}
+
+// Test scoped timers and the CSV report
+TEST(StageProfilerTest, ScopedTimerAndReport) {
+    StageProfiler profiler({"decode", "flow"});
+    ASSERT_EQ(profiler.getStageCount(), 2);
+
+    for (int i = 0; i < 3; ++i) {
+        ScopedStageTimer timer(profiler, 1);
+    }
+    profiler.record(0, std::chrono::microseconds(250));
+
+    EXPECT_EQ(profiler.getHistogram(0).getCount(), 1u);
+    EXPECT_EQ(profiler.getHistogram(1).getCount(), 3u);
+    EXPECT_NEAR(static_cast<double>(profiler.getHistogram(0).getMax()), 250000.0, 1.0);
+
+    std::ostringstream csv;
+    profiler.writeCsv(csv, 100, 2.0);
+    const std::string text = csv.str();
+    EXPECT_EQ(text.rfind("stage,count,mean_us,p50_us,p99_us,max_us", 0), 0u);
+    EXPECT_NE(text.find("\ndecode,1,250.000,"), std::string::npos);
+    EXPECT_NE(text.find(",100,2.000,50.000\n"), std::string::npos);
+
+    profiler.reset();
+    EXPECT_EQ(profiler.getHistogram(1).getCount(), 0u);
+}
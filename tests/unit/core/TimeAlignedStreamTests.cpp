@@ -0,0 +1,80 @@
+// tests/unit/core/TimeAlignedStreamTests.cpp
+#include <gtest/gtest.h>
+#include "core/sync/TimeAlignedStream.hpp"
+#include "nav-dr/sensors/SensorData.hpp"
+#include <vector>
+
+namespace {
+
+// Stream of GPS samples at the given times, with latitude equal to the timestamp
+TimeAlignedStream<SensorData> makeStream(const std::vector<double>& times, int& reads) {
+    return TimeAlignedStream<SensorData>([times, &reads, index = size_t(0)](SensorData& sample) mutable {
+        if (index >= times.size()) return false;
+        ++reads;
+        double time = times[index++];
+        sample = SensorData(time);
+        sample.setGPSData(GPSData(time, 2.0 * time, 0.0));
+        return true;
+    });
+}
+
+} // namespace
+
+// Test interpolation between bracketing samples
+TEST(TimeAlignedStreamTest, Interpolation) {
+    int reads = 0;
+    TimeAlignedStream<SensorData> stream = makeStream({0.0, 1.0, 3.0}, reads);
+
+    SensorData sample;
+    ASSERT_TRUE(stream.sampleAt(0.25, sample));
+    EXPECT_DOUBLE_EQ(sample.getTimestamp(), 0.25);
+    EXPECT_DOUBLE_EQ(sample.getGPSData().getLatitude(), 0.25);
+    EXPECT_DOUBLE_EQ(sample.getGPSData().getLongitude(), 0.5);
+
+    ASSERT_TRUE(stream.sampleAt(2.0, sample));
+    EXPECT_DOUBLE_EQ(sample.getGPSData().getLatitude(), 2.0);
+
+    ASSERT_TRUE(stream.sampleAt(3.0, sample));
+    EXPECT_DOUBLE_EQ(sample.getGPSData().getLatitude(), 3.0);
+}
+
+// Test times before the first and after the last sample
+TEST(TimeAlignedStreamTest, Bounds) {
+    int reads = 0;
+    TimeAlignedStream<SensorData> stream = makeStream({1.0, 2.0}, reads);
+
+    SensorData sample;
+    ASSERT_TRUE(stream.sampleAt(0.0, sample));
+    EXPECT_DOUBLE_EQ(sample.getGPSData().getLatitude(), 1.0);
+
+    EXPECT_FALSE(stream.sampleAt(2.5, sample));
+}
+
+// Test that an empty stream yields no samples
+TEST(TimeAlignedStreamTest, Empty) {
+    int reads = 0;
+    TimeAlignedStream<SensorData> stream = makeStream({}, reads);
+
+    SensorData sample;
+    EXPECT_FALSE(stream.sampleAt(0.0, sample));
+    EXPECT_EQ(stream.getSamplesRead(), 0);
+}
+
+// Test that every sample is read exactly once, including skipped ones
+TEST(TimeAlignedStreamTest, SinglePass) {
+    std::vector<double> times;
+    for (int i = 0; i < 1000; ++i) times.push_back(i * 0.01);
+
+    int reads = 0;
+    TimeAlignedStream<SensorData> stream = makeStream(times, reads);
+
+    // Query at a lower rate than the stream so most samples are skipped
+    SensorData sample;
+    for (double t = 0.0; t <= 9.99; t += 0.033) {
+        ASSERT_TRUE(stream.sampleAt(t, sample));
+        EXPECT_NEAR(sample.getGPSData().getLatitude(), t, 1e-9);
+    }
+
+    EXPECT_LE(reads, 1000);
+    EXPECT_EQ(stream.getSamplesRead(), reads);
+}
@@ -0,0 +1,123 @@
+// tests/unit/io/CsvReaderTests.cpp
+#include <gtest/gtest.h>
+#include "io/CsvReader.hpp"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+class CsvReaderTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::filesystem::remove(path);
+    }
+
+    void writeFile(const std::string& contents) {
+        std::ofstream file(path, std::ios::binary);
+        file << contents;
+    }
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "flora_csv_reader_test.csv";
+};
+
+// Test header parsing and column lookup
+TEST_F(CsvReaderTest, Header) {
+    writeFile("timestamp,x,y,z,vx,vy\n1,2,3,4,5,6\n");
+
+    CsvReader reader;
+    ASSERT_TRUE(reader.open(path));
+    ASSERT_EQ(reader.getHeader().size(), 6u);
+    EXPECT_EQ(reader.columnIndex("timestamp"), 0);
+    EXPECT_EQ(reader.columnIndex("vx"), 4);
+    EXPECT_EQ(reader.columnIndex("vy"), 5);
+    EXPECT_EQ(reader.columnIndex("missing"), -1);
+}
+
+// Test numeric parsing of rows
+TEST_F(CsvReaderTest, ParseRows) {
+    writeFile("lat,lon,vel_m_s\n522297000,210122000,3.25\n-338688000,1512093000,-1.5e-2\n");
+
+    CsvReader reader;
+    ASSERT_TRUE(reader.open(path));
+
+    int64_t lat = 0, lon = 0;
+    double vel = 0.0;
+
+    ASSERT_TRUE(reader.next());
+    EXPECT_TRUE(reader.getInt64(0, lat));
+    EXPECT_TRUE(reader.getInt64(1, lon));
+    EXPECT_TRUE(reader.getDouble(2, vel));
+    EXPECT_EQ(lat, 522297000);
+    EXPECT_EQ(lon, 210122000);
+    EXPECT_DOUBLE_EQ(vel, 3.25);
+
+    ASSERT_TRUE(reader.next());
+    EXPECT_TRUE(reader.getInt64(0, lat));
+    EXPECT_TRUE(reader.getDouble(2, vel));
+    EXPECT_EQ(lat, -338688000);
+    EXPECT_DOUBLE_EQ(vel, -0.015);
+    EXPECT_EQ(reader.getRowNumber(), 2u);
+
+    EXPECT_FALSE(reader.next());
+}
+
+// Test CRLF endings, empty fields and a last row without newline
+TEST_F(CsvReaderTest, LineEndingsAndEmptyFields) {
+    writeFile("a,b,c\r\n1.5,,abc\r\n\r\n2,3,4");
+
+    CsvReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.columnIndex("c"), 2);
+
+    double value = 0.0;
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(reader.fieldCount(), 3u);
+    EXPECT_TRUE(reader.getDouble(0, value));
+    EXPECT_DOUBLE_EQ(value, 1.5);
+    EXPECT_FALSE(reader.getDouble(1, value));
+    EXPECT_FALSE(reader.getDouble(2, value));
+    EXPECT_EQ(reader.field(2), "abc");
+    EXPECT_EQ(reader.field(7), "");
+
+    ASSERT_TRUE(reader.next());
+    EXPECT_TRUE(reader.getDouble(2, value));
+    EXPECT_DOUBLE_EQ(value, 4.0);
+
+    EXPECT_FALSE(reader.next());
+}
+
+// Test rows crossing buffer boundaries and rows longer than the buffer
+TEST_F(CsvReaderTest, SmallBuffer) {
+    std::string contents = "index,value,comment\n";
+    const int rows = 500;
+    for (int i = 0; i < rows; ++i) {
+        contents += std::to_string(i) + "," + std::to_string(i * 0.5) + ",";
+        contents += std::string(i % 7 == 0 ? 200 : 3, 'x') + "\n";
+    }
+    writeFile(contents);
+
+    CsvReader reader(64);
+    ASSERT_TRUE(reader.open(path));
+
+    int count = 0;
+    while (reader.next()) {
+        int64_t index = -1;
+        double value = -1.0;
+        ASSERT_TRUE(reader.getInt64(0, index));
+        ASSERT_TRUE(reader.getDouble(1, value));
+        EXPECT_EQ(index, count);
+        EXPECT_DOUBLE_EQ(value, count * 0.5);
+        EXPECT_EQ(reader.field(2).size(), count % 7 == 0 ? 200u : 3u);
+        ++count;
+    }
+    EXPECT_EQ(count, rows);
+}
+
+// Test missing and empty files
+TEST_F(CsvReaderTest, OpenFailures) {
+    CsvReader reader;
+    EXPECT_FALSE(reader.open(std::filesystem::temp_directory_path() / "flora_csv_reader_missing.csv"));
+
+    writeFile("");
+    EXPECT_FALSE(reader.open(path));
+    EXPECT_FALSE(reader.isOpen());
+}
@@ -0,0 +1,89 @@
+// tests/unit/io/InputIndexTests.cpp
+#include <gtest/gtest.h>
+#include "io/InputIndex.hpp"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+class InputIndexTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::filesystem::remove(csvPath);
+        std::filesystem::remove(indexPath);
+    }
+
+    void writeFile(const std::string& contents) {
+        std::ofstream file(csvPath, std::ios::binary);
+        file << contents;
+    }
+
+    std::filesystem::path csvPath = std::filesystem::temp_directory_path() / "flora_input_index_test.csv";
+    std::filesystem::path indexPath = std::filesystem::temp_directory_path() / "flora_input_index_test.idx";
+};
+
+// Test row offsets, timestamps and rate statistics
+TEST_F(InputIndexTest, Build) {
+    writeFile("timestamp,x\n1000000,1\n\n1100000,2\nbad,3\n1300000,4\n");
+
+    InputIndex index;
+    ASSERT_TRUE(index.build(csvPath));
+    ASSERT_EQ(index.getRowCount(), 4u);
+
+    EXPECT_EQ(index.getRowOffset(0), 12u);
+    EXPECT_EQ(index.getRowOffset(1), 23u);
+    EXPECT_EQ(index.getRowOffset(2), 33u);
+    EXPECT_EQ(index.getTimestampUs(1), 1100000);
+    EXPECT_EQ(index.getTimestampUs(2), InputIndex::INVALID_TIMESTAMP);
+
+    EXPECT_EQ(index.getFirstTimestampUs(), 1000000);
+    EXPECT_EQ(index.getLastTimestampUs(), 1300000);
+    EXPECT_NEAR(index.getMeanRate(), 1.0 / 0.15, 1e-9);
+    EXPECT_NEAR(index.getMinInterval(), 0.1, 1e-12);
+    EXPECT_NEAR(index.getMaxInterval(), 0.2, 1e-12);
+    EXPECT_NEAR(index.getIntervalJitter(), 0.05, 1e-12);
+}
+
+// Test that a missing timestamp column fails
+TEST_F(InputIndexTest, MissingColumn) {
+    writeFile("time,x\n1,2\n");
+
+    InputIndex index;
+    EXPECT_FALSE(index.build(csvPath));
+    EXPECT_EQ(index.getRowCount(), 0u);
+}
+
+// Test sidecar round trip
+TEST_F(InputIndexTest, Sidecar) {
+    writeFile("timestamp,x\n2024-01-01 00:00:00.0,1\n2024-01-01 00:00:00.5,2\n");
+
+    InputIndex built;
+    ASSERT_TRUE(built.loadOrBuild(csvPath, indexPath));
+    EXPECT_FALSE(built.isFromSidecar());
+    ASSERT_TRUE(std::filesystem::exists(indexPath));
+
+    InputIndex loaded;
+    ASSERT_TRUE(loaded.loadOrBuild(csvPath, indexPath));
+    EXPECT_TRUE(loaded.isFromSidecar());
+    ASSERT_EQ(loaded.getRowCount(), built.getRowCount());
+    for (size_t i = 0; i < built.getRowCount(); ++i) {
+        EXPECT_EQ(loaded.getRowOffset(i), built.getRowOffset(i));
+        EXPECT_EQ(loaded.getTimestampUs(i), built.getTimestampUs(i));
+    }
+    EXPECT_DOUBLE_EQ(loaded.getMeanRate(), 2.0);
+}
+
+// Test that a sidecar is rejected once the CSV file changes
+TEST_F(InputIndexTest, StaleSidecar) {
+    writeFile("timestamp,x\n1,1\n2,2\n");
+
+    InputIndex index;
+    ASSERT_TRUE(index.build(csvPath));
+    ASSERT_TRUE(index.save(indexPath));
+
+    writeFile("timestamp,x\n1,1\n2,2\n3,3\n");
+
+    EXPECT_FALSE(index.load(indexPath, csvPath));
+    ASSERT_TRUE(index.loadOrBuild(csvPath, indexPath));
+    EXPECT_FALSE(index.isFromSidecar());
+    EXPECT_EQ(index.getRowCount(), 3u);
+}
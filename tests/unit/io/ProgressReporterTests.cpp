@@ -0,0 +1,89 @@
+// tests/unit/io/ProgressReporterTests.cpp
+#include <gtest/gtest.h>
+#include "io/ProgressReporter.hpp"
+#include <chrono>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> splitLines(const std::string& text) {
+    std::vector<std::string> lines;
+    std::istringstream stream(text);
+    std::string line;
+    while (std::getline(stream, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+} // namespace
+
+// Test mode name parsing
+TEST(ProgressReporterTest, ParseMode) {
+    ProgressMode mode;
+    ASSERT_TRUE(parseProgressMode("jsonl", mode));
+    EXPECT_EQ(mode, ProgressMode::JSONL);
+    ASSERT_TRUE(parseProgressMode("none", mode));
+    EXPECT_EQ(mode, ProgressMode::NONE);
+    EXPECT_FALSE(parseProgressMode("json", mode));
+}
+
+// Test that NONE writes nothing
+TEST(ProgressReporterTest, None) {
+    std::ostringstream out;
+    ProgressReporter reporter(ProgressMode::NONE, 100.0, out);
+    reporter.start();
+
+    ProgressSnapshot snapshot;
+    snapshot.frame = 1;
+    reporter.publish(snapshot);
+    reporter.finish(snapshot);
+
+    EXPECT_TRUE(out.str().empty());
+}
+
+// Test that reports are rate limited and the final state is always written
+TEST(ProgressReporterTest, JsonLinesRateLimited) {
+    std::ostringstream out;
+    ProgressReporter reporter(ProgressMode::JSONL, 20.0, out, "log_42");
+    reporter.start();
+
+    ProgressSnapshot snapshot;
+    snapshot.totalFrames = 100000;
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+    while (std::chrono::steady_clock::now() < end) {
+        ++snapshot.frame;
+        reporter.publish(snapshot);
+    }
+    reporter.finish(snapshot);
+
+    std::vector<std::string> lines = splitLines(out.str());
+    ASSERT_GE(lines.size(), 2u);
+    EXPECT_LE(lines.size(), 7u); // ~4 periodic reports at 20 Hz plus the final one
+    EXPECT_LT(lines.size(), static_cast<size_t>(snapshot.frame));
+
+    for (const std::string& line : lines) {
+        EXPECT_EQ(line.front(), '{');
+        EXPECT_EQ(line.back(), '}');
+        EXPECT_NE(line.find("\"label\":\"log_42\""), std::string::npos);
+    }
+    EXPECT_NE(lines.back().find("\"final\":true"), std::string::npos);
+    EXPECT_NE(lines.back().find("\"frame\":" + std::to_string(snapshot.frame) + ","), std::string::npos);
+}
+
+// Test that non-finite values are written as JSON null
+TEST(ProgressReporterTest, JsonNonFinite) {
+    std::ostringstream out;
+    ProgressReporter reporter(ProgressMode::JSONL, 5.0, out);
+    reporter.start();
+
+    ProgressSnapshot snapshot;
+    snapshot.speed = std::numeric_limits<double>::quiet_NaN();
+    reporter.finish(snapshot);
+
+    EXPECT_NE(out.str().find("\"speed_mps\":null"), std::string::npos);
+}
@@ -0,0 +1,132 @@
+// tests/unit/io/ResultWriterTests.cpp
+#include <gtest/gtest.h>
+#include "io/ResultWriter.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class ResultWriterTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::filesystem::remove(binPath);
+        std::filesystem::remove(csvPath);
+    }
+
+    static std::string readFile(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    const std::vector<ResultColumn> columns = {
+        {"frame_number", ResultColumn::Type::INT64},
+        {"speed_mps", ResultColumn::Type::FLOAT64},
+        {"dr_lat", ResultColumn::Type::FLOAT64}
+    };
+
+    std::filesystem::path binPath = std::filesystem::temp_directory_path() / "flora_result_writer_test.bin";
+    std::filesystem::path csvPath = std::filesystem::temp_directory_path() / "flora_result_writer_test.csv";
+};
+
+// Test format name parsing
+TEST_F(ResultWriterTest, ParseFormat) {
+    ResultFormat format;
+    ASSERT_TRUE(parseResultFormat("bin", format));
+    EXPECT_EQ(format, ResultFormat::BINARY);
+    ASSERT_TRUE(parseResultFormat("csv", format));
+    EXPECT_EQ(format, ResultFormat::CSV);
+    EXPECT_FALSE(parseResultFormat("json", format));
+}
+
+// Test CSV output matches the previous fixed-precision text format
+TEST_F(ResultWriterTest, Csv) {
+    ResultWriter writer;
+    ASSERT_TRUE(writer.open(csvPath, ResultFormat::CSV, columns));
+    const double row1[] = {1, 12.5, 52.22970123456789};
+    const double row2[] = {2, -0.25, -21.0};
+    ASSERT_TRUE(writer.write(row1));
+    ASSERT_TRUE(writer.write(row2));
+    ASSERT_TRUE(writer.close());
+
+    EXPECT_EQ(readFile(csvPath),
+              "frame_number,speed_mps,dr_lat\n"
+              "1,12.5000000000,52.2297012346\n"
+              "2,-0.2500000000,-21.0000000000\n");
+}
+
+// Test binary header, record layout and reading back
+TEST_F(ResultWriterTest, Binary) {
+    ResultWriter writer;
+    ASSERT_TRUE(writer.open(binPath, ResultFormat::BINARY, columns));
+    for (int i = 0; i < 1000; ++i) {
+        const double row[] = {static_cast<double>(i), i * 0.5, 52.0 + i * 1e-7};
+        ASSERT_TRUE(writer.write(row));
+    }
+    ASSERT_TRUE(writer.close());
+
+    // 64-byte aligned header followed by 24-byte records
+    EXPECT_EQ(std::filesystem::file_size(binPath), 64u + 1000u * 24u);
+
+    ResultReader reader;
+    ASSERT_TRUE(reader.open(binPath));
+    ASSERT_EQ(reader.getColumns().size(), 3u);
+    EXPECT_EQ(reader.getColumns()[0].name, "frame_number");
+    EXPECT_EQ(reader.getColumns()[0].type, ResultColumn::Type::INT64);
+    EXPECT_EQ(reader.getColumns()[2].name, "dr_lat");
+    EXPECT_EQ(reader.getRecordCount(), 1000u);
+
+    std::vector<double> values;
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(reader.next(values));
+        EXPECT_EQ(values[0], i);
+        EXPECT_EQ(values[1], i * 0.5);
+        EXPECT_EQ(values[2], 52.0 + i * 1e-7);
+    }
+    EXPECT_FALSE(reader.next(values));
+}
+
+// Test that a file cut inside its header is rejected and a partial last record is ignored
+TEST_F(ResultWriterTest, TruncatedBinary) {
+    ResultWriter writer;
+    ASSERT_TRUE(writer.open(binPath, ResultFormat::BINARY, columns));
+    for (int i = 0; i < 3; ++i) {
+        const double row[] = {static_cast<double>(i), i * 0.5, 52.0};
+        ASSERT_TRUE(writer.write(row));
+    }
+    ASSERT_TRUE(writer.close());
+
+    // Three 24-byte records after the 64-byte header; cut the last one in half
+    std::filesystem::resize_file(binPath, 64u + 2u * 24u + 12u);
+    ResultReader reader;
+    ASSERT_TRUE(reader.open(binPath));
+    EXPECT_EQ(reader.getRecordCount(), 2u);
+    std::vector<double> values;
+    EXPECT_TRUE(reader.next(values));
+    EXPECT_TRUE(reader.next(values));
+    EXPECT_EQ(values[0], 1);
+    EXPECT_FALSE(reader.next(values));
+    reader.close();
+
+    // Fixed fields and column names intact, padding cut
+    std::filesystem::resize_file(binPath, 60u);
+    EXPECT_FALSE(reader.open(binPath));
+    EXPECT_EQ(reader.getRecordCount(), 0u);
+}
+
+// Test conversion of a binary result file to CSV
+TEST_F(ResultWriterTest, ConvertToCsv) {
+    ResultWriter writer;
+    ASSERT_TRUE(writer.open(binPath, ResultFormat::BINARY, columns));
+    const double row[] = {7, 3.0, 1.5};
+    ASSERT_TRUE(writer.write(row));
+    ASSERT_TRUE(writer.close());
+
+    ASSERT_TRUE(convertResultsToCsv(binPath, csvPath));
+    EXPECT_EQ(readFile(csvPath), "frame_number,speed_mps,dr_lat\n7,3.0000000000,1.5000000000\n");
+
+    // CSV input is not a binary result file
+    EXPECT_FALSE(convertResultsToCsv(csvPath, binPath));
+}
@@ -0,0 +1,46 @@
+// tests/unit/io/TimestampTests.cpp
+#include <gtest/gtest.h>
+#include "io/Timestamp.hpp"
+
+// Test raw PX4 microsecond timestamps
+TEST(TimestampTest, RawMicroseconds) {
+    int64_t us = 0;
+    ASSERT_TRUE(parseTimestampUs("1700000000123456", us));
+    EXPECT_EQ(us, 1700000000123456LL);
+
+    ASSERT_TRUE(parseTimestampUs("42", us));
+    EXPECT_EQ(us, 42);
+}
+
+// Test date-time timestamps written by convert_timestamp.py
+TEST(TimestampTest, DateTime) {
+    int64_t us = 0;
+    ASSERT_TRUE(parseTimestampUs("1970-01-01 00:00:00", us));
+    EXPECT_EQ(us, 0);
+
+    ASSERT_TRUE(parseTimestampUs("2023-11-14 22:13:20.123456", us));
+    EXPECT_EQ(us, 1700000000123456LL);
+
+    ASSERT_TRUE(parseTimestampUs("2023-11-14T22:13:20.5", us));
+    EXPECT_EQ(us, 1700000000500000LL);
+
+    // Digits beyond microseconds are truncated
+    ASSERT_TRUE(parseTimestampUs("2023-11-14 22:13:20.123456789", us));
+    EXPECT_EQ(us, 1700000000123456LL);
+
+    // Leap day
+    ASSERT_TRUE(parseTimestampUs("2024-02-29 00:00:00", us));
+    EXPECT_EQ(us, 1709164800000000LL);
+}
+
+// Test rejection of malformed timestamps
+TEST(TimestampTest, Malformed) {
+    int64_t us = 0;
+    EXPECT_FALSE(parseTimestampUs("", us));
+    EXPECT_FALSE(parseTimestampUs("12a4", us));
+    EXPECT_FALSE(parseTimestampUs("2023-11-14", us));
+    EXPECT_FALSE(parseTimestampUs("2023-13-14 22:13:20", us));
+    EXPECT_FALSE(parseTimestampUs("2023-11-14 22:13:20.", us));
+    EXPECT_FALSE(parseTimestampUs("2023-11-14 22:13:20,5", us));
+    EXPECT_FALSE(parseTimestampUs("2023/11/14 22:13:20", us));
+}
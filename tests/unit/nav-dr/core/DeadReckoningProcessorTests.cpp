@@ -0,0 +1,89 @@
+// tests/unit/nav-dr/core/DeadReckoningProcessorTests.cpp
+#include <gtest/gtest.h>
+#include "nav-dr/core/DeadReckoningProcessor.hpp"
+#include <cmath>
+
+namespace {
+
+const double START_LAT = 52.2297;
+const double START_LON = 21.0122;
+const double ALTITUDE = 100.0;
+
+// Flies a constant heading (counterclockwise from east) and speed for the given number of steps
+GPSData fly(DeadReckoningProcessor& processor, double heading, double speed, double dt, int steps) {
+    GPSData start(START_LAT, START_LON, ALTITUDE);
+    EXPECT_TRUE(processor.update(start, ALTITUDE, heading, speed, dt));
+    for (int i = 0; i < steps; ++i) {
+        EXPECT_TRUE(processor.update(start, ALTITUDE, heading, speed, dt));
+    }
+    return processor.getGPSData();
+}
+
+} // namespace
+
+// Test integration name parsing
+TEST(DeadReckoningProcessorTest, ParseIntegration) {
+    DeadReckoningIntegration integration;
+    ASSERT_TRUE(parseDeadReckoningIntegration("enu", integration));
+    EXPECT_EQ(integration, DeadReckoningIntegration::LOCAL_ENU);
+    ASSERT_TRUE(parseDeadReckoningIntegration("great-circle", integration));
+    EXPECT_EQ(integration, DeadReckoningIntegration::GREAT_CIRCLE);
+    EXPECT_FALSE(parseDeadReckoningIntegration("flat", integration));
+}
+
+// Test rejection of an invalid initial fix
+TEST(DeadReckoningProcessorTest, InvalidInitialFix) {
+    DeadReckoningProcessor processor;
+    EXPECT_FALSE(processor.update(GPSData(0.0, 0.0, 0.0), ALTITUDE, 0.0, 10.0, 0.1));
+    EXPECT_FALSE(processor.hasPreviousData());
+}
+
+// Test that the first update only stores the fix
+TEST(DeadReckoningProcessorTest, FirstUpdateKeepsFix) {
+    DeadReckoningProcessor processor;
+    GPSData position = fly(processor, 0.5, 10.0, 0.1, 0);
+    EXPECT_DOUBLE_EQ(position.getLatitude(), START_LAT);
+    EXPECT_DOUBLE_EQ(position.getLongitude(), START_LON);
+}
+
+// Test local ENU steps against the distance and direction flown
+TEST(DeadReckoningProcessorTest, LocalEnuDistanceAndDirection) {
+    DeadReckoningProcessor processor;
+    ASSERT_EQ(processor.getIntegration(), DeadReckoningIntegration::LOCAL_ENU);
+
+    // 30 fps, 15 m/s due north for 60 s (900 m, below the re-anchor distance)
+    GPSData position = fly(processor, M_PI / 2.0, 15.0, 1.0 / 30.0, 1800);
+    GPSData start(START_LAT, START_LON, ALTITUDE);
+
+    EXPECT_NEAR(position.distanceTo(start), 900.0, 0.01);
+    EXPECT_NEAR(position.getLongitude(), START_LON, 1e-9);
+    EXPECT_GT(position.getLatitude(), START_LAT);
+    EXPECT_DOUBLE_EQ(position.getAltitude(), ALTITUDE);
+}
+
+// Test that re-anchoring keeps a long flight on track
+TEST(DeadReckoningProcessorTest, LocalEnuLongFlight) {
+    DeadReckoningProcessor processor;
+
+    // 20 m/s due east for 10 minutes: 12 km, eleven re-anchors
+    GPSData position = fly(processor, 0.0, 20.0, 1.0 / 30.0, 18000);
+    GPSData start(START_LAT, START_LON, ALTITUDE);
+
+    // Due east follows the parallel (1e-6 deg of latitude is about 0.1 m)
+    EXPECT_NEAR(position.distanceTo(start), 12000.0, 0.5);
+    EXPECT_NEAR(position.getLatitude(), START_LAT, 1e-6);
+}
+
+// Test that both integrations agree over a short leg
+TEST(DeadReckoningProcessorTest, IntegrationsAgree) {
+    DeadReckoningProcessor enu;
+    DeadReckoningProcessor greatCircle;
+    greatCircle.setIntegration(DeadReckoningIntegration::GREAT_CIRCLE);
+
+    // 12 m/s towards the north-west for 30 s
+    GPSData enuPosition = fly(enu, 0.75 * M_PI, 12.0, 1.0 / 30.0, 900);
+    GPSData greatCirclePosition = fly(greatCircle, 0.75 * M_PI, 12.0, 1.0 / 30.0, 900);
+
+    // The spherical formula uses the equatorial radius, so it differs by a fraction of a percent
+    EXPECT_LT(enuPosition.distanceTo(greatCirclePosition), 0.005 * 360.0);
+}
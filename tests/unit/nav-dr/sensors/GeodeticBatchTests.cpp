@@ -0,0 +1,243 @@
+// tests/unit/nav-dr/sensors/GeodeticBatchTests.cpp
+#include <gtest/gtest.h>
+#include "nav-dr/sensors/GeodeticBatch.hpp"
+#include "nav-dr/sensors/GPSData.hpp"
+#include "nav-dr/sensors/LocalFrame.hpp"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Cloud {
+    std::vector<double> latitude;
+    std::vector<double> longitude;
+    std::vector<double> altitude;
+};
+
+// Points up to ~100 km around the reference, -400 m to 9 km altitude
+Cloud makeCloud(double referenceLatitude, double referenceLongitude, size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> offset(-0.9, 0.9);
+    std::uniform_real_distribution<double> height(-400.0, 9000.0);
+
+    Cloud cloud;
+    for (size_t i = 0; i < count; ++i) {
+        cloud.latitude.push_back(referenceLatitude + offset(rng));
+        double longitude = referenceLongitude + offset(rng);
+        if (longitude > 180.0) longitude -= 360.0;
+        if (longitude < -180.0) longitude += 360.0;
+        cloud.longitude.push_back(longitude);
+        cloud.altitude.push_back(height(rng));
+    }
+    return cloud;
+}
+
+// Previous GPSData::fromENU latitude iteration, run to convergence in long double
+void iterativeECEFToGeodetic(double x, double y, double z, double& latitude, double& longitude, double& altitude) {
+    const long double a = 6378137.0L;
+    const long double f = 1.0L / 298.257223563L;
+    const long double e2 = 2.0L * f - f * f;
+
+    const long double p = std::sqrt(static_cast<long double>(x) * x + static_cast<long double>(y) * y);
+    long double lat = std::atan2(static_cast<long double>(z), p * (1.0L - e2));
+    for (int i = 0; i < 50; ++i) {
+        long double N = a / std::sqrt(1.0L - e2 * std::sin(lat) * std::sin(lat));
+        long double h = p / std::cos(lat) - N;
+        lat = std::atan2(static_cast<long double>(z), p * (1.0L - e2 * N / (N + h)));
+    }
+    long double N = a / std::sqrt(1.0L - e2 * std::sin(lat) * std::sin(lat));
+
+    latitude = static_cast<double>(lat * 180.0L / M_PI);
+    longitude = static_cast<double>(std::atan2(static_cast<long double>(y), static_cast<long double>(x)) * 180.0L / M_PI);
+    altitude = static_cast<double>(p / std::cos(lat) - N);
+}
+
+// ENU -> ECEF in long double, independent of the library conversions
+void referenceENUToECEF(double east, double north, double up, double refLat, double refLon, double refAlt,
+                        double& x, double& y, double& z) {
+    const long double a = 6378137.0L;
+    const long double f = 1.0L / 298.257223563L;
+    const long double e2 = 2.0L * f - f * f;
+
+    const long double lat = refLat * static_cast<long double>(M_PI) / 180.0L;
+    const long double lon = refLon * static_cast<long double>(M_PI) / 180.0L;
+    const long double sinLat = std::sin(lat), cosLat = std::cos(lat);
+    const long double sinLon = std::sin(lon), cosLon = std::cos(lon);
+    const long double N = a / std::sqrt(1.0L - e2 * sinLat * sinLat);
+
+    const long double x0 = (N + refAlt) * cosLat * cosLon;
+    const long double y0 = (N + refAlt) * cosLat * sinLon;
+    const long double z0 = (N * (1.0L - e2) + refAlt) * sinLat;
+
+    x = static_cast<double>(x0 - sinLon * east - sinLat * cosLon * north + cosLat * cosLon * up);
+    y = static_cast<double>(y0 + cosLon * east - sinLat * sinLon * north + cosLat * sinLon * up);
+    z = static_cast<double>(z0 + cosLat * north + sinLat * up);
+}
+
+double longitudeDifference(double a, double b) {
+    double difference = std::fabs(a - b);
+    return difference > 180.0 ? 360.0 - difference : difference;
+}
+
+} // namespace
+
+class GeodeticBatchTest : public ::testing::TestWithParam<std::pair<double, double>> {};
+
+TEST_P(GeodeticBatchTest, ToENUMatchesScalar) {
+    const double refLat = GetParam().first;
+    const double refLon = GetParam().second;
+    const double refAlt = 120.0;
+    Cloud cloud = makeCloud(refLat, refLon, 1001, 7);
+
+    const size_t n = cloud.latitude.size();
+    std::vector<double> east(n), north(n), up(n);
+    geodeticToENUBatch(cloud.latitude.data(), cloud.longitude.data(), cloud.altitude.data(), n,
+                       refLat, refLon, refAlt, east.data(), north.data(), up.data());
+
+    for (size_t i = 0; i < n; ++i) {
+        GPSData gps(cloud.latitude[i], cloud.longitude[i], cloud.altitude[i]);
+        Vector3D expected = gps.toENU(refLat, refLon, refAlt);
+        EXPECT_NEAR(east[i], expected.getX(), 1e-7);
+        EXPECT_NEAR(north[i], expected.getY(), 1e-7);
+        EXPECT_NEAR(up[i], expected.getZ(), 1e-7);
+    }
+}
+
+TEST_P(GeodeticBatchTest, FromENURoundTrip) {
+    const double refLat = GetParam().first;
+    const double refLon = GetParam().second;
+    const double refAlt = 120.0;
+    Cloud cloud = makeCloud(refLat, refLon, 1001, 11);
+
+    const size_t n = cloud.latitude.size();
+    std::vector<double> east(n), north(n), up(n), latitude(n), longitude(n), altitude(n);
+    geodeticToENUBatch(cloud.latitude.data(), cloud.longitude.data(), cloud.altitude.data(), n,
+                       refLat, refLon, refAlt, east.data(), north.data(), up.data());
+    enuToGeodeticBatch(east.data(), north.data(), up.data(), n,
+                       refLat, refLon, refAlt, latitude.data(), longitude.data(), altitude.data());
+
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_NEAR(latitude[i], cloud.latitude[i], 1e-10);
+        EXPECT_LT(longitudeDifference(longitude[i], cloud.longitude[i]), 1e-10);
+        EXPECT_GE(longitude[i], -180.0);
+        EXPECT_LE(longitude[i], 180.0);
+        EXPECT_NEAR(altitude[i], cloud.altitude[i], 1e-6);
+    }
+}
+
+TEST_P(GeodeticBatchTest, FromENUMatchesIteration) {
+    const double refLat = GetParam().first;
+    const double refLon = GetParam().second;
+    const double refAlt = 120.0;
+    const LocalFrame frame(GPSData(refLat, refLon, refAlt));
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> horizontal(-50000.0, 50000.0);
+    std::uniform_real_distribution<double> vertical(-300.0, 3000.0);
+
+    const size_t n = 257;
+    std::vector<double> east(n), north(n), up(n), latitude(n), longitude(n), altitude(n);
+    for (size_t i = 0; i < n; ++i) {
+        east[i] = horizontal(rng);
+        north[i] = horizontal(rng);
+        up[i] = vertical(rng);
+    }
+    enuToGeodeticBatch(east.data(), north.data(), up.data(), n,
+                       refLat, refLon, refAlt, latitude.data(), longitude.data(), altitude.data());
+
+    for (size_t i = 0; i < n; ++i) {
+        double x, y, z, expectedLat, expectedLon, expectedAlt;
+        referenceENUToECEF(east[i], north[i], up[i], refLat, refLon, refAlt, x, y, z);
+        iterativeECEFToGeodetic(x, y, z, expectedLat, expectedLon, expectedAlt);
+
+        EXPECT_NEAR(latitude[i], expectedLat, 1e-11);
+        EXPECT_LT(longitudeDifference(longitude[i], expectedLon), 1e-11);
+        EXPECT_NEAR(altitude[i], expectedAlt, 1e-6);
+
+        GPSData position;
+        frame.fromENU(Vector3D(east[i], north[i], up[i]), position);
+        EXPECT_NEAR(position.getLatitude(), expectedLat, 1e-11);
+        EXPECT_LT(longitudeDifference(position.getLongitude(), expectedLon), 1e-11);
+        EXPECT_NEAR(position.getAltitude(), expectedAlt, 1e-6);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(References, GeodeticBatchTest, ::testing::Values(
+    std::make_pair(52.2297, 21.0122),
+    std::make_pair(-33.8688, 151.2093),
+    std::make_pair(0.5, -78.5),
+    std::make_pair(78.2, 15.6),
+    std::make_pair(-45.0, 179.8)));
+
+TEST(GeodeticBatch, ClosedFormMatchesIteration) {
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<double> latitude(-85.0, 85.0);
+    std::uniform_real_distribution<double> longitude(-180.0, 180.0);
+    std::uniform_real_distribution<double> height(-1000.0, 50000.0);
+
+    const size_t n = 2000;
+    std::vector<double> x(n), y(n), z(n), lat(n), lon(n), alt(n);
+    for (size_t i = 0; i < n; ++i) {
+        Vector3D ecef = LocalFrame::geodeticToECEF(latitude(rng), longitude(rng), height(rng));
+        x[i] = ecef.getX();
+        y[i] = ecef.getY();
+        z[i] = ecef.getZ();
+    }
+    ecefToGeodeticBatch(x.data(), y.data(), z.data(), n, lat.data(), lon.data(), alt.data());
+
+    for (size_t i = 0; i < n; ++i) {
+        double expectedLat, expectedLon, expectedAlt;
+        iterativeECEFToGeodetic(x[i], y[i], z[i], expectedLat, expectedLon, expectedAlt);
+
+        // Sub-millimeter: 1e-11 deg is ~1 um on the ground
+        EXPECT_NEAR(lat[i], expectedLat, 1e-11);
+        EXPECT_LT(longitudeDifference(lon[i], expectedLon), 1e-11);
+        EXPECT_NEAR(alt[i], expectedAlt, 1e-6);
+
+        // The scalar conversion shares the kernel
+        double scalarLat, scalarLon, scalarAlt;
+        LocalFrame::ecefToGeodetic(Vector3D(x[i], y[i], z[i]), scalarLat, scalarLon, scalarAlt);
+        EXPECT_DOUBLE_EQ(scalarLat, lat[i]);
+        EXPECT_DOUBLE_EQ(scalarLon, lon[i]);
+        EXPECT_DOUBLE_EQ(scalarAlt, alt[i]);
+    }
+}
+
+TEST(GeodeticBatch, ClosedFormAtPolesAndEquator) {
+    const double x[] = {0.0, 0.0, 6378137.0 + 100.0, 0.0};
+    const double y[] = {0.0, 0.0, 0.0, -(6378137.0 + 2500.0)};
+    const double z[] = {6356752.314245 + 30.0, -(6356752.314245 + 30.0), 0.0, 0.0};
+    double lat[4], lon[4], alt[4];
+    ecefToGeodeticBatch(x, y, z, 4, lat, lon, alt);
+
+    EXPECT_NEAR(lat[0], 90.0, 1e-12);
+    EXPECT_NEAR(alt[0], 30.0, 1e-6);
+    EXPECT_NEAR(lat[1], -90.0, 1e-12);
+    EXPECT_NEAR(alt[1], 30.0, 1e-6);
+    EXPECT_NEAR(lat[2], 0.0, 1e-12);
+    EXPECT_NEAR(lon[2], 0.0, 1e-12);
+    EXPECT_NEAR(alt[2], 100.0, 1e-6);
+    EXPECT_NEAR(lat[3], 0.0, 1e-12);
+    EXPECT_NEAR(lon[3], -90.0, 1e-12);
+    EXPECT_NEAR(alt[3], 2500.0, 1e-6);
+}
+
+TEST(GeodeticBatch, ReferencePointIsOrigin) {
+    const double latitude = 37.7749;
+    const double longitude = -122.4194;
+    const double altitude = 16.0;
+    double east = 1.0, north = 1.0, up = 1.0;
+    geodeticToENUBatch(&latitude, &longitude, &altitude, 1, latitude, longitude, altitude, &east, &north, &up);
+    EXPECT_NEAR(east, 0.0, 1e-9);
+    EXPECT_NEAR(north, 0.0, 1e-9);
+    EXPECT_NEAR(up, 0.0, 1e-9);
+}
+
+TEST(GeodeticBatch, EmptyInput) {
+    double value = 5.0;
+    geodeticToENUBatch(&value, &value, &value, 0, 10.0, 20.0, 0.0, &value, &value, &value);
+    enuToGeodeticBatch(&value, &value, &value, 0, 10.0, 20.0, 0.0, &value, &value, &value);
+    ecefToGeodeticBatch(&value, &value, &value, 0, &value, &value, &value);
+    EXPECT_DOUBLE_EQ(value, 5.0);
+}
@@ -0,0 +1,107 @@
+// tests/unit/nav-dr/sensors/LocalFrameTests.cpp
+#include <gtest/gtest.h>
+#include "nav-dr/sensors/LocalFrame.hpp"
+#include <cmath>
+#include <random>
+#include <vector>
+
+class LocalFrameTest : public ::testing::Test {
+protected:
+    const GPSData reference{52.2297, 21.0122, 110.5, 1.5, GPSData::FixType::FIX_3D, 9};
+    const LocalFrame frame{reference};
+};
+
+TEST_F(LocalFrameTest, ReferenceIsOrigin) {
+    Vector3D enu = frame.toENU(reference);
+    EXPECT_NEAR(enu.getX(), 0.0, 1e-9);
+    EXPECT_NEAR(enu.getY(), 0.0, 1e-9);
+    EXPECT_NEAR(enu.getZ(), 0.0, 1e-9);
+
+    EXPECT_DOUBLE_EQ(frame.getReference().getLatitude(), reference.getLatitude());
+    EXPECT_EQ(frame.getReference().getSatelliteCount(), 9);
+}
+
+TEST_F(LocalFrameTest, RotationIsOrthonormal) {
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            double dot = 0.0;
+            for (int k = 0; k < 3; ++k) {
+                dot += frame.getRotation(i, k) * frame.getRotation(j, k);
+            }
+            EXPECT_NEAR(dot, i == j ? 1.0 : 0.0, 1e-15);
+        }
+    }
+}
+
+TEST_F(LocalFrameTest, ToENUMatchesGPSData) {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> offset(-0.5, 0.5);
+    std::uniform_real_distribution<double> height(0.0, 3000.0);
+
+    for (int i = 0; i < 500; ++i) {
+        GPSData point(reference.getLatitude() + offset(rng), reference.getLongitude() + offset(rng), height(rng));
+        Vector3D expected = point.toENU(reference.getLatitude(), reference.getLongitude(), reference.getAltitude());
+        Vector3D enu = frame.toENU(point);
+        EXPECT_NEAR(enu.getX(), expected.getX(), 1e-7);
+        EXPECT_NEAR(enu.getY(), expected.getY(), 1e-7);
+        EXPECT_NEAR(enu.getZ(), expected.getZ(), 1e-7);
+    }
+}
+
+TEST_F(LocalFrameTest, FromENURoundTrip) {
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<double> horizontal(-80000.0, 80000.0);
+    std::uniform_real_distribution<double> vertical(-500.0, 5000.0);
+
+    for (int i = 0; i < 500; ++i) {
+        Vector3D enu(horizontal(rng), horizontal(rng), vertical(rng));
+        GPSData position(0.0, 0.0, 0.0, 2.0, GPSData::FixType::RTK_FIXED, 12);
+        frame.fromENU(enu, position);
+        Vector3D back = frame.toENU(position);
+        EXPECT_NEAR(back.getX(), enu.getX(), 1e-6);
+        EXPECT_NEAR(back.getY(), enu.getY(), 1e-6);
+        EXPECT_NEAR(back.getZ(), enu.getZ(), 1e-6);
+
+        // Only the position is written
+        EXPECT_EQ(position.getFixType(), GPSData::FixType::RTK_FIXED);
+        EXPECT_EQ(position.getSatelliteCount(), 12);
+    }
+}
+
+TEST_F(LocalFrameTest, ECEFRoundTrip) {
+    Vector3D ecef = LocalFrame::geodeticToECEF(-33.8688, 151.2093, 58.0);
+    double latitude, longitude, altitude;
+    LocalFrame::ecefToGeodetic(ecef, latitude, longitude, altitude);
+    EXPECT_NEAR(latitude, -33.8688, 1e-11);
+    EXPECT_NEAR(longitude, 151.2093, 1e-11);
+    EXPECT_NEAR(altitude, 58.0, 1e-6);
+
+    Vector3D enu = frame.ecefToENU(frame.enuToECEF(Vector3D(10.0, -20.0, 30.0)));
+    EXPECT_NEAR(enu.getX(), 10.0, 1e-8);
+    EXPECT_NEAR(enu.getY(), -20.0, 1e-8);
+    EXPECT_NEAR(enu.getZ(), 30.0, 1e-8);
+}
+
+TEST_F(LocalFrameTest, BatchMatchesScalar) {
+    std::vector<double> latitude = {52.0, 52.3, 52.5, 51.9};
+    std::vector<double> longitude = {21.0, 20.8, 21.4, 21.1};
+    std::vector<double> altitude = {100.0, 250.0, 80.0, 1200.0};
+    const size_t n = latitude.size();
+
+    std::vector<double> east(n), north(n), up(n);
+    frame.toENU(latitude.data(), longitude.data(), altitude.data(), n, east.data(), north.data(), up.data());
+    for (size_t i = 0; i < n; ++i) {
+        Vector3D enu = frame.toENU(latitude[i], longitude[i], altitude[i]);
+        EXPECT_NEAR(east[i], enu.getX(), 1e-7);
+        EXPECT_NEAR(north[i], enu.getY(), 1e-7);
+        EXPECT_NEAR(up[i], enu.getZ(), 1e-7);
+    }
+
+    std::vector<double> latitudeBack(n), longitudeBack(n), altitudeBack(n);
+    frame.fromENU(east.data(), north.data(), up.data(), n, latitudeBack.data(), longitudeBack.data(), altitudeBack.data());
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_NEAR(latitudeBack[i], latitude[i], 1e-10);
+        EXPECT_NEAR(longitudeBack[i], longitude[i], 1e-10);
+        EXPECT_NEAR(altitudeBack[i], altitude[i], 1e-6);
+    }
+}
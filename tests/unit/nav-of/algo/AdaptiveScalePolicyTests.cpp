@@ -0,0 +1,98 @@
+// tests/unit/nav-of/algo/AdaptiveScalePolicyTests.cpp
+#include <gtest/gtest.h>
+#include "nav-of/algo/scale_policy.hpp"
+#include <limits>
+
+namespace {
+
+// The analysis setup of OpticalFlowProcessor: 360, 180 and 90 px, sweet spot 1.5-8 px per frame
+const int BASE_HEIGHT = 360;
+const int MIN_HEIGHT = 90;
+const double MIN_DISPLACEMENT = 1.5;
+const double MAX_DISPLACEMENT = 8.0;
+
+const int HOLD = AdaptiveScalePolicy::MIN_FRAMES_PER_LEVEL;
+
+class AdaptiveScalePolicyTest : public ::testing::Test {
+protected:
+    // Feeds the same displacement count times and returns the last height
+    int feed(double baseDisplacement, int count, double confidence = 1.0) {
+        int height = 0;
+        for (int i = 0; i < count; ++i) {
+            height = policy.update(baseDisplacement, confidence);
+        }
+        return height;
+    }
+
+    AdaptiveScalePolicy policy{BASE_HEIGHT, MIN_HEIGHT, MIN_DISPLACEMENT, MAX_DISPLACEMENT};
+};
+
+} // namespace
+
+// Test that the levels halve the base height down to the minimum height
+TEST_F(AdaptiveScalePolicyTest, Levels) {
+    EXPECT_EQ(policy.getLevelCount(), 3);
+    EXPECT_EQ(policy.getHeight(), BASE_HEIGHT);
+
+    AdaptiveScalePolicy single(BASE_HEIGHT, 400, MIN_DISPLACEMENT, MAX_DISPLACEMENT);
+    EXPECT_EQ(single.getLevelCount(), 1);
+    for (int i = 0; i < 3 * HOLD; ++i) {
+        EXPECT_EQ(single.update(100.0, 1.0), BASE_HEIGHT);
+    }
+}
+
+// Test that fast motion moves to the coarsest level only after the hold time, clamped to the minimum height
+TEST_F(AdaptiveScalePolicyTest, HoldAndClampToCoarsest) {
+    EXPECT_EQ(feed(100.0, HOLD - 1), BASE_HEIGHT);
+    EXPECT_EQ(policy.update(100.0, 1.0), MIN_HEIGHT);
+    EXPECT_EQ(policy.getLevel(), 2);
+
+    // Even faster motion cannot go below the minimum height
+    EXPECT_EQ(feed(1000.0, 3 * HOLD), MIN_HEIGHT);
+}
+
+// Test the hysteresis: a level is kept while its displacement stays inside the sweet spot
+TEST_F(AdaptiveScalePolicyTest, KeepsLevelInsideSweetSpot) {
+    // 7.5 px at full height would also allow level 2 (1.9 px), but full height is inside the sweet spot
+    EXPECT_EQ(feed(7.5, 5 * HOLD), BASE_HEIGHT);
+
+    // At level 2, 7 px at full height (1.75 px) stays; 4 px (1 px) leaves for the coarsest level above 1.5 px
+    feed(20.0, HOLD);
+    ASSERT_EQ(policy.getHeight(), MIN_HEIGHT);
+    EXPECT_EQ(feed(7.0, 5 * HOLD), MIN_HEIGHT);
+    EXPECT_EQ(feed(4.0, 1), 180);
+}
+
+// Test that after a switch the new level is held even if the motion changes at once
+TEST_F(AdaptiveScalePolicyTest, HoldsNewLevel) {
+    feed(20.0, HOLD);
+    ASSERT_EQ(policy.getHeight(), MIN_HEIGHT);
+
+    EXPECT_EQ(feed(0.5, HOLD - 1), MIN_HEIGHT);
+    EXPECT_EQ(policy.update(0.5, 1.0), BASE_HEIGHT);
+}
+
+// Test that a low confidence asks for one level finer than both the current and the target level
+TEST_F(AdaptiveScalePolicyTest, LowConfidenceRefines) {
+    feed(20.0, HOLD);
+    ASSERT_EQ(policy.getLevel(), 2);
+
+    const double low = AdaptiveScalePolicy::LOW_CONFIDENCE / 2.0;
+    EXPECT_EQ(feed(20.0, HOLD, low), 180);
+    EXPECT_EQ(feed(20.0, HOLD, low), BASE_HEIGHT);
+    EXPECT_EQ(feed(20.0, 3 * HOLD, low), BASE_HEIGHT);
+}
+
+// Test that invalid displacements keep the level and reset returns to the base height
+TEST_F(AdaptiveScalePolicyTest, InvalidDisplacementAndReset) {
+    feed(20.0, HOLD);
+    ASSERT_EQ(policy.getHeight(), MIN_HEIGHT);
+
+    EXPECT_EQ(feed(std::numeric_limits<double>::quiet_NaN(), 3 * HOLD), MIN_HEIGHT);
+    EXPECT_EQ(feed(-5.0, 3 * HOLD), MIN_HEIGHT);
+    EXPECT_EQ(feed(std::numeric_limits<double>::infinity(), 3 * HOLD), MIN_HEIGHT);
+
+    policy.reset();
+    EXPECT_EQ(policy.getHeight(), BASE_HEIGHT);
+    EXPECT_EQ(policy.getLevel(), 0);
+}
@@ -0,0 +1,76 @@
+// tests/unit/nav-of/algo/DenseCpuBackendTests.cpp
+#include <gtest/gtest.h>
+#include "nav-of/algo/farneback_cpu.hpp"
+#include <opencv2/imgproc.hpp>
+#include <random>
+#include <vector>
+
+namespace {
+
+const int BLOCK_PX = 16;
+const int BORDER_PX = 40;
+const cv::Size FRAME_SIZE(320, 240);
+
+// Blurred blocks of random gray levels
+cv::Mat blockTexture(const cv::Size& size, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> intensity(0, 255);
+    const int blocksX = (size.width + BLOCK_PX - 1) / BLOCK_PX;
+    const int blocksY = (size.height + BLOCK_PX - 1) / BLOCK_PX;
+    std::vector<unsigned char> blocks(blocksX * blocksY);
+    for (unsigned char& block : blocks) block = static_cast<unsigned char>(intensity(rng));
+
+    cv::Mat texture(size, CV_8UC1);
+    for (int y = 0; y < size.height; ++y) {
+        for (int x = 0; x < size.width; ++x) {
+            texture.at<unsigned char>(y, x) = blocks[(y / BLOCK_PX) * blocksX + x / BLOCK_PX];
+        }
+    }
+    cv::GaussianBlur(texture, texture, cv::Size(5, 5), 1.5);
+    return texture;
+}
+
+class DenseCpuBackendTest : public ::testing::Test {
+protected:
+    // Frame whose content is moved by (dx, dy) pixels against the unshifted frame
+    cv::Mat frame(int dx, int dy) const {
+        return texture(cv::Rect(BORDER_PX - dx, BORDER_PX - dy, FRAME_SIZE.width, FRAME_SIZE.height)).clone();
+    }
+
+    const cv::Mat texture = blockTexture(cv::Size(FRAME_SIZE.width + 2 * BORDER_PX, FRAME_SIZE.height + 2 * BORDER_PX), 3);
+    FarnebackCpuBackend backend;
+    FlowMeasurement measurement;
+};
+
+} // namespace
+
+// Test that the first frame and the first frame after a reset only prime the backend
+TEST_F(DenseCpuBackendTest, PrimesAfterReset) {
+    EXPECT_FALSE(backend.process(frame(0, 0), FRAME_SIZE.height, measurement));
+    EXPECT_TRUE(backend.process(frame(2, 0), FRAME_SIZE.height, measurement));
+
+    backend.reset();
+    EXPECT_FALSE(backend.process(frame(0, 0), FRAME_SIZE.height, measurement));
+}
+
+// Test that a shifted frame gives its shift at the analysis scale
+TEST_F(DenseCpuBackendTest, MeasuresShift) {
+    ASSERT_FALSE(backend.process(frame(0, 0), FRAME_SIZE.height, measurement));
+    ASSERT_TRUE(backend.process(frame(0, -4), FRAME_SIZE.height, measurement));
+    EXPECT_NEAR(measurement.dx, 0.0, 0.1);
+    EXPECT_NEAR(measurement.dy, -4.0, 0.1);
+}
+
+// Test that a change of the analysis scale rescales the previous frame instead of dropping the pair
+TEST_F(DenseCpuBackendTest, ScaleSwitchMeasures) {
+    // Coarser: the flow is in pixels of the new scale
+    ASSERT_FALSE(backend.process(frame(0, 0), FRAME_SIZE.height, measurement));
+    ASSERT_TRUE(backend.process(frame(4, 0), FRAME_SIZE.height / 2, measurement));
+    EXPECT_NEAR(measurement.dx, 2.0, 0.1);
+    EXPECT_NEAR(measurement.dy, 0.0, 0.1);
+
+    // Finer again, from the rescaled frame
+    ASSERT_TRUE(backend.process(frame(8, 0), FRAME_SIZE.height, measurement));
+    EXPECT_NEAR(measurement.dx, 4.0, 0.1);
+    EXPECT_NEAR(measurement.dy, 0.0, 0.1);
+}
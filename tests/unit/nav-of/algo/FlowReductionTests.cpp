@@ -0,0 +1,162 @@
+// tests/unit/nav-of/algo/FlowReductionTests.cpp
+#include <gtest/gtest.h>
+#include "nav-of/algo/utils.hpp"
+#include <cmath>
+
+namespace {
+
+const cv::Size FRAME_SIZE(64, 48);
+
+// Rigid image motion: translation (tx, ty) plus a small clockwise rotation about the frame center,
+// flow = t + rotation * (-ry, rx) with y downwards
+cv::Mat rigidFlow(const cv::Size& size, float tx, float ty, float rotation) {
+    const float cx = (size.width - 1) * 0.5f;
+    const float cy = (size.height - 1) * 0.5f;
+    cv::Mat flow(size, CV_32FC2);
+    for (int y = 0; y < size.height; ++y) {
+        for (int x = 0; x < size.width; ++x) {
+            const float rx = x - cx;
+            const float ry = y - cy;
+            flow.at<cv::Vec2f>(y, x) = cv::Vec2f(tx - rotation * ry, ty + rotation * rx);
+        }
+    }
+    return flow;
+}
+
+} // namespace
+
+// Test that translation and rotation of a rigid flow field are separated
+TEST(ReduceFlowTest, SplitsTranslationAndRotation) {
+    const float tx = 1.5f;
+    const float ty = -0.75f;
+    const float rotation = 0.002f;
+    FlowMeasurement measurement = reduceFlow(rigidFlow(FRAME_SIZE, tx, ty, rotation));
+
+    EXPECT_TRUE(measurement.hasDirection);
+    EXPECT_NEAR(measurement.dx, tx, 1e-5);
+    EXPECT_NEAR(measurement.dy, ty, 1e-5);
+    EXPECT_NEAR(measurement.rotation, rotation, 1e-7);
+    EXPECT_GT(measurement.avgMagnitude, std::hypot(tx, ty));
+
+    // The field is exactly rigid, so nothing is left for the residual
+    EXPECT_NEAR(measurement.confidence, 1.0f, 1e-3);
+}
+
+// Test the signs: the flow right of the center moving down is a clockwise (positive) rotation
+TEST(ReduceFlowTest, ClockwiseRotationIsPositive) {
+    cv::Mat flow = rigidFlow(FRAME_SIZE, 0.0f, 0.0f, 0.01f);
+    EXPECT_GT(flow.at<cv::Vec2f>(FRAME_SIZE.height / 2, FRAME_SIZE.width - 1)[1], 0.0f);
+
+    FlowMeasurement measurement = reduceFlow(flow);
+    EXPECT_NEAR(measurement.rotation, 0.01f, 1e-7);
+    EXPECT_NEAR(measurement.dx, 0.0f, 1e-5);
+    EXPECT_NEAR(measurement.dy, 0.0f, 1e-5);
+
+    measurement = reduceFlow(rigidFlow(FRAME_SIZE, 0.0f, 0.0f, -0.01f));
+    EXPECT_NEAR(measurement.rotation, -0.01f, 1e-7);
+}
+
+// Test that a pure translation gives no rotation and a magnitude equal to its length
+TEST(ReduceFlowTest, PureTranslation) {
+    FlowMeasurement measurement = reduceFlow(rigidFlow(FRAME_SIZE, -3.0f, 4.0f, 0.0f));
+    EXPECT_NEAR(measurement.dx, -3.0f, 1e-5);
+    EXPECT_NEAR(measurement.dy, 4.0f, 1e-5);
+    EXPECT_NEAR(measurement.rotation, 0.0f, 1e-7);
+    EXPECT_NEAR(measurement.avgMagnitude, 5.0f, 1e-5);
+}
+
+// Test that a region moving against the rest of the frame lowers the confidence, not the fitted motion only
+TEST(ReduceFlowTest, IndependentMotionLowersConfidence) {
+    cv::Mat flow = rigidFlow(FRAME_SIZE, 2.0f, 0.0f, 0.0f);
+    flow(cv::Rect(0, 0, 16, 16)).setTo(cv::Scalar(-2.0f, 3.0f));
+
+    FlowMeasurement measurement = reduceFlow(flow);
+    EXPECT_LT(measurement.confidence, 0.75f);
+    EXPECT_GT(measurement.confidence, 0.0f);
+}
+
+// Test that reducing the frame in regions gives the same moments as one pass, rotation about the frame center
+TEST(ReduceFlowTest, RegionsAddUp) {
+    cv::Mat flow = rigidFlow(FRAME_SIZE, 0.5f, 1.0f, 0.003f);
+    FlowMeasurement whole = reduceFlow(flow);
+
+    FlowMoments moments;
+    const cv::Rect top(0, 0, FRAME_SIZE.width, 20);
+    const cv::Rect bottom(0, 20, FRAME_SIZE.width, FRAME_SIZE.height - 20);
+    accumulateFlow(flow(top), top.tl(), FRAME_SIZE, 1, cv::Mat(), moments);
+    accumulateFlow(flow(bottom), bottom.tl(), FRAME_SIZE, 1, cv::Mat(), moments);
+    FlowMeasurement regions = moments.toMeasurement();
+
+    EXPECT_DOUBLE_EQ(moments.count, FRAME_SIZE.area());
+    EXPECT_NEAR(regions.dx, whole.dx, 1e-6);
+    EXPECT_NEAR(regions.dy, whole.dy, 1e-6);
+    EXPECT_NEAR(regions.rotation, whole.rotation, 1e-8);
+}
+
+// Test that a region samples the stride grid of the whole frame and skips masked pixels
+TEST(ReduceFlowTest, StrideGridAndMask) {
+    // Frame pixels (8, 12) x (4, 8, 12) lie on the grid of stride 4 inside the region at (5, 3)
+    cv::Mat flow = rigidFlow(cv::Size(10, 10), 1.0f, 0.0f, 0.0f);
+    const cv::Point origin(5, 3);
+
+    FlowMoments moments;
+    accumulateFlow(flow, origin, FRAME_SIZE, 4, cv::Mat(), moments);
+    EXPECT_DOUBLE_EQ(moments.count, 6.0);
+    EXPECT_DOUBLE_EQ(moments.sumRx, 3.0 * ((8.0 - 31.5) + (12.0 - 31.5)));
+
+    cv::Mat mask(flow.size(), CV_8UC1, cv::Scalar(255));
+    mask.at<unsigned char>(5, 7) = 0;     // frame pixel (12, 8)
+    mask.at<unsigned char>(0, 3) = 0;     // frame pixel (8, 3), not on the grid
+    moments = FlowMoments();
+    accumulateFlow(flow, origin, FRAME_SIZE, 4, mask, moments);
+    EXPECT_DOUBLE_EQ(moments.count, 5.0);
+    EXPECT_DOUBLE_EQ(moments.sumU, 5.0);
+}
+
+// Test that an empty field gives no direction
+TEST(ReduceFlowTest, EmptyFlowHasNoDirection) {
+    FlowMeasurement measurement = reduceFlow(cv::Mat());
+    EXPECT_FALSE(measurement.hasDirection);
+    EXPECT_FLOAT_EQ(measurement.avgMagnitude, 0.0f);
+}
+
+// Test the two parts of the confidence: residual against the half-confidence residual, and the texture
+TEST(FlowConfidenceTest, ResidualAndTexture) {
+    // Without a residual and without texture information the flow is fully trusted
+    EXPECT_FLOAT_EQ(flowConfidence(0.0, 0.0, -1.0), 1.0f);
+    EXPECT_FLOAT_EQ(flowConfidence(0.0, 10.0, -1.0), 1.0f);
+
+    // Half confidence at 0.5 px residual plus a quarter of the magnitude
+    EXPECT_FLOAT_EQ(flowConfidence(0.5, 0.0, -1.0), 0.5f);
+    EXPECT_FLOAT_EQ(flowConfidence(1.0, 2.0, -1.0), 0.5f);
+    EXPECT_GT(flowConfidence(1.0, 4.0, -1.0), flowConfidence(1.0, 2.0, -1.0));
+    EXPECT_LT(flowConfidence(2.0, 2.0, -1.0), flowConfidence(1.0, 2.0, -1.0));
+
+    // Half confidence at a mean gradient of 4 gray levels per pixel, none without texture
+    EXPECT_FLOAT_EQ(flowConfidence(0.0, 0.0, 4.0), 0.5f);
+    EXPECT_FLOAT_EQ(flowConfidence(0.0, 0.0, 0.0), 0.0f);
+    EXPECT_FLOAT_EQ(flowConfidence(0.5, 0.0, 4.0), 0.25f);
+}
+
+// Test that the texture is the mean central-difference gradient of the image at the samples
+TEST(FlowConfidenceTest, TextureFromImage) {
+    cv::Mat flow = rigidFlow(FRAME_SIZE, 1.0f, 0.0f, 0.0f);
+
+    // A flat image (sky, water) gives no confidence
+    FlowMoments moments;
+    accumulateFlow(flow, cv::Point(0, 0), FRAME_SIZE, 1, cv::Mat(), moments, cv::Mat(FRAME_SIZE, CV_8UC1, cv::Scalar(128)));
+    EXPECT_FLOAT_EQ(moments.toMeasurement().confidence, 0.0f);
+
+    // A ramp of 3 gray levels per pixel in x; the clamped differences of the border columns give half
+    cv::Mat ramp(FRAME_SIZE, CV_8UC1);
+    for (int y = 0; y < ramp.rows; ++y) {
+        for (int x = 0; x < ramp.cols; ++x) {
+            ramp.at<unsigned char>(y, x) = static_cast<unsigned char>(3 * x);
+        }
+    }
+    moments = FlowMoments();
+    accumulateFlow(flow, cv::Point(0, 0), FRAME_SIZE, 1, cv::Mat(), moments, ramp);
+    const double texture = (3.0 * (FRAME_SIZE.width - 2) + 1.5 * 2) / FRAME_SIZE.width;
+    EXPECT_NEAR(moments.sumTexture / moments.textureCount, texture, 1e-9);
+    EXPECT_NEAR(moments.toMeasurement().confidence, flowConfidence(0.0, 1.0, texture), 1e-6);
+}
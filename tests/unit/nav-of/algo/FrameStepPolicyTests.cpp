@@ -0,0 +1,92 @@
+// tests/unit/nav-of/algo/FrameStepPolicyTests.cpp
+#include <gtest/gtest.h>
+#include "nav-of/algo/frame_step_policy.hpp"
+#include <limits>
+
+namespace {
+
+const int MAX_STEP = 4;
+const double MAX_DISPLACEMENT = 8.0;
+const int CALM = FrameStepPolicy::CALM_EVALUATIONS;
+
+class FrameStepPolicyTest : public ::testing::Test {
+protected:
+    // Feeds count calm measurements with the given displacement and returns the last step
+    int calm(double displacement, int count) {
+        int step = 0;
+        for (int i = 0; i < count; ++i) {
+            step = policy.update(displacement, 0.0, 0.0, 1.0);
+        }
+        return step;
+    }
+
+    FrameStepPolicy policy{MAX_STEP, MAX_DISPLACEMENT};
+};
+
+} // namespace
+
+// Test that the step grows by one frame after every CALM_EVALUATIONS calm measurements, up to the maximum
+TEST_F(FrameStepPolicyTest, GrowsOnCalmSegments) {
+    EXPECT_EQ(policy.getStep(), 1);
+    for (int step = 1; step < MAX_STEP; ++step) {
+        EXPECT_EQ(calm(1.0, CALM - 1), step);
+        EXPECT_EQ(calm(1.0, 1), step + 1);
+    }
+    EXPECT_EQ(calm(1.0, 10 * CALM), MAX_STEP);
+}
+
+// Test that the displacement over the step stays inside the sweet spot
+TEST_F(FrameStepPolicyTest, DisplacementLimitsStep) {
+    // 3 px per frame: at most 2 frames (6 px)
+    EXPECT_EQ(calm(3.0, 10 * CALM), 2);
+
+    // Faster motion shrinks the step at once, without waiting for calm measurements
+    calm(1.0, 10 * CALM);
+    ASSERT_EQ(policy.getStep(), MAX_STEP);
+    EXPECT_EQ(calm(3.0, 1), 2);
+    EXPECT_EQ(calm(20.0, 1), 1);
+
+    // No expected motion: only the maximum step limits
+    EXPECT_EQ(calm(0.0, 10 * CALM), MAX_STEP);
+}
+
+// Test that turning, accelerating and low confidence drop the step to 1 immediately
+TEST_F(FrameStepPolicyTest, ManeuversResetStep) {
+    const double yaw = FrameStepPolicy::MANEUVER_YAW_RATE * 1.5;
+    const double acceleration = FrameStepPolicy::MANEUVER_ACCELERATION * 1.5;
+    const double confidence = FrameStepPolicy::MIN_CONFIDENCE / 2.0;
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    const double maneuvers[][4] = {
+        {1.0, yaw, 0.0, 1.0},
+        {1.0, -yaw, 0.0, 1.0},
+        {1.0, 0.0, acceleration, 1.0},
+        {1.0, 0.0, -acceleration, 1.0},
+        {1.0, 0.0, 0.0, confidence},
+        {1.0, 0.0, 0.0, nan},
+        {nan, 0.0, 0.0, 1.0},
+    };
+    for (const auto& maneuver : maneuvers) {
+        calm(1.0, 10 * CALM);
+        ASSERT_EQ(policy.getStep(), MAX_STEP);
+        EXPECT_EQ(policy.update(maneuver[0], maneuver[1], maneuver[2], maneuver[3]), 1);
+
+        // The calm count starts over
+        EXPECT_EQ(calm(1.0, CALM - 1), 1);
+    }
+}
+
+// Test that a maximum step of 1 (or less) disables skipping and setMaxStep starts over
+TEST_F(FrameStepPolicyTest, MaxStep) {
+    FrameStepPolicy disabled(0, MAX_DISPLACEMENT);
+    EXPECT_EQ(disabled.getMaxStep(), 1);
+    for (int i = 0; i < 10 * CALM; ++i) {
+        EXPECT_EQ(disabled.update(1.0, 0.0, 0.0, 1.0), 1);
+    }
+
+    calm(1.0, 10 * CALM);
+    ASSERT_EQ(policy.getStep(), MAX_STEP);
+    policy.setMaxStep(2);
+    EXPECT_EQ(policy.getStep(), 1);
+    EXPECT_EQ(calm(1.0, 10 * CALM), 2);
+}
@@ -0,0 +1,205 @@
+// tests/unit/nav-of/algo/HornSchunckTests.cpp
+#include <gtest/gtest.h>
+#include "nav-of/algo/horn_schunck.hpp"
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* const KERNELS[] = {"scalar", "sse2", "avx2"};
+
+// Widths below, at and around the SSE2 (4) and AVX2 (8) vector widths, so the vector loops,
+// the scalar tails and the reflected border columns are all hit
+const cv::Size SIZES[] = {
+    {2, 2}, {3, 2}, {2, 3}, {4, 3}, {5, 4}, {7, 5}, {8, 3}, {9, 6}, {11, 2}, {13, 7}, {17, 9}, {31, 4}, {35, 12}
+};
+
+cv::Mat randomTexture(const cv::Size& size, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> intensity(0, 255);
+    cv::Mat image(size, CV_8UC1);
+    for (int y = 0; y < size.height; ++y) {
+        for (int x = 0; x < size.width; ++x) {
+            image.at<unsigned char>(y, x) = static_cast<unsigned char>(intensity(rng));
+        }
+    }
+    return image;
+}
+
+// The cv::filter2D implementation the solver replaced, with the gradients in intensity per pixel as the solver uses them
+void referenceHornSchunck(const cv::Mat& prevGray, const cv::Mat& currGray, cv::Mat& u, cv::Mat& v,
+                          float alpha, int iterations) {
+    cv::Mat I1, I2;
+    prevGray.convertTo(I1, CV_32F);
+    currGray.convertTo(I2, CV_32F);
+
+    cv::Mat Ix, Iy;
+    cv::Sobel(I1, Ix, CV_32F, 1, 0, 3, 1.0 / 8.0);
+    cv::Sobel(I1, Iy, CV_32F, 0, 1, 3, 1.0 / 8.0);
+    cv::Mat It = I2 - I1;
+
+    u = cv::Mat::zeros(I1.size(), CV_32F);
+    v = cv::Mat::zeros(I1.size(), CV_32F);
+
+    cv::Mat kernel = (cv::Mat_<float>(3, 3) << 1/12.0f, 1/6.0f, 1/12.0f,
+                                               1/6.0f,  0.0f,   1/6.0f,
+                                               1/12.0f, 1/6.0f, 1/12.0f);
+
+    for (int iter = 0; iter < iterations; ++iter) {
+        cv::Mat uAvg, vAvg;
+        cv::filter2D(u, uAvg, -1, kernel, cv::Point(-1, -1), 0, cv::BORDER_REFLECT_101);
+        cv::filter2D(v, vAvg, -1, kernel, cv::Point(-1, -1), 0, cv::BORDER_REFLECT_101);
+
+        cv::Mat num = Ix.mul(uAvg) + Iy.mul(vAvg) + It;
+        cv::Mat denom = alpha * alpha + Ix.mul(Ix) + Iy.mul(Iy);
+
+        u = uAvg - Ix.mul(num) / denom;
+        v = vAvg - Iy.mul(num) / denom;
+    }
+}
+
+// Smooth texture with several orientations, shifted by (dx, dy): the flow from shift 0 to (dx, dy) is (dx, dy)
+cv::Mat shiftedTexture(const cv::Size& size, double dx, double dy) {
+    const double k = 2.0 * M_PI;
+    cv::Mat image(size, CV_8UC1);
+    for (int y = 0; y < size.height; ++y) {
+        for (int x = 0; x < size.width; ++x) {
+            const double X = x - dx;
+            const double Y = y - dy;
+            const double value = 128.0 + 35.0 * std::sin(k * X / 37.0) + 30.0 * std::sin(k * Y / 29.0 + 1.0)
+                               + 25.0 * std::sin(k * (X + Y) / 53.0 + 2.0) + 20.0 * std::sin(k * (X - 2.0 * Y) / 61.0);
+            image.at<unsigned char>(y, x) = static_cast<unsigned char>(std::min(255.0, std::max(0.0, std::round(value))));
+        }
+    }
+    return image;
+}
+
+// Mean of a flow component without a margin at the image borders
+double interiorMean(const cv::Mat& flow, int margin) {
+    return cv::mean(flow(cv::Rect(margin, margin, flow.cols - 2 * margin, flow.rows - 2 * margin)))[0];
+}
+
+std::vector<std::string> supportedKernels() {
+    std::vector<std::string> kernels;
+    HornSchunckSolver solver;
+    for (const char* kernel : KERNELS) {
+        if (solver.setKernel(kernel)) kernels.push_back(kernel);
+    }
+    return kernels;
+}
+
+} // namespace
+
+// Test that the scalar kernel is always available and unknown kernels are refused
+TEST(HornSchunckSolverTest, KernelSelection) {
+    HornSchunckSolver solver;
+    EXPECT_STREQ(solver.getActiveKernelName(), HornSchunckSolver::getKernelName());
+
+    EXPECT_TRUE(solver.setKernel("scalar"));
+    EXPECT_STREQ(solver.getActiveKernelName(), "scalar");
+
+    EXPECT_FALSE(solver.setKernel("neon"));
+    EXPECT_STREQ(solver.getActiveKernelName(), "scalar");
+
+    EXPECT_TRUE(solver.setKernel("auto"));
+    EXPECT_STREQ(solver.getActiveKernelName(), HornSchunckSolver::getKernelName());
+}
+
+// Test that every row kernel matches the filter2D reference, including the border rows and columns
+TEST(HornSchunckSolverTest, KernelsMatchFilter2DReference) {
+    const float alpha = 1.0f;
+    const int iterations = 50;
+
+    for (const std::string& kernel : supportedKernels()) {
+        HornSchunckSolver solver(alpha, iterations);
+        ASSERT_TRUE(solver.setKernel(kernel));
+
+        unsigned seed = 1;
+        for (const cv::Size& size : SIZES) {
+            SCOPED_TRACE(kernel + " " + std::to_string(size.width) + "x" + std::to_string(size.height));
+            cv::Mat prev = randomTexture(size, seed++);
+            cv::Mat curr = randomTexture(size, seed++);
+
+            cv::Mat u, v, uRef, vRef;
+            EXPECT_EQ(solver.compute(prev, curr, u, v), iterations);
+            referenceHornSchunck(prev, curr, uRef, vRef, alpha, iterations);
+
+            ASSERT_EQ(u.size(), size);
+            ASSERT_EQ(v.size(), size);
+            EXPECT_LT(cv::norm(u, uRef, cv::NORM_INF), 1e-4);
+            EXPECT_LT(cv::norm(v, vRef, cv::NORM_INF), 1e-4);
+        }
+    }
+}
+
+// Test that the vector kernels agree with the scalar kernel (only the rounding of FMA may differ)
+TEST(HornSchunckSolverTest, VectorKernelsMatchScalar) {
+    HornSchunckSolver scalar(1.0f, 20);
+    ASSERT_TRUE(scalar.setKernel("scalar"));
+
+    for (const std::string& kernel : supportedKernels()) {
+        if (kernel == "scalar") continue;
+        HornSchunckSolver solver(1.0f, 20);
+        ASSERT_TRUE(solver.setKernel(kernel));
+
+        unsigned seed = 100;
+        for (const cv::Size& size : SIZES) {
+            SCOPED_TRACE(kernel + " " + std::to_string(size.width) + "x" + std::to_string(size.height));
+            cv::Mat prev = randomTexture(size, seed++);
+            cv::Mat curr = randomTexture(size, seed++);
+
+            cv::Mat u, v, uScalar, vScalar;
+            solver.compute(prev, curr, u, v);
+            scalar.compute(prev, curr, uScalar, vScalar);
+            EXPECT_LT(cv::norm(u, uScalar, cv::NORM_INF), 1e-4);
+            EXPECT_LT(cv::norm(v, vScalar, cv::NORM_INF), 1e-4);
+        }
+    }
+}
+
+// Test that images without room for the reflected border give a zero flow
+TEST(HornSchunckSolverTest, SinglePixelImagesGiveZeroFlow) {
+    HornSchunckSolver solver;
+    for (const cv::Size& size : {cv::Size(1, 1), cv::Size(1, 9), cv::Size(9, 1)}) {
+        cv::Mat u, v;
+        EXPECT_EQ(solver.compute(randomTexture(size, 1), randomTexture(size, 2), u, v), 0);
+        ASSERT_EQ(u.size(), size);
+        EXPECT_EQ(cv::countNonZero(u), 0);
+        EXPECT_EQ(cv::countNonZero(v), 0);
+    }
+}
+
+// Test that hornSchunck() returns the flow in pixels (the gradients are Sobel / 8)
+TEST(HornSchunckTest, FlowIsInPixels) {
+    const cv::Size size(160, 120);
+    cv::Mat u, v;
+    hornSchunck(shiftedTexture(size, 0.0, 0.0), shiftedTexture(size, 0.5, -0.25), u, v);
+
+    EXPECT_NEAR(interiorMean(u, 8), 0.5, 0.1);
+    EXPECT_NEAR(interiorMean(v, 8), -0.25, 0.1);
+}
+
+// Test that the pyramid recovers a shift of several pixels and that a warm start refines it in fewer iterations
+TEST(PyramidalHornSchunckTest, RecoversShiftWithWarmStart) {
+    const cv::Size size(160, 120);
+    const double dx = 3.0;
+    const double dy = -2.0;
+    cv::Mat prev = shiftedTexture(size, 0.0, 0.0);
+    cv::Mat curr = shiftedTexture(size, dx, dy);
+
+    PyramidalHornSchunck pyramid;
+    cv::Mat u, v;
+    const int coldIterations = pyramid.compute(prev, curr, u, v);
+    ASSERT_EQ(u.size(), size);
+    EXPECT_NEAR(interiorMean(u, 8), dx, 0.1);
+    EXPECT_NEAR(interiorMean(v, 8), dy, 0.1);
+
+    const int warmIterations = pyramid.compute(prev, curr, u, v, true);
+    EXPECT_LT(warmIterations, coldIterations);
+    EXPECT_NEAR(interiorMean(u, 8), dx, 0.05);
+    EXPECT_NEAR(interiorMean(v, 8), dy, 0.05);
+}
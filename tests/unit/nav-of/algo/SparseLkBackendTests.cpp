@@ -0,0 +1,204 @@
+// tests/unit/nav-of/algo/SparseLkBackendTests.cpp
+#include <gtest/gtest.h>
+#include "nav-of/algo/farneback_cpu.hpp"
+#include "nav-of/algo/lk_sparse.hpp"
+#include "nav-of/core/OpticalFlowProcessor.hpp"
+#include <opencv2/imgproc.hpp>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+const int BLOCK_PX = 16;
+const int BORDER_PX = 40;
+
+// Blurred blocks of random gray levels: plenty of corners for goodFeaturesToTrack
+cv::Mat blockTexture(const cv::Size& size, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> intensity(0, 255);
+    const int blocksX = (size.width + BLOCK_PX - 1) / BLOCK_PX;
+    const int blocksY = (size.height + BLOCK_PX - 1) / BLOCK_PX;
+    std::vector<unsigned char> blocks(blocksX * blocksY);
+    for (unsigned char& block : blocks) block = static_cast<unsigned char>(intensity(rng));
+
+    cv::Mat texture(size, CV_8UC1);
+    for (int y = 0; y < size.height; ++y) {
+        for (int x = 0; x < size.width; ++x) {
+            texture.at<unsigned char>(y, x) = blocks[(y / BLOCK_PX) * blocksX + x / BLOCK_PX];
+        }
+    }
+    cv::GaussianBlur(texture, texture, cv::Size(5, 5), 1.5);
+    return texture;
+}
+
+// Frame cut from the texture so that its content is moved by (dx, dy) pixels against the unshifted frame
+cv::Mat shiftedFrame(const cv::Mat& texture, const cv::Size& size, int dx, int dy) {
+    return texture(cv::Rect(BORDER_PX - dx, BORDER_PX - dy, size.width, size.height)).clone();
+}
+
+cv::Size paddedSize(const cv::Size& size) {
+    return cv::Size(size.width + 2 * BORDER_PX, size.height + 2 * BORDER_PX);
+}
+
+// Frame cut from the texture after turning it clockwise on screen by angle radians about the frame center
+// and moving it by (dx, dy) pixels; the padding keeps the turned-in corners textured
+cv::Mat rotatedFrame(const cv::Mat& texture, const cv::Size& size, double angle, double dx, double dy) {
+    const cv::Point2f center((texture.cols - 1) * 0.5f, (texture.rows - 1) * 0.5f);
+    cv::Mat transform = cv::getRotationMatrix2D(center, -angle * 180.0 / M_PI, 1.0);
+    transform.at<double>(0, 2) += dx;
+    transform.at<double>(1, 2) += dy;
+
+    cv::Mat rotated;
+    cv::warpAffine(texture, rotated, transform, texture.size());
+    return rotated(cv::Rect(BORDER_PX, BORDER_PX, size.width, size.height)).clone();
+}
+
+// Heading of an OpticalFlowProcessor fed with the unshifted and then the shifted frame
+double headingForShift(int dx, int dy) {
+    const cv::Size size(640, 360);
+    const cv::Mat texture = blockTexture(paddedSize(size), 3);
+
+    OpticalFlowProcessor processor;
+    processor.setCameraParams(70.0, {size.width, size.height});
+    processor.setFrameRate(30.0f);
+    processor.setFlowBackend(std::make_unique<SparseLkBackend>());
+
+    EXPECT_FALSE(processor.update(shiftedFrame(texture, size, 0, 0), 100.0));
+    EXPECT_TRUE(processor.update(shiftedFrame(texture, size, dx, dy), 100.0));
+    return processor.getHeading();
+}
+
+} // namespace
+
+// Test that the first frame only primes the backend
+TEST(SparseLkBackendTest, FirstFramePrimes) {
+    const cv::Size size(320, 240);
+    SparseLkBackend backend;
+    FlowMeasurement measurement;
+    EXPECT_FALSE(backend.process(blockTexture(size, 1), size.height, measurement));
+}
+
+// Test that a shifted textured image gives its shift, x to the right and y downwards, without rotation
+TEST(SparseLkBackendTest, TranslationOfShiftedImage) {
+    const cv::Size size(320, 240);
+    const cv::Mat texture = blockTexture(paddedSize(size), 3);
+    const int shifts[][2] = {{3, 0}, {0, 3}, {-2, 4}};
+
+    for (const auto& shift : shifts) {
+        SparseLkBackend backend;
+        FlowMeasurement measurement;
+        ASSERT_FALSE(backend.process(shiftedFrame(texture, size, 0, 0), size.height, measurement));
+        ASSERT_TRUE(backend.process(shiftedFrame(texture, size, shift[0], shift[1]), size.height, measurement));
+
+        EXPECT_TRUE(measurement.hasDirection);
+        EXPECT_NEAR(measurement.dx, shift[0], 0.05);
+        EXPECT_NEAR(measurement.dy, shift[1], 0.05);
+        EXPECT_NEAR(measurement.avgMagnitude, std::hypot(shift[0], shift[1]), 0.05);
+        EXPECT_NEAR(measurement.rotation, 0.0, 1e-3);
+        EXPECT_GT(measurement.confidence, 0.8);
+    }
+}
+
+// Test that an image turned clockwise on screen gives a positive rotation
+TEST(SparseLkBackendTest, RotationSign) {
+    const cv::Size size(320, 240);
+    const cv::Mat frame = blockTexture(size, 3);
+    const cv::Point2f center((size.width - 1) * 0.5f, (size.height - 1) * 0.5f);
+    const double angle = 0.25 * M_PI / 180.0;
+
+    for (double sign : {1.0, -1.0}) {
+        // getRotationMatrix2D turns counterclockwise on screen for positive angles
+        cv::Mat rotated;
+        cv::warpAffine(frame, rotated, cv::getRotationMatrix2D(center, -sign * 0.25, 1.0), size);
+
+        SparseLkBackend backend;
+        FlowMeasurement measurement;
+        ASSERT_FALSE(backend.process(frame, size.height, measurement));
+        ASSERT_TRUE(backend.process(rotated, size.height, measurement));
+        EXPECT_NEAR(measurement.rotation, sign * angle, 0.1 * angle);
+        EXPECT_NEAR(measurement.dx, 0.0, 0.05);
+        EXPECT_NEAR(measurement.dy, 0.0, 0.05);
+    }
+}
+
+// Test that the outer tracks of a turning frame stay inliers: 0.15 rad/s at 30 fps moves the corners
+// of a 640x360 frame by about 1.8 px per frame more than its center
+TEST(SparseLkBackendTest, TurningKeepsOuterTracks) {
+    const cv::Size size(640, 360);
+    const cv::Mat texture = blockTexture(paddedSize(size), 3);
+    const double angle = 0.15 / 30.0;
+
+    SparseLkBackend backend;
+    FlowMeasurement measurement;
+    ASSERT_FALSE(backend.process(rotatedFrame(texture, size, 0.0, 0.0, 0.0), size.height, measurement));
+    for (int frame = 1; frame <= 5; ++frame) {
+        ASSERT_TRUE(backend.process(rotatedFrame(texture, size, frame * angle, 0.0, 0.0), size.height, measurement));
+        EXPECT_NEAR(measurement.rotation, angle, 0.05 * angle);
+        EXPECT_NEAR(measurement.dx, 0.0, 0.2);
+        EXPECT_NEAR(measurement.dy, 0.0, 0.2);
+        EXPECT_GT(measurement.confidence, 0.85);
+    }
+}
+
+// Test that the sparse and the dense backend agree on a turning frame sampled off-center: both fit the
+// rotation about the centroid of their samples and report the translation there
+TEST(SparseLkBackendTest, RotationMatchesDenseOffCenter) {
+    const cv::Size size(640, 360);
+    const cv::Mat texture = blockTexture(paddedSize(size), 3);
+    const double angle = 0.005;
+    const cv::Mat prev = rotatedFrame(texture, size, 0.0, 0.0, 0.0);
+    const cv::Mat curr = rotatedFrame(texture, size, angle, 1.0, 0.5);
+
+    // Left 200 px of the frame only
+    FlowSampling sampling;
+    sampling.frameSize = size;
+    sampling.regions.push_back(cv::Rect(0, 0, 200, size.height));
+    sampling.mask = cv::Mat(size, CV_8UC1, cv::Scalar(0));
+    sampling.mask(sampling.regions[0]).setTo(cv::Scalar(255));
+
+    SparseLkBackend sparse;
+    FarnebackCpuBackend dense;
+    sparse.setSampling(sampling);
+    dense.setSampling(sampling);
+
+    FlowMeasurement sparseMeasurement;
+    FlowMeasurement denseMeasurement;
+    ASSERT_FALSE(sparse.process(prev, size.height, sparseMeasurement));
+    ASSERT_FALSE(dense.process(prev, size.height, denseMeasurement));
+    ASSERT_TRUE(sparse.process(curr, size.height, sparseMeasurement));
+    ASSERT_TRUE(dense.process(curr, size.height, denseMeasurement));
+
+    EXPECT_NEAR(sparseMeasurement.rotation, angle, 0.05 * angle);
+    EXPECT_NEAR(sparseMeasurement.rotation, denseMeasurement.rotation, 0.05 * angle);
+    EXPECT_NEAR(sparseMeasurement.dx, denseMeasurement.dx, 0.05);
+    EXPECT_NEAR(sparseMeasurement.dy, denseMeasurement.dy, 0.05);
+}
+
+// Test that a change of the analysis scale still measures the frame pair, in pixels of the new scale
+TEST(SparseLkBackendTest, ScaleSwitchMeasures) {
+    const cv::Size size(320, 240);
+    const cv::Mat texture = blockTexture(paddedSize(size), 3);
+
+    for (int scaledHeight : {120, 180}) {
+        SparseLkBackend backend;
+        FlowMeasurement measurement;
+        ASSERT_FALSE(backend.process(shiftedFrame(texture, size, 0, 0), size.height, measurement));
+        ASSERT_TRUE(backend.process(shiftedFrame(texture, size, 4, 0), scaledHeight, measurement));
+
+        const double scale = scaledHeight / static_cast<double>(size.height);
+        EXPECT_NEAR(measurement.dx, 4.0 * scale, 0.05);
+        EXPECT_NEAR(measurement.dy, 0.0, 0.05);
+    }
+}
+
+// Test the heading from the sparse flow: the ground moves against the direction of travel
+TEST(SparseLkBackendTest, HeadingFromShift) {
+    // Image moves down: flying forward (towards the top edge)
+    EXPECT_NEAR(headingForShift(0, 3), 0.0, 0.02);
+    // Image moves left: flying right (clockwise from the top edge)
+    EXPECT_NEAR(headingForShift(-3, 0), M_PI / 2.0, 0.02);
+    // Image moves right and up: flying back and left
+    EXPECT_NEAR(headingForShift(2, -2), -3.0 * M_PI / 4.0, 0.02);
+}
@@ -0,0 +1,126 @@
+// tests/unit/nav-of/core/FlowSamplingTests.cpp
+#include <gtest/gtest.h>
+#include "nav-of/core/OpticalFlowProcessor.hpp"
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Analysis frame of OpticalFlowProcessor
+const cv::Size FRAME_SIZE(640, 360);
+
+// Backend that only keeps the sampling it is given
+class SamplingBackend : public IFlowBackend {
+public:
+    const char* getName() const override { return "sampling"; }
+
+    bool process(const cv::Mat&, int, FlowMeasurement&) override { return false; }
+
+    void reset() override {}
+};
+
+class FlowSamplingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        processor.setFlowBackend(std::make_unique<SamplingBackend>());
+    }
+
+    // Sampling the backend works with after the next frame
+    const FlowSampling& sampling() {
+        FlowMeasurement measurement;
+        processor.measureFlow(cv::Mat(FRAME_SIZE, CV_8UC1, cv::Scalar(0)), frameTime, measurement);
+        frameTime += 1.0 / 30.0;
+        return processor.getFlowBackend()->getSampling();
+    }
+
+    OpticalFlowProcessor processor;
+    double frameTime = 0.0;
+};
+
+} // namespace
+
+// Test that no regions, mask or stride leave the sampling empty (whole frame)
+TEST_F(FlowSamplingTest, DefaultCoversWholeFrame) {
+    const FlowSampling& result = sampling();
+    EXPECT_TRUE(result.regions.empty());
+    EXPECT_FALSE(result.appliesTo(FRAME_SIZE));
+}
+
+// Test that a stride alone samples the whole frame in one region
+TEST_F(FlowSamplingTest, StrideOnly) {
+    processor.setSampleStride(3);
+    const FlowSampling& result = sampling();
+
+    ASSERT_EQ(result.regions.size(), 1u);
+    EXPECT_EQ(result.regions[0], cv::Rect(0, 0, FRAME_SIZE.width, FRAME_SIZE.height));
+    EXPECT_EQ(result.stride, 3);
+    EXPECT_EQ(cv::countNonZero(result.mask), FRAME_SIZE.area());
+}
+
+// Test that the tiles of a region merge into a single rectangle over all tile rows
+TEST_F(FlowSamplingTest, RegionTilesMerge) {
+    processor.setFlowRegions({cv::Rect2f(0.0f, 0.0f, 0.5f, 1.0f)});
+    const FlowSampling& result = sampling();
+
+    ASSERT_TRUE(result.appliesTo(FRAME_SIZE));
+    ASSERT_EQ(result.regions.size(), 1u);
+    EXPECT_EQ(result.regions[0], cv::Rect(0, 0, 320, 360));
+    EXPECT_EQ(cv::countNonZero(result.mask), 320 * 360);
+}
+
+// Test that separate regions stay separate and an L shape splits where the tile runs change
+TEST_F(FlowSamplingTest, RegionShapes) {
+    processor.setFlowRegions({cv::Rect2f(0.0f, 0.0f, 0.25f, 1.0f), cv::Rect2f(0.75f, 0.0f, 0.25f, 1.0f)});
+    FlowSampling result = sampling();
+    ASSERT_EQ(result.regions.size(), 2u);
+    EXPECT_EQ(result.regions[0], cv::Rect(0, 0, 160, 360));
+    EXPECT_EQ(result.regions[1], cv::Rect(480, 0, 160, 360));
+
+    // Left half plus the bottom fifth of the right half (rows 288-359 start on a tile boundary)
+    processor.setFlowRegions({cv::Rect2f(0.0f, 0.0f, 0.5f, 1.0f), cv::Rect2f(0.5f, 0.8f, 0.5f, 0.2f)});
+    result = sampling();
+    ASSERT_EQ(result.regions.size(), 2u);
+    EXPECT_EQ(result.regions[0], cv::Rect(0, 0, 320, 288));
+    EXPECT_EQ(result.regions[1], cv::Rect(0, 288, 640, 72));
+    EXPECT_EQ(cv::countNonZero(result.mask), 320 * 360 + 320 * 72);
+}
+
+// Test that the mask is scaled to the frame and removes the tiles it fully covers
+TEST_F(FlowSamplingTest, MaskRemovesTiles) {
+    // Top half black (sky) at a tenth of the frame size
+    cv::Mat mask(36, 64, CV_8UC1, cv::Scalar(255));
+    mask(cv::Rect(0, 0, 64, 18)).setTo(cv::Scalar(0));
+    processor.setFlowMask(mask);
+    const FlowSampling& result = sampling();
+
+    ASSERT_EQ(result.regions.size(), 1u);
+    // Row 180 lies in the tile row starting at 160, so the region starts there; the mask itself starts at 180
+    EXPECT_EQ(result.regions[0], cv::Rect(0, 160, 640, 200));
+    EXPECT_EQ(cv::countNonZero(result.mask), 640 * 180);
+    EXPECT_EQ(result.mask.at<unsigned char>(179, 0), 0);
+    EXPECT_NE(result.mask.at<unsigned char>(180, 0), 0);
+}
+
+// Test that the mask and the regions intersect
+TEST_F(FlowSamplingTest, MaskAndRegionsIntersect) {
+    cv::Mat mask(36, 64, CV_8UC1, cv::Scalar(255));
+    mask(cv::Rect(0, 0, 64, 18)).setTo(cv::Scalar(0));
+    processor.setFlowMask(mask);
+    processor.setFlowRegions({cv::Rect2f(0.0f, 0.0f, 0.5f, 1.0f)});
+    const FlowSampling& result = sampling();
+
+    ASSERT_EQ(result.regions.size(), 1u);
+    EXPECT_EQ(result.regions[0], cv::Rect(0, 160, 320, 200));
+    EXPECT_EQ(cv::countNonZero(result.mask), 320 * 180);
+}
+
+// Test that a mask excluding the whole region falls back to the whole frame
+TEST_F(FlowSamplingTest, NothingLeftUsesWholeFrame) {
+    cv::Mat mask(36, 64, CV_8UC1, cv::Scalar(255));
+    mask(cv::Rect(0, 0, 32, 36)).setTo(cv::Scalar(0));
+    processor.setFlowMask(mask);
+    processor.setFlowRegions({cv::Rect2f(0.0f, 0.0f, 0.5f, 1.0f)});
+    const FlowSampling& result = sampling();
+
+    EXPECT_TRUE(result.regions.empty());
+}
@@ -0,0 +1,261 @@
+// tests/unit/nav-sf/core/ErrorStateKalmanProcessorTests.cpp
+#include <gtest/gtest.h>
+#include "nav-sf/core/ErrorStateKalmanProcessor.hpp"
+#include "nav-dr/core/DeadReckoningProcessor.hpp"
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace {
+
+const double START_LAT = 52.2297;
+const double START_LON = 21.0122;
+const double ALTITUDE = 100.0;
+const double DT = 1.0 / 30.0;
+
+using StateIndex = ErrorStateKalmanProcessor::StateIndex;
+
+// Straight flight at a constant course and speed; the flow speed and logged heading carry a scale and bias,
+// a GPS fix of the true position is fused every gpsInterval frames (0 = never) up to frame gpsUntil
+struct Flight {
+    double course = 0.0;
+    double speed = 10.0;
+    double flowScale = 1.0;
+    double headingBias = 0.0;
+    int gpsInterval = 0;
+    int gpsUntil = std::numeric_limits<int>::max();
+    double measurementNoise = 0.0;
+
+    // Flies the given number of frames and returns the true position
+    GPSData fly(ErrorStateKalmanProcessor& processor, int frames, unsigned seed = 1) const {
+        const LocalFrame truthFrame(START_LAT, START_LON, ALTITUDE);
+        std::mt19937 rng(seed);
+        std::normal_distribution<double> noise(0.0, 1.0);
+
+        GPSData start(START_LAT, START_LON, ALTITUDE);
+        EXPECT_TRUE(processor.update(start, ALTITUDE, course + headingBias, speed * flowScale, DT));
+
+        GPSData truth = start;
+        for (int frame = 1; frame <= frames; ++frame) {
+            const double distance = speed * DT * frame;
+            truthFrame.fromENU(Vector3D(distance * std::cos(course), distance * std::sin(course), 0.0), truth);
+
+            const double flowSpeed = speed * flowScale + measurementNoise * noise(rng);
+            const double heading = course + headingBias + 0.1 * measurementNoise * noise(rng);
+            EXPECT_TRUE(processor.update(start, ALTITUDE, heading, flowSpeed, DT));
+            if (gpsInterval > 0 && frame % gpsInterval == 0 && frame <= gpsUntil) {
+                processor.correct(GPSData(truth.getLatitude(), truth.getLongitude(), 0.0));
+            }
+        }
+        return truth;
+    }
+};
+
+} // namespace
+
+// Test rejection of an invalid initial fix
+TEST(ErrorStateKalmanProcessorTest, InvalidInitialFix) {
+    ErrorStateKalmanProcessor processor;
+    EXPECT_FALSE(processor.update(GPSData(0.0, 0.0, 0.0), ALTITUDE, 0.0, 10.0, DT));
+    EXPECT_FALSE(processor.isInitialized());
+    EXPECT_FALSE(processor.correct(GPSData(START_LAT, START_LON, 0.0)));
+}
+
+// Test that the first update only stores the fix
+TEST(ErrorStateKalmanProcessorTest, FirstUpdateKeepsFix) {
+    ErrorStateKalmanProcessor processor;
+    ASSERT_TRUE(processor.update(GPSData(START_LAT, START_LON, 0.0), ALTITUDE, 0.5, 10.0, DT));
+    EXPECT_TRUE(processor.isInitialized());
+
+    GPSData position = processor.getGPSData();
+    EXPECT_DOUBLE_EQ(position.getLatitude(), START_LAT);
+    EXPECT_DOUBLE_EQ(position.getLongitude(), START_LON);
+    EXPECT_DOUBLE_EQ(position.getAltitude(), ALTITUDE);
+    EXPECT_DOUBLE_EQ(processor.getState()(StateIndex::SPEED), 10.0);
+    EXPECT_DOUBLE_EQ(processor.getState()(StateIndex::COURSE), 0.5);
+    EXPECT_DOUBLE_EQ(processor.getState()(StateIndex::SCALE), 1.0);
+}
+
+// Test that exact measurements without GPS reproduce dead reckoning
+TEST(ErrorStateKalmanProcessorTest, MatchesDeadReckoningWithoutGps) {
+    ErrorStateKalmanProcessor filter;
+    DeadReckoningProcessor deadReckoning;
+
+    // 15 m/s, 40 deg from east, for 60 s (900 m, below the re-anchor distance)
+    Flight flight;
+    flight.course = 40.0 * M_PI / 180.0;
+    flight.speed = 15.0;
+    flight.fly(filter, 1800);
+
+    GPSData start(START_LAT, START_LON, ALTITUDE);
+    for (int frame = 0; frame <= 1800; ++frame) {
+        ASSERT_TRUE(deadReckoning.update(start, ALTITUDE, flight.course, flight.speed, DT));
+    }
+
+    EXPECT_LT(filter.getGPSData().distanceTo(deadReckoning.getGPSData()), 0.01);
+    EXPECT_NEAR(filter.getGPSData().distanceTo(start), 900.0, 0.01);
+    EXPECT_NEAR(filter.getGPSData().getAltitude(), ALTITUDE, 1e-9);
+}
+
+// Test that GPS fixes make the flow speed scale observable
+TEST(ErrorStateKalmanProcessorTest, EstimatesFlowScale) {
+    ErrorStateKalmanProcessor processor;
+
+    // Flow overestimates the speed by 20 %, one fix per second
+    Flight flight;
+    flight.flowScale = 1.2;
+    flight.gpsInterval = 30;
+    flight.measurementNoise = 0.3;
+    GPSData truth = flight.fly(processor, 30 * 120);
+
+    EXPECT_NEAR(processor.getState()(StateIndex::SCALE), 1.2, 0.02);
+    EXPECT_NEAR(processor.getState()(StateIndex::SPEED), 10.0, 0.2);
+    EXPECT_LT(processor.getGPSData().distanceTo(truth), 2.0);
+    EXPECT_EQ(processor.getGpsFixesUsed(), 120);
+    EXPECT_EQ(processor.getGpsFixesRejected(), 0);
+}
+
+// Test that GPS fixes make the heading bias observable, and the course follows the track
+TEST(ErrorStateKalmanProcessorTest, EstimatesHeadingBias) {
+    ErrorStateKalmanProcessor processor;
+
+    Flight flight;
+    flight.course = 1.0;
+    flight.headingBias = 0.1;
+    flight.gpsInterval = 30;
+    flight.measurementNoise = 0.3;
+    GPSData truth = flight.fly(processor, 30 * 120);
+
+    EXPECT_NEAR(processor.getState()(StateIndex::HEADING_BIAS), 0.1, 0.02);
+    EXPECT_NEAR(processor.getState()(StateIndex::COURSE), 1.0, 0.02);
+    EXPECT_LT(processor.getGPSData().distanceTo(truth), 2.0);
+}
+
+// Test that the learned corrections carry dead reckoning through a GPS outage
+TEST(ErrorStateKalmanProcessorTest, OutageAfterCalibration) {
+    // 90 s with a fix per second, then 100 s (1 km) without GPS
+    Flight flight;
+    flight.flowScale = 0.9;
+    flight.headingBias = -0.05;
+    flight.gpsInterval = 30;
+    flight.gpsUntil = 30 * 90;
+
+    ErrorStateKalmanProcessor filter;
+    GPSData truth = flight.fly(filter, 30 * 190);
+    EXPECT_NEAR(filter.getState()(StateIndex::SCALE), 0.9, 0.01);
+    EXPECT_NEAR(filter.getState()(StateIndex::HEADING_BIAS), -0.05, 0.01);
+
+    // Dead reckoning on the raw measurements is off by 10 % in distance and 0.05 rad in direction
+    DeadReckoningProcessor deadReckoning;
+    GPSData start(START_LAT, START_LON, ALTITUDE);
+    for (int frame = 0; frame <= 30 * 190; ++frame) {
+        ASSERT_TRUE(deadReckoning.update(start, ALTITUDE, flight.headingBias, flight.speed * flight.flowScale, DT));
+    }
+
+    EXPECT_LT(filter.getGPSData().distanceTo(truth), 15.0);
+    EXPECT_GT(deadReckoning.getGPSData().distanceTo(truth), 150.0);
+}
+
+// Test that a fix far outside the predicted uncertainty is rejected
+TEST(ErrorStateKalmanProcessorTest, RejectsGpsOutlier) {
+    ErrorStateKalmanProcessor processor;
+    Flight flight;
+    flight.gpsInterval = 30;
+    GPSData truth = flight.fly(processor, 30 * 20);
+    const GPSData before = processor.getGPSData();
+
+    // ~500 m north of the track
+    EXPECT_FALSE(processor.correct(GPSData(truth.getLatitude() + 0.0045, truth.getLongitude(), 0.0)));
+    EXPECT_EQ(processor.getGpsFixesRejected(), 1);
+    EXPECT_DOUBLE_EQ(processor.getGPSData().getLatitude(), before.getLatitude());
+
+    EXPECT_TRUE(processor.correct(GPSData(truth.getLatitude(), truth.getLongitude(), 0.0)));
+    EXPECT_FALSE(processor.correct(GPSData(0.0, 0.0, 0.0)));
+}
+
+// Test that a fix accuracy sets the weight of the fix
+TEST(ErrorStateKalmanProcessorTest, FixAccuracyWeightsCorrection) {
+    Flight flight;
+    ErrorStateKalmanProcessor precise;
+    ErrorStateKalmanProcessor coarse;
+    GPSData truth = flight.fly(precise, 300);
+    flight.fly(coarse, 300);
+
+    // Both fixes 5 m east of the estimate
+    const LocalFrame& frame = precise.getFrame();
+    GPSData offset;
+    frame.fromENU(Vector3D(precise.getState()(StateIndex::EAST) + 5.0, precise.getState()(StateIndex::NORTH), 0.0), offset);
+
+    ASSERT_TRUE(precise.correct(GPSData(offset.getLatitude(), offset.getLongitude(), 0.0, 0.5)));
+    ASSERT_TRUE(coarse.correct(GPSData(offset.getLatitude(), offset.getLongitude(), 0.0, 10.0)));
+    EXPECT_GT(precise.getGPSData().distanceTo(truth), coarse.getGPSData().distanceTo(truth));
+}
+
+// Test that the altitude follows the measurement
+TEST(ErrorStateKalmanProcessorTest, FusesAltitude) {
+    ErrorStateKalmanProcessor processor;
+    GPSData start(START_LAT, START_LON, 0.0);
+    ASSERT_TRUE(processor.update(start, ALTITUDE, 0.0, 10.0, DT));
+    for (int frame = 0; frame < 300; ++frame) {
+        ASSERT_TRUE(processor.update(start, ALTITUDE + 50.0, 0.0, 10.0, DT));
+    }
+    EXPECT_NEAR(processor.getGPSData().getAltitude(), ALTITUDE + 50.0, 0.1);
+
+    // Non-positive altitude is rejected and the state is kept
+    EXPECT_FALSE(processor.update(start, 0.0, 0.0, 10.0, DT));
+}
+
+// Test that hovering does not turn the course towards the noisy logged heading
+TEST(ErrorStateKalmanProcessorTest, HeadingIgnoredWhenHovering) {
+    ErrorStateKalmanProcessor processor;
+    GPSData start(START_LAT, START_LON, 0.0);
+    ASSERT_TRUE(processor.update(start, ALTITUDE, 0.3, 0.0, DT));
+    for (int frame = 0; frame < 300; ++frame) {
+        ASSERT_TRUE(processor.update(start, ALTITUDE, 2.5, 0.0, DT));
+    }
+    EXPECT_DOUBLE_EQ(processor.getState()(StateIndex::COURSE), 0.3);
+}
+
+// Test that re-anchoring keeps a long flight on track
+TEST(ErrorStateKalmanProcessorTest, LongFlightReanchors) {
+    ErrorStateKalmanProcessor filter;
+    DeadReckoningProcessor deadReckoning;
+    GPSData start(START_LAT, START_LON, ALTITUDE);
+
+    // 20 m/s due east for 10 minutes: 12 km, eleven re-anchors
+    ASSERT_TRUE(filter.update(start, ALTITUDE, 0.0, 20.0, DT));
+    ASSERT_TRUE(deadReckoning.update(start, ALTITUDE, 0.0, 20.0, DT));
+    for (int frame = 0; frame < 18000; ++frame) {
+        ASSERT_TRUE(filter.update(start, ALTITUDE, 0.0, 20.0, DT));
+        ASSERT_TRUE(deadReckoning.update(start, ALTITUDE, 0.0, 20.0, DT));
+    }
+
+    EXPECT_NEAR(filter.getGPSData().distanceTo(start), 12000.0, 0.5);
+    EXPECT_LT(filter.getGPSData().distanceTo(deadReckoning.getGPSData()), 0.01);
+    EXPECT_LT(filter.getState()(StateIndex::EAST), ErrorStateKalmanProcessor::REANCHOR_DISTANCE_M);
+}
+
+// Test that the covariance stays symmetric positive definite over a noisy flight
+TEST(ErrorStateKalmanProcessorTest, CovarianceStaysPositiveDefinite) {
+    ErrorStateKalmanProcessor processor;
+    Flight flight;
+    flight.course = -2.0;
+    flight.flowScale = 1.1;
+    flight.headingBias = 0.2;
+    flight.gpsInterval = 45;
+    flight.measurementNoise = 1.0;
+    flight.fly(processor, 30 * 300, 7);
+
+    const ErrorStateKalmanProcessor::StateMatrix& P = processor.getCovariance();
+    EXPECT_LT((P - P.transpose()).cwiseAbs().maxCoeff(), 1e-9);
+    EXPECT_EQ(P.llt().info(), Eigen::Success);
+}
+
+// Test that open-loop dead reckoning ignores fixes through the common interface
+TEST(ErrorStateKalmanProcessorTest, DeadReckoningIgnoresFixes) {
+    DeadReckoningProcessor deadReckoning;
+    IDRProcessor& processor = deadReckoning;
+    ASSERT_TRUE(processor.update(GPSData(START_LAT, START_LON, ALTITUDE), ALTITUDE, 0.0, 10.0, DT));
+    EXPECT_FALSE(processor.correct(GPSData(START_LAT + 0.001, START_LON, 0.0)));
+    EXPECT_DOUBLE_EQ(processor.getGPSData().getLatitude(), START_LAT);
+}